@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define PYSTRINGPP_BENCH_HAVE_TSC 1
+#else
+#define PYSTRINGPP_BENCH_HAVE_TSC 0
+#endif
+
+/**
+ * @file bench_harness.h
+ * @brief Minimal Google Benchmark-style harness for the native benchmarks
+ *
+ * Benchmarks are registered as (name, bytes per iteration, body) and run
+ * for a calibrated number of iterations. Results are printed as a table and
+ * can be written as JSON in Google Benchmark's layout ("context" plus a
+ * "benchmarks" array), so existing comparison tooling works on it, as does
+ * benchmarks/compare_native.py.
+ */
+
+namespace pystringpp_bench {
+
+    /// Keep a computed value alive so the optimizer cannot drop the work
+    template <typename T>
+    inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const T* sink;
+        sink = &value;
+#endif
+    }
+
+    /// Time-stamp counter reading (reference cycles), 0 where unavailable
+    inline std::uint64_t cycle_counter() {
+#if PYSTRINGPP_BENCH_HAVE_TSC
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    struct Benchmark {
+        std::string name;
+        std::uint64_t bytes; ///< Input bytes processed per iteration
+        std::function<void()> body;
+    };
+
+    struct Result {
+        std::string name;
+        std::uint64_t bytes;
+        std::uint64_t iterations;
+        double seconds;  ///< Per iteration
+        double cycles;   ///< TSC cycles per iteration, 0 without a TSC
+    };
+
+    struct Options {
+        std::string filter;       ///< Run only names containing this substring
+        double min_time = 0.2;    ///< Seconds of measurement per benchmark
+        std::string json_path;    ///< Write JSON results here when non-empty
+    };
+
+    class Runner {
+    public:
+        void add(std::string name, std::uint64_t bytes, std::function<void()> body) {
+            benchmarks_.push_back({std::move(name), bytes, std::move(body)});
+        }
+
+        std::vector<Result> run(const Options& options) const {
+            std::vector<Result> results;
+            std::printf("%-56s %14s %12s %12s %10s\n", "Benchmark", "Time/iter", "Iterations", "MB/s",
+                        "cycles/B");
+            for (const Benchmark& benchmark : benchmarks_) {
+                if (benchmark.name.find(options.filter) == std::string::npos) {
+                    continue;
+                }
+                results.push_back(measure(benchmark, options.min_time));
+                print(results.back());
+            }
+            return results;
+        }
+
+        static bool write_json(const std::string& path, const std::vector<Result>& results,
+                               const std::vector<std::pair<std::string, std::string>>& context) {
+            std::ofstream out(path);
+            if (!out) {
+                return false;
+            }
+            out << "{\n  \"context\": {\n";
+            out << "    \"date\": \"" << timestamp() << "\"";
+            for (const auto& entry : context) {
+                out << ",\n    \"" << entry.first << "\": \"" << entry.second << "\"";
+            }
+            out << "\n  },\n  \"benchmarks\": [";
+            for (std::size_t i = 0; i < results.size(); ++i) {
+                const Result& r = results[i];
+                const double bytes_per_second = r.seconds > 0 ? static_cast<double>(r.bytes) / r.seconds : 0.0;
+                const double cycles_per_byte = r.bytes > 0 ? r.cycles / static_cast<double>(r.bytes) : 0.0;
+                out << (i == 0 ? "\n" : ",\n");
+                out << "    {\"name\": \"" << r.name << "\", \"run_type\": \"iteration\""
+                    << ", \"iterations\": " << r.iterations
+                    << ", \"real_time\": " << r.seconds * 1e9
+                    << ", \"cpu_time\": " << r.seconds * 1e9
+                    << ", \"time_unit\": \"ns\""
+                    << ", \"bytes\": " << r.bytes
+                    << ", \"bytes_per_second\": " << bytes_per_second
+                    << ", \"cycles_per_byte\": " << cycles_per_byte << "}";
+            }
+            out << "\n  ]\n}\n";
+            return static_cast<bool>(out);
+        }
+
+    private:
+        static Result measure(const Benchmark& benchmark, double min_time) {
+            using clock = std::chrono::steady_clock;
+            benchmark.body(); // warm up caches and lazily built state
+
+            // Double the iteration count until one batch runs for min_time
+            std::uint64_t iterations = 1;
+            for (;;) {
+                const std::uint64_t cycles_begin = cycle_counter();
+                const auto begin = clock::now();
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    benchmark.body();
+                }
+                const double elapsed = std::chrono::duration<double>(clock::now() - begin).count();
+                const std::uint64_t cycles = cycle_counter() - cycles_begin;
+                if (elapsed >= min_time || iterations >= (std::uint64_t(1) << 40)) {
+                    const auto n = static_cast<double>(iterations);
+                    return {benchmark.name, benchmark.bytes, iterations, elapsed / n,
+                            static_cast<double>(cycles) / n};
+                }
+                // Jump close to the target once the batch is long enough to time
+                const double scale = elapsed > 1e-3 ? std::min(10.0, 1.4 * min_time / elapsed) : 10.0;
+                iterations = std::max(iterations + 1, static_cast<std::uint64_t>(static_cast<double>(iterations) * scale));
+            }
+        }
+
+        static void print(const Result& r) {
+            const double mb_per_second = r.seconds > 0 ? static_cast<double>(r.bytes) / r.seconds / 1e6 : 0.0;
+            const double cycles_per_byte = r.bytes > 0 ? r.cycles / static_cast<double>(r.bytes) : 0.0;
+            std::printf("%-56s %11.3f us %12llu %12.1f %10.3f\n", r.name.c_str(), r.seconds * 1e6,
+                        static_cast<unsigned long long>(r.iterations), mb_per_second, cycles_per_byte);
+            std::fflush(stdout);
+        }
+
+        static std::string timestamp() {
+            const std::time_t now = std::time(nullptr);
+            char buffer[32];
+            std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+            return buffer;
+        }
+
+        std::vector<Benchmark> benchmarks_;
+    };
+
+} // namespace pystringpp_bench
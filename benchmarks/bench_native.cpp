@@ -0,0 +1,425 @@
+/**
+ * @file bench_native.cpp
+ * @brief Native micro-benchmarks for every function in src/pystringpp.h
+ *
+ * Each benchmark runs over inputs from 16 B up to --max-size (1 GiB at
+ * most) drawn from three corpora: DNA (uniform ACGT), ASCII (log-like lines)
+ * and binary (uniform random bytes). Search benchmarks add a match-density
+ * axis: a needle that never occurs, one that occurs about once, a dense one
+ * and a long (Two-Way) one. Quadratic algorithms stop at smaller sizes.
+ *
+ * Usage:
+ *   bench_native [--filter=SUBSTR] [--min-time=SECONDS] [--max-size=64M]
+ *                [--json=results.json]
+ *
+ * Built by the CMake target bench_native.
+ */
+
+#include "bench_harness.h"
+#include "pystringpp.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using pystringpp_bench::do_not_optimize;
+
+namespace {
+
+enum class Alphabet {
+    Dna,
+    Ascii,
+    Binary
+};
+
+const char* alphabet_name(Alphabet alphabet) {
+    switch (alphabet) {
+        case Alphabet::Dna:
+            return "dna";
+        case Alphabet::Ascii:
+            return "ascii";
+        case Alphabet::Binary:
+            return "binary";
+    }
+    return "?";
+}
+
+// One buffer per alphabet, generated on first use at the largest size;
+// smaller inputs are prefixes of it
+class Corpus {
+public:
+    explicit Corpus(std::size_t max_size) : max_size_(max_size) {}
+
+    std::string_view text(Alphabet alphabet, std::size_t size) {
+        std::string& buffer = buffers_[static_cast<int>(alphabet)];
+        if (buffer.empty()) {
+            buffer = generate(alphabet, max_size_);
+        }
+        return std::string_view(buffer).substr(0, size);
+    }
+
+private:
+    static std::string generate(Alphabet alphabet, std::size_t size) {
+        std::mt19937_64 rng(42);
+        std::string out;
+        out.reserve(size);
+        if (alphabet == Alphabet::Dna) {
+            while (out.size() < size) {
+                out += "ACGT"[rng() & 3];
+            }
+        } else if (alphabet == Alphabet::Binary) {
+            while (out.size() < size) {
+                out += static_cast<char>(rng() & 0xFF);
+            }
+        } else {
+            static const char* const words[] = {
+                "level=INFO", "level=WARN", "request", "served", "status=200", "status=404",
+                "user", "session", "latency_ms=", "path=/api/v1/items", "the", "and", "of",
+                "cache", "miss", "hit", "retry", "worker", "queue", "id="};
+            while (out.size() < size) {
+                const std::size_t words_in_line = 6 + rng() % 6;
+                for (std::size_t w = 0; w < words_in_line; ++w) {
+                    out += words[rng() % (sizeof(words) / sizeof(words[0]))];
+                    out += rng() % 4 == 0 ? std::to_string(rng() % 100000) : std::string();
+                    out += ' ';
+                }
+                out.back() = '\n';
+            }
+        }
+        out.resize(size);
+        return out;
+    }
+
+    std::size_t max_size_;
+    std::string buffers_[3];
+};
+
+std::string size_label(std::size_t size) {
+    if (size >= (std::size_t(1) << 30) && size % (std::size_t(1) << 30) == 0) {
+        return std::to_string(size >> 30) + "G";
+    }
+    if (size >= (std::size_t(1) << 20) && size % (std::size_t(1) << 20) == 0) {
+        return std::to_string(size >> 20) + "M";
+    }
+    if (size >= (std::size_t(1) << 10) && size % (std::size_t(1) << 10) == 0) {
+        return std::to_string(size >> 10) + "K";
+    }
+    return std::to_string(size);
+}
+
+bool parse_size(const std::string& value, std::size_t& size) {
+    char* end = nullptr;
+    const unsigned long long base = std::strtoull(value.c_str(), &end, 10);
+    std::size_t shift = 0;
+    if (*end == 'K' || *end == 'k') {
+        shift = 10;
+    } else if (*end == 'M' || *end == 'm') {
+        shift = 20;
+    } else if (*end == 'G' || *end == 'g') {
+        shift = 30;
+    } else if (*end != '\0') {
+        return false;
+    }
+    size = static_cast<std::size_t>(base) << shift;
+    return end != value.c_str();
+}
+
+// Needles by expected match density in each corpus
+struct Needle {
+    const char* density;
+    std::string text;
+};
+
+std::vector<Needle> needles(Alphabet alphabet) {
+    switch (alphabet) {
+        case Alphabet::Dna:
+            return {{"absent", "ACGTNACGT"},
+                    {"rare", "ACGTTGCAAGCTTA"},
+                    {"dense", "ACG"},
+                    {"long", "ACGTTGCAAGCTTAGGCATCGATCGGATCCATGCAATTG"}};
+        case Alphabet::Ascii:
+            return {{"absent", "status=500"},
+                    {"rare", "miss retry cache hit"},
+                    {"dense", "status"},
+                    {"long", "path=/api/v1/items queue worker level=ERROR"}};
+        case Alphabet::Binary:
+            return {{"absent", std::string(12, '\0') + "\x01\x02"},
+                    {"rare", "\x9e\x37\x79\xb9"},
+                    {"dense", "\x7f"},
+                    {"long", std::string("\xde\xad\xbe\xef", 4) + std::string(36, '\x55')}};
+    }
+    return {};
+}
+
+// Split text into fixed-size records for the batch benchmarks
+std::vector<std::string_view> records(std::string_view text, std::size_t record_size) {
+    std::vector<std::string_view> out;
+    for (std::size_t i = 0; i < text.size(); i += record_size) {
+        out.push_back(text.substr(i, record_size));
+    }
+    return out;
+}
+
+void register_benchmarks(pystringpp_bench::Runner& runner, Corpus& corpus, std::size_t max_size,
+                         const std::string& scratch_dir) {
+    const Alphabet alphabets[] = {Alphabet::Dna, Alphabet::Ascii, Alphabet::Binary};
+    // 16 B to 256 MiB in steps of 16x, then 1 GiB
+    std::vector<std::size_t> sizes;
+    for (std::size_t size = 16; size <= max_size; size <<= (size < (std::size_t(1) << 28) ? 4 : 2)) {
+        sizes.push_back(size);
+    }
+    // Inputs are the same view across iterations; the lambdas capture it
+    auto input = [&corpus](Alphabet alphabet, std::size_t size) { return corpus.text(alphabet, size); };
+    auto name = [](const char* function, Alphabet alphabet, std::size_t size, const char* variant = nullptr) {
+        std::string label = std::string(function) + "/" + alphabet_name(alphabet) + "/" + size_label(size);
+        return variant != nullptr ? label + "/" + variant : label;
+    };
+
+    for (std::size_t size : sizes) {
+        for (Alphabet alphabet : alphabets) {
+            runner.add(name("reverse_string", alphabet, size), size, [=] {
+                do_not_optimize(pystringpp::reverse_string(input(alphabet, size)));
+            });
+            // Reverses the same buffer back and forth; no allocation per call
+            const auto buffer = std::make_shared<std::string>(input(alphabet, size));
+            runner.add(name("reverse_inplace", alphabet, size), size, [=] {
+                pystringpp::reverse_inplace(*buffer);
+                do_not_optimize(buffer->data());
+            });
+            runner.add(name("count_char", alphabet, size), size, [=] {
+                do_not_optimize(pystringpp::count_char(input(alphabet, size), 'A'));
+            });
+            for (const Needle& needle : needles(alphabet)) {
+                runner.add(name("find_pattern", alphabet, size, needle.density), size, [=] {
+                    do_not_optimize(pystringpp::find_pattern(input(alphabet, size), needle.text));
+                });
+                const auto compiled = std::make_shared<pystringpp::Pattern>(needle.text);
+                runner.add(name("Pattern.count", alphabet, size, needle.density), size, [=] {
+                    do_not_optimize(compiled->count(input(alphabet, size)));
+                });
+                const auto folded = std::make_shared<pystringpp::Pattern>(needle.text,
+                                                                          pystringpp::Pattern::CaseMode::AsciiFold);
+                runner.add(name("Pattern.count", alphabet, size, needle.density) + "/ascii-fold", size, [=] {
+                    do_not_optimize(folded->count(input(alphabet, size)));
+                });
+            }
+            runner.add(name("byte_histogram", alphabet, size), size, [=] {
+                do_not_optimize(pystringpp::byte_histogram(input(alphabet, size)));
+            });
+            runner.add(name("count_chars", alphabet, size), size, [=] {
+                do_not_optimize(pystringpp::count_chars(input(alphabet, size)));
+            });
+            runner.add(name("remove_duplicates", alphabet, size), size, [=] {
+                do_not_optimize(pystringpp::remove_duplicates(input(alphabet, size)));
+            });
+            runner.add(name("is_palindrome", alphabet, size), size, [=] {
+                do_not_optimize(pystringpp::is_palindrome(input(alphabet, size)));
+            });
+        }
+        runner.add(name("reverse_utf8", Alphabet::Ascii, size), size, [=] {
+            do_not_optimize(pystringpp::reverse_utf8(input(Alphabet::Ascii, size)));
+        });
+        runner.add(name("reverse_graphemes", Alphabet::Ascii, size), size, [=] {
+            do_not_optimize(pystringpp::reverse_graphemes(input(Alphabet::Ascii, size)));
+        });
+        runner.add(name("remove_duplicates_utf8", Alphabet::Ascii, size), size, [=] {
+            do_not_optimize(pystringpp::remove_duplicates_utf8(input(Alphabet::Ascii, size)));
+        });
+
+        // Parallel and streaming search on log-like text
+        if (size >= (std::size_t(1) << 20)) {
+            runner.add(name("find_pattern_parallel", Alphabet::Ascii, size, "rare"), size, [=] {
+                do_not_optimize(pystringpp::find_pattern_parallel(input(Alphabet::Ascii, size), "miss retry"));
+            });
+        }
+        const auto unicode_folded = std::make_shared<pystringpp::Pattern>(
+            "Stra\xc3\x9f" "e", pystringpp::Pattern::CaseMode::UnicodeFold);
+        runner.add(name("Pattern.count", Alphabet::Ascii, size, "unicode-fold"), size, [=] {
+            do_not_optimize(unicode_folded->count(input(Alphabet::Ascii, size)));
+        });
+        runner.add(name("StreamingMatcher.feed", Alphabet::Ascii, size, "64K-chunks"), size, [=] {
+            pystringpp::StreamingMatcher matcher("status=404");
+            const std::string_view text = input(Alphabet::Ascii, size);
+            std::vector<std::size_t> positions;
+            for (std::size_t i = 0; i < text.size(); i += 65536) {
+                matcher.feed(text.substr(i, 65536), positions);
+            }
+            do_not_optimize(positions.size());
+        });
+        for (auto mode : {pystringpp::AhoCorasick::Mode::Dense, pystringpp::AhoCorasick::Mode::Compact}) {
+            const auto automaton = std::make_shared<pystringpp::AhoCorasick>(
+                std::vector<std::string>{"status=404", "retry", "level=WARN", "miss", "latency_ms=9",
+                                         "session user", "queue worker", "ERROR"},
+                mode);
+            const char* variant = mode == pystringpp::AhoCorasick::Mode::Dense ? "dense" : "compact";
+            runner.add(name("AhoCorasick.count", Alphabet::Ascii, size, variant), size, [=] {
+                do_not_optimize(automaton->count(input(Alphabet::Ascii, size)));
+            });
+        }
+
+        // Random text mismatches at once; a real palindrome is a full scan
+        const auto palindrome = std::make_shared<std::string>(input(Alphabet::Ascii, size / 2));
+        palindrome->append(palindrome->rbegin(), palindrome->rend());
+        runner.add(name("is_palindrome", Alphabet::Ascii, size, "palindrome"), size, [=] {
+            do_not_optimize(pystringpp::is_palindrome(*palindrome));
+        });
+        runner.add(name("is_palindrome_utf8", Alphabet::Ascii, size, "palindrome"), size, [=] {
+            do_not_optimize(pystringpp::is_palindrome_utf8(*palindrome));
+        });
+
+        // DNA functions
+        runner.add(name("validate_dna", Alphabet::Dna, size), size, [=] {
+            do_not_optimize(pystringpp::validate_dna(input(Alphabet::Dna, size)));
+        });
+        // Primer-length and long patterns, within two errors
+        for (std::size_t m : {std::size_t(20), std::size_t(100)}) {
+            const std::string primer(input(Alphabet::Dna, size).substr(0, std::min(m, size)));
+            const std::string variant = std::to_string(m) + "bp";
+            runner.add(name("find_approximate", Alphabet::Dna, size, (variant + "/k2-subst").c_str()), size, [=] {
+                do_not_optimize(pystringpp::find_approximate(input(Alphabet::Dna, size), primer, 2).size());
+            });
+            runner.add(name("find_approximate", Alphabet::Dna, size, (variant + "/k2-edits").c_str()), size, [=] {
+                do_not_optimize(pystringpp::find_approximate(input(Alphabet::Dna, size), primer, 2,
+                                                             pystringpp::ErrorModel::Edits).size());
+            });
+        }
+        // Index once, then each query costs O(m log n) instead of a scan;
+        // the per-query rate is directly comparable to find_pattern's
+        runner.add(name("SuffixIndex", Alphabet::Dna, size, "build"), size, [=] {
+            do_not_optimize(pystringpp::SuffixIndex(std::string(input(Alphabet::Dna, size))).size());
+        });
+        const auto index = std::make_shared<pystringpp::SuffixIndex>(std::string(input(Alphabet::Dna, size)));
+        const std::string probe(input(Alphabet::Dna, size).substr(size / 2, 20));
+        runner.add(name("SuffixIndex.locate", Alphabet::Dna, size, "20bp"), size, [=] {
+            do_not_optimize(index->locate(probe));
+        });
+        runner.add(name("find_pattern", Alphabet::Dna, size, "20bp"), size, [=] {
+            do_not_optimize(pystringpp::find_pattern(input(Alphabet::Dna, size), probe));
+        });
+        runner.add(name("calculate_gc_content", Alphabet::Dna, size), size, [=] {
+            do_not_optimize(pystringpp::calculate_gc_content(input(Alphabet::Dna, size)));
+        });
+        runner.add(name("dna_stats", Alphabet::Dna, size), size, [=] {
+            do_not_optimize(pystringpp::dna_stats(input(Alphabet::Dna, size)));
+        });
+
+        // Batch variants over 150-byte records (a short-read length)
+        if (size >= 4096) {
+            runner.add(name("count_char_batch", Alphabet::Ascii, size, "150B-records"), size, [=] {
+                do_not_optimize(pystringpp::count_char_batch(records(input(Alphabet::Ascii, size), 150), '\n'));
+            });
+            runner.add(name("find_pattern_batch", Alphabet::Ascii, size, "150B-records"), size, [=] {
+                do_not_optimize(pystringpp::find_pattern_batch(records(input(Alphabet::Ascii, size), 150), "status"));
+            });
+            runner.add(name("is_palindrome_batch", Alphabet::Ascii, size, "150B-records"), size, [=] {
+                do_not_optimize(pystringpp::is_palindrome_batch(records(input(Alphabet::Ascii, size), 150)));
+            });
+            runner.add(name("gc_content_batch", Alphabet::Dna, size, "150B-records"), size, [=] {
+                do_not_optimize(pystringpp::gc_content_batch(records(input(Alphabet::Dna, size), 150)));
+            });
+        }
+
+        // SequenceReader over a FASTA file written once with 80-column lines
+        if (size >= 4096 && size <= (std::size_t(1) << 28)) {
+            const std::string path = scratch_dir + "/bench_" + size_label(size) + ".fa";
+            runner.add(name("SequenceReader", Alphabet::Dna, size, "fasta"), size, [=] {
+                if (!std::filesystem::exists(path)) {
+                    std::ofstream out(path, std::ios::binary);
+                    const std::string_view sequence = input(Alphabet::Dna, size);
+                    for (std::size_t record = 0; record * 65536 < sequence.size(); ++record) {
+                        out << ">record" << record << '\n';
+                        const std::string_view body = sequence.substr(record * 65536, 65536);
+                        for (std::size_t i = 0; i < body.size(); i += 80) {
+                            out << body.substr(i, 80) << '\n';
+                        }
+                    }
+                }
+                pystringpp::SequenceReader reader(path);
+                pystringpp::SequenceRecord record;
+                while (reader.next(record)) {
+                }
+                do_not_optimize(reader.totals());
+            });
+        }
+
+        // Pairwise algorithms: bit-parallel ones are O(n * m / 64), the LCS
+        // string reconstruction is O(n * m)
+        if (size <= 65536) {
+            for (Alphabet alphabet : {Alphabet::Dna, Alphabet::Ascii}) {
+                runner.add(name("levenshtein_distance", alphabet, size), size, [=] {
+                    const std::string_view text = input(alphabet, 2 * size);
+                    do_not_optimize(pystringpp::levenshtein_distance(text.substr(0, size), text.substr(size)));
+                });
+                runner.add(name("levenshtein_within", alphabet, size, "k=8"), size, [=] {
+                    const std::string_view text = input(alphabet, 2 * size);
+                    do_not_optimize(pystringpp::levenshtein_within(text.substr(0, size), text.substr(size), 8));
+                });
+                runner.add(name("lcs_length", alphabet, size), size, [=] {
+                    const std::string_view text = input(alphabet, 2 * size);
+                    do_not_optimize(pystringpp::lcs_length(text.substr(0, size), text.substr(size)));
+                });
+                if (size <= 4096) {
+                    runner.add(name("longest_common_subsequence", alphabet, size), size, [=] {
+                        const std::string_view text = input(alphabet, 2 * size);
+                        do_not_optimize(pystringpp::longest_common_subsequence(text.substr(0, size), text.substr(size)));
+                    });
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    pystringpp_bench::Options options;
+    std::size_t max_size = std::size_t(64) << 20;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const auto value = [&arg](const char* flag) {
+            const std::string prefix = std::string(flag) + "=";
+            return arg.compare(0, prefix.size(), prefix) == 0 ? arg.substr(prefix.size()) : std::string();
+        };
+        if (!value("--filter").empty()) {
+            options.filter = value("--filter");
+        } else if (!value("--min-time").empty()) {
+            options.min_time = std::atof(value("--min-time").c_str());
+        } else if (!value("--json").empty()) {
+            options.json_path = value("--json");
+        } else if (!value("--max-size").empty() && parse_size(value("--max-size"), max_size)) {
+            max_size = std::min(max_size, std::size_t(1) << 30);
+        } else {
+            std::fprintf(stderr,
+                         "usage: %s [--filter=SUBSTR] [--min-time=SECONDS] [--max-size=64M] [--json=PATH]\n",
+                         argv[0]);
+            return 2;
+        }
+    }
+
+    // Pairwise benchmarks (up to 64 KiB) read two halves of twice the size
+    Corpus corpus(std::max<std::size_t>(max_size, 2 * 65536));
+    const std::filesystem::path scratch = std::filesystem::temp_directory_path() / "pystringpp_bench";
+    std::filesystem::create_directories(scratch);
+
+    pystringpp_bench::Runner runner;
+    register_benchmarks(runner, corpus, max_size, scratch.string());
+    std::printf("simd_level: %s\n", pystringpp::simd_level());
+    const auto results = runner.run(options);
+
+    std::filesystem::remove_all(scratch);
+    if (!options.json_path.empty() &&
+        !pystringpp_bench::Runner::write_json(options.json_path, results,
+                                              {{"library", "pystringpp"},
+                                               {"simd_level", pystringpp::simd_level()},
+                                               {"max_size", size_label(max_size)}})) {
+        std::fprintf(stderr, "cannot write %s\n", options.json_path.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,69 @@
+#!/usr/bin/env python3
+"""
+Benchmark: multi-threaded scaling of the GIL-releasing bindings.
+
+Each worker thread searches its own independent buffer. Because the bindings
+drop the GIL while the C++ code runs, wall-clock time for a fixed amount of
+work per thread should stay roughly flat as threads are added (near-linear
+aggregate throughput) until cores or memory bandwidth run out.
+
+Usage: python benchmarks/bench_threads.py [max_threads] [size_in_mb_per_thread]
+"""
+
+import os
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+import pystringpp as su
+
+CALLS_PER_THREAD = 8
+
+
+def make_input(seed, size):
+    """Independent pseudo-log buffer per thread."""
+    line = f"worker={seed} level=INFO msg=request served status=200 id=".encode()
+    body = bytearray()
+    counter = 0
+    while len(body) < size:
+        body += line + str(counter).encode() + b"\n"
+        counter += 1
+    return bytes(body[:size])
+
+
+def workload(data):
+    needle = su.Pattern(b"status=500")
+    total = 0
+    for _ in range(CALLS_PER_THREAD):
+        total += su.count_char(data, "\n")
+        total += len(su.find_pattern(data, "id=9"))
+        total += needle.count(data)
+    return total
+
+
+def run(threads, inputs):
+    with ThreadPoolExecutor(max_workers=threads) as pool:
+        start = time.perf_counter()
+        list(pool.map(workload, inputs[:threads]))
+        return time.perf_counter() - start
+
+
+def main():
+    max_threads = int(sys.argv[1]) if len(sys.argv) > 1 else max(8, os.cpu_count() or 1)
+    size = int(sys.argv[2]) * 1024 * 1024 if len(sys.argv) > 2 else 16 * 1024 * 1024
+    inputs = [make_input(seed, size) for seed in range(max_threads)]
+
+    print(f"pystringpp {su.__version__} ({su.simd_level()}), "
+          f"{size // (1024 * 1024)} MB per thread, {os.cpu_count()} CPUs")
+    baseline = run(1, inputs)
+    threads = 1
+    while threads <= max_threads:
+        seconds = run(threads, inputs)
+        speedup = threads * baseline / seconds
+        print(f"  {threads:3d} threads  {seconds:8.3f} s  "
+              f"speedup {speedup:5.2f}x  efficiency {speedup / threads:6.1%}")
+        threads *= 2
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+"""
+Benchmark: argument conversion cost for each supported input type.
+
+Runs count_char and find_pattern over the same payload passed as str, bytes,
+bytearray, memoryview, mmap and (if installed) a numpy uint8 array. All of
+them are viewed in place by the bindings, so throughput should be the same
+for every type; the explicit-copy row shows what a conversion to a fresh
+buffer would cost on top.
+
+Usage: python benchmarks/bench_zero_copy.py [size_in_mb]
+"""
+
+import mmap
+import sys
+import tempfile
+import time
+
+import pystringpp as su
+
+try:
+    import numpy as np
+except ImportError:
+    np = None
+
+REPEATS = 5
+
+
+def best_time(func):
+    """Best wall-clock time of several runs, in seconds."""
+    best = float('inf')
+    for _ in range(REPEATS):
+        start = time.perf_counter()
+        func()
+        best = min(best, time.perf_counter() - start)
+    return best
+
+
+def report(label, size, seconds):
+    print(f"  {label:<22} {seconds * 1e3:9.2f} ms  {size / seconds / 1e9:7.2f} GB/s")
+
+
+def main():
+    size_mb = int(sys.argv[1]) if len(sys.argv) > 1 else 256
+    line = b"2024-01-01 12:00:00 INFO request served in 12ms status=200\n"
+    payload = (line * (size_mb * 1024 * 1024 // len(line) + 1))[:size_mb * 1024 * 1024]
+    size = len(payload)
+
+    with tempfile.TemporaryFile() as handle:
+        handle.write(payload)
+        handle.flush()
+        mapped = mmap.mmap(handle.fileno(), 0, access=mmap.ACCESS_READ)
+
+        inputs = [
+            ('str', payload.decode('ascii')),
+            ('bytes', payload),
+            ('bytearray', bytearray(payload)),
+            ('memoryview', memoryview(payload)),
+            ('mmap', mapped),
+        ]
+        if np is not None:
+            inputs.append(('numpy uint8', np.frombuffer(payload, dtype=np.uint8)))
+
+        print(f"pystringpp {su.__version__} ({su.simd_level()}), payload {size_mb} MB")
+        for name, func in [
+            ('count_char', lambda data: su.count_char(data, '\n')),
+            ('find_pattern', lambda data: su.find_pattern(data, 'status=500')),
+        ]:
+            print(f"{name}:")
+            for label, data in inputs:
+                report(label, size, best_time(lambda: func(data)))
+            report('bytes + explicit copy', size, best_time(lambda: func(bytes(bytearray(payload)))))
+
+        del inputs
+        mapped.close()
+
+
+if __name__ == '__main__':
+    main()
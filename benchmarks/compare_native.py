@@ -0,0 +1,53 @@
+#!/usr/bin/env python3
+"""
+Compare two JSON result files from bench_native (e.g. two releases).
+
+Prints the throughput of every benchmark present in both files and the
+ratio new/old; ratios below 1 - threshold are flagged as regressions and
+make the script exit with status 1.
+
+Usage: python benchmarks/compare_native.py old.json new.json [threshold]
+"""
+
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        data = json.load(f)
+    return data.get('context', {}), {b['name']: b for b in data['benchmarks']}
+
+
+def main():
+    if len(sys.argv) < 3:
+        print(__doc__.strip())
+        return 2
+    threshold = float(sys.argv[3]) if len(sys.argv) > 3 else 0.05
+    old_context, old = load(sys.argv[1])
+    new_context, new = load(sys.argv[2])
+    print(f"old: {old_context.get('date', '?')} simd={old_context.get('simd_level', '?')}")
+    print(f"new: {new_context.get('date', '?')} simd={new_context.get('simd_level', '?')}")
+    print(f"{'Benchmark':<56} {'old MB/s':>12} {'new MB/s':>12} {'ratio':>8}")
+
+    regressions = 0
+    for name, result in new.items():
+        if name not in old:
+            continue
+        before = old[name]['bytes_per_second'] / 1e6
+        after = result['bytes_per_second'] / 1e6
+        ratio = after / before if before > 0 else float('inf')
+        flag = ''
+        if ratio < 1 - threshold:
+            flag = '  REGRESSION'
+            regressions += 1
+        print(f"{name:<56} {before:>12.1f} {after:>12.1f} {ratio:>8.3f}{flag}")
+
+    missing = sorted(set(old) - set(new))
+    if missing:
+        print(f"{len(missing)} benchmark(s) only in {sys.argv[1]}")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
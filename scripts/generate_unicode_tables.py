@@ -0,0 +1,207 @@
+#!/usr/bin/env python3
+"""Regenerate the Unicode property tables in src/unicode.cpp.
+
+Reads the Unicode Character Database files
+
+    CaseFolding.txt             simple case folding (statuses C and S)
+    GraphemeBreakProperty.txt   Extend, SpacingMark and Control
+    DerivedGeneralCategory.txt  combining marks (Mn, Mc, Me)
+    Blocks.txt                  block names, used only for comments
+
+from a local directory, or downloads them for the given Unicode version,
+and rewrites the regions of src/unicode.cpp between the
+"BEGIN GENERATED <name>" and "END GENERATED <name>" marker comments.
+
+    python scripts/generate_unicode_tables.py --ucd path/to/ucd
+    python scripts/generate_unicode_tables.py --version 14.0.0
+"""
+
+import argparse
+import bisect
+import os
+import re
+import sys
+import urllib.request
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+TARGET = os.path.join(ROOT, 'src', 'unicode.cpp')
+FILES = {
+    'CaseFolding.txt': 'CaseFolding.txt',
+    'GraphemeBreakProperty.txt': 'auxiliary/GraphemeBreakProperty.txt',
+    'DerivedGeneralCategory.txt': 'extracted/DerivedGeneralCategory.txt',
+    'Blocks.txt': 'Blocks.txt',
+}
+
+
+def read_ucd(name, ucd_dir, version):
+    """Data lines of a UCD file as lists of stripped fields, comments removed."""
+    if ucd_dir:
+        for candidate in (FILES[name], name):
+            path = os.path.join(ucd_dir, candidate)
+            if os.path.exists(path):
+                with open(path, encoding='utf-8') as f:
+                    text = f.read()
+                break
+        else:
+            sys.exit(f'{name} not found in {ucd_dir}')
+    else:
+        url = f'https://www.unicode.org/Public/{version}/ucd/{FILES[name]}'
+        with urllib.request.urlopen(url) as response:
+            text = response.read().decode('utf-8')
+    rows = []
+    for line in text.splitlines():
+        line = line.split('#', 1)[0].strip()
+        if line:
+            rows.append([field.strip() for field in line.split(';')])
+    return rows
+
+
+def parse_range(field):
+    first, _, last = field.partition('..')
+    return int(first, 16), int(last or first, 16)
+
+
+def property_ranges(rows, values):
+    """Merged, sorted [first, last] ranges whose property value is in values."""
+    ranges = sorted(parse_range(row[0]) for row in rows if row[1] in values)
+    merged = []
+    for first, last in ranges:
+        if merged and first <= merged[-1][1] + 1:
+            merged[-1][1] = max(merged[-1][1], last)
+        else:
+            merged.append([first, last])
+    return merged
+
+
+def fold_ranges(rows):
+    """Compress the C and S foldings into (first, last, kind, delta) ranges.
+
+    Offset ranges are runs of consecutive code points sharing one delta;
+    EvenUpper / OddUpper ranges are runs of upper/lower pairs folding to the
+    next code point, with the uppercase letter at even / odd code points.
+    """
+    folds = {int(row[0], 16): int(row[2], 16) for row in rows if row[1] in ('C', 'S')}
+    codepoints = sorted(folds)
+    ranges = []
+    i = 0
+    while i < len(codepoints):
+        first = codepoints[i]
+        delta = folds[first] - first
+
+        offset_end = i
+        while (offset_end + 1 < len(codepoints) and codepoints[offset_end + 1] == codepoints[offset_end] + 1
+               and folds[codepoints[offset_end + 1]] - codepoints[offset_end + 1] == delta):
+            offset_end += 1
+
+        # The lowercase code points in between must not fold themselves
+        pairs_end = i
+        if delta == 1:
+            while (pairs_end + 1 < len(codepoints) and codepoints[pairs_end + 1] == codepoints[pairs_end] + 2
+                   and folds[codepoints[pairs_end + 1]] == codepoints[pairs_end + 1] + 1
+                   and codepoints[pairs_end] + 1 not in folds):
+                pairs_end += 1
+
+        if pairs_end > i and pairs_end - i >= offset_end - i:
+            kind = 'EvenUpper' if first % 2 == 0 else 'OddUpper'
+            ranges.append((first, codepoints[pairs_end], kind, 1))
+            i = pairs_end + 1
+        else:
+            ranges.append((first, codepoints[offset_end], 'Offset', delta))
+            i = offset_end + 1
+
+    # Check the compression against the source mapping, looking ranges up
+    # the way simple_casefold() does
+    firsts = [first for first, _, _, _ in ranges]
+
+    def fold(codepoint):
+        index = bisect.bisect_right(firsts, codepoint) - 1
+        if index < 0 or codepoint > ranges[index][1]:
+            return codepoint
+        _, _, kind, delta = ranges[index]
+        if kind == 'Offset':
+            return codepoint + delta
+        upper = codepoint % 2 == (0 if kind == 'EvenUpper' else 1)
+        return codepoint + 1 if upper else codepoint
+    for codepoint in range(0x110000):
+        assert fold(codepoint) == folds.get(codepoint, codepoint), hex(codepoint)
+    return ranges
+
+
+class Blocks:
+    def __init__(self, rows):
+        self.blocks = sorted((*parse_range(row[0]), row[1]) for row in rows)
+        self.firsts = [first for first, _, _ in self.blocks]
+
+    def name(self, codepoint):
+        index = bisect.bisect_right(self.firsts, codepoint) - 1
+        if index >= 0 and codepoint <= self.blocks[index][1]:
+            return self.blocks[index][2]
+        return None
+
+
+def with_block_comments(entries, blocks):
+    """Append the block name to the first entry of each block."""
+    lines = []
+    previous = None
+    for first, text in entries:
+        block = blocks.name(first)
+        if block != previous and block is not None:
+            text = f'{text:<48}// {block}'
+        previous = block
+        lines.append('    ' + text.rstrip())
+    return lines
+
+
+def format_ranges(ranges, blocks):
+    entries = [(first, f'{{0x{first:04x}, 0x{last:04x}}},') for first, last in ranges]
+    return with_block_comments(entries, blocks)
+
+
+def format_folds(ranges, blocks):
+    entries = [(first, f'{{0x{first:04x}, 0x{last:04x}, FoldKind::{kind}, {delta}}},')
+               for first, last, kind, delta in ranges]
+    return with_block_comments(entries, blocks)
+
+
+def replace_region(source, name, lines, version):
+    pattern = re.compile(r'^([ \t]*)// BEGIN GENERATED ' + name + r'\b[^\n]*\n(?:.*?\n)??'
+                         r'([ \t]*// END GENERATED ' + name + r'\b)', re.DOTALL | re.MULTILINE)
+    if not pattern.search(source):
+        sys.exit(f'marker for {name} not found in {TARGET}')
+
+    def region(match):
+        begin = f'{match.group(1)}// BEGIN GENERATED {name} (Unicode {version})\n'
+        return begin + ''.join(line + '\n' for line in lines) + match.group(2)
+    return pattern.sub(region, source, count=1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('--ucd', help='directory holding the UCD files (flat or in the UCD layout)')
+    parser.add_argument('--version', default='14.0.0',
+                        help='Unicode version to download, or of the files in --ucd')
+    args = parser.parse_args()
+
+    def read(name):
+        return read_ucd(name, args.ucd, args.version)
+
+    blocks = Blocks(read('Blocks.txt'))
+    grapheme_break = read('GraphemeBreakProperty.txt')
+    general_category = read('DerivedGeneralCategory.txt')
+    tables = {
+        'FOLDS': format_folds(fold_ranges(read('CaseFolding.txt')), blocks),
+        'GRAPHEME_EXTEND': format_ranges(property_ranges(grapheme_break, {'Extend', 'SpacingMark'}), blocks),
+        'GRAPHEME_CONTROL': format_ranges(property_ranges(grapheme_break, {'Control'}), blocks),
+        'MARKS': format_ranges(property_ranges(general_category, {'Mn', 'Mc', 'Me'}), blocks),
+    }
+
+    with open(TARGET, encoding='utf-8') as f:
+        source = f.read()
+    for name, lines in tables.items():
+        source = replace_region(source, name, lines, args.version)
+    with open(TARGET, 'w', encoding='utf-8') as f:
+        f.write(source)
+
+
+if __name__ == '__main__':
+    main()
@@ -1,19 +1,46 @@
+import os
+import sysconfig
+
 from setuptools import setup, Extension
 import pybind11
 
+
+def has_zlib():
+    """zlib is optional: it only adds gzip input to SequenceReader.
+
+    Set PYSTRINGPP_ZLIB=0 to build without it.
+    """
+    if os.environ.get('PYSTRINGPP_ZLIB', '1') == '0':
+        return False
+    include_dirs = [sysconfig.get_config_var('INCLUDEDIR'), '/usr/include', '/usr/local/include']
+    return any(d and os.path.exists(os.path.join(d, 'zlib.h')) for d in include_dirs)
+
+
+zlib_macros = [('PYSTRINGPP_HAVE_ZLIB', '1')] if has_zlib() else []
+zlib_libraries = ['z'] if zlib_macros else []
+
 ext_modules = [
     Extension(
         'pystringpp',
         [
             'src/pystringpp.cpp',
+            'src/aho_corasick.cpp',
+            'src/approximate.cpp',
+            'src/suffix_index.cpp',
+            'src/simd.cpp',
+            'src/thread_pool.cpp',
+            'src/sequence_reader.cpp',
+            'src/unicode.cpp',
             'src/bindings.cpp',
         ],
         include_dirs=[
             'src/',
             pybind11.get_include(),
         ],
+        define_macros=zlib_macros,
+        libraries=zlib_libraries,
         language='c++',
-        extra_compile_args=['-std=c++17'],
+        extra_compile_args=['-std=c++17', '-O3'],
     ),
 ]
 
@@ -0,0 +1,224 @@
+#include "pystringpp.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace pystringpp {
+
+namespace {
+
+// Mode::Auto uses the dense table while it stays below this many bytes
+constexpr std::size_t kDenseTableBudget = std::size_t(16) << 20;
+
+constexpr std::uint32_t kMaxStates = std::numeric_limits<std::uint32_t>::max();
+
+} // namespace
+
+AhoCorasick::AhoCorasick(const std::vector<std::string>& patterns, Mode mode)
+    : mode_(mode), pattern_lengths_(patterns.size()), byte_class_{}, class_count_(1) {
+    if (patterns.size() >= kMaxStates) {
+        throw std::length_error("AhoCorasick: too many patterns");
+    }
+
+    // Build the trie with per-node child lists, recording where each pattern ends.
+    // Empty patterns keep their id but end at no state, so they never match.
+    std::vector<std::vector<std::pair<unsigned char, std::uint32_t>>> children(1);
+    std::vector<std::uint32_t> terminal(patterns.size(), 0);
+
+    for (std::size_t id = 0; id < patterns.size(); ++id) {
+        const std::string& pattern = patterns[id];
+        pattern_lengths_[id] = pattern.length();
+        if (pattern.empty()) {
+            continue;
+        }
+
+        std::uint32_t state = 0;
+        for (char ch : pattern) {
+            const auto c = static_cast<unsigned char>(ch);
+            byte_class_[c] = 1;
+
+            auto& edges = children[state];
+            auto it = std::find_if(edges.begin(), edges.end(),
+                                   [c](const auto& edge) { return edge.first == c; });
+            if (it != edges.end()) {
+                state = it->second;
+                continue;
+            }
+
+            if (children.size() >= kMaxStates) {
+                throw std::length_error("AhoCorasick: pattern set too large");
+            }
+            const auto child = static_cast<std::uint32_t>(children.size());
+            edges.emplace_back(c, child);
+            children.emplace_back();
+            state = child;
+        }
+        terminal[id] = state;
+    }
+
+    const std::size_t states = children.size();
+
+    // Flatten the trie into sorted CSR edge arrays
+    edge_offsets_.assign(states + 1, 0);
+    for (std::size_t s = 0; s < states; ++s) {
+        std::sort(children[s].begin(), children[s].end());
+        edge_offsets_[s + 1] = edge_offsets_[s] + static_cast<std::uint32_t>(children[s].size());
+    }
+    edge_labels_.reserve(edge_offsets_[states]);
+    edge_targets_.reserve(edge_offsets_[states]);
+    for (const auto& edges : children) {
+        for (const auto& edge : edges) {
+            edge_labels_.push_back(edge.first);
+            edge_targets_.push_back(edge.second);
+        }
+    }
+    children.clear();
+    children.shrink_to_fit();
+
+    // Group pattern ids by terminal state, in CSR layout
+    output_offsets_.assign(states + 1, 0);
+    for (std::size_t id = 0; id < patterns.size(); ++id) {
+        if (terminal[id] != 0) {
+            ++output_offsets_[terminal[id] + 1];
+        }
+    }
+    for (std::size_t s = 0; s < states; ++s) {
+        output_offsets_[s + 1] += output_offsets_[s];
+    }
+    output_ids_.resize(output_offsets_[states]);
+    std::vector<std::uint32_t> fill(output_offsets_.begin(), output_offsets_.end() - 1);
+    for (std::size_t id = 0; id < patterns.size(); ++id) {
+        if (terminal[id] != 0) {
+            output_ids_[fill[terminal[id]]++] = static_cast<std::uint32_t>(id);
+        }
+    }
+
+    // Breadth-first pass: failure links and report links. Every failure link
+    // points to a shallower state, so it is always resolved before it is used.
+    fail_.assign(states, 0);
+    report_.assign(states, 0);
+    std::vector<std::uint32_t> order;
+    order.reserve(states);
+    order.push_back(0);
+    for (std::size_t head = 0; head < order.size(); ++head) {
+        const std::uint32_t state = order[head];
+        for (std::uint32_t e = edge_offsets_[state]; e < edge_offsets_[state + 1]; ++e) {
+            const std::uint32_t child = edge_targets_[e];
+            fail_[child] = state == 0 ? 0 : next_state(fail_[state], edge_labels_[e]);
+            const bool ends_pattern = output_offsets_[child] != output_offsets_[child + 1];
+            report_[child] = ends_pattern ? child : report_[fail_[child]];
+            order.push_back(child);
+        }
+    }
+
+    // Bytes that occur in some pattern get their own class; all others share class 0
+    std::uint16_t classes = 1;
+    for (auto& cls : byte_class_) {
+        cls = cls != 0 ? classes++ : 0;
+    }
+    class_count_ = classes;
+
+    if (mode_ == Mode::Auto) {
+        const std::size_t table_bytes = states * class_count_ * sizeof(std::uint32_t);
+        mode_ = table_bytes <= kDenseTableBudget ? Mode::Dense : Mode::Compact;
+    }
+
+    if (mode_ == Mode::Dense) {
+        // Each row starts as a copy of its failure state's row (already built,
+        // by BFS order) and is then overridden by the state's own trie edges
+        delta_.assign(states * class_count_, 0);
+        for (std::uint32_t state : order) {
+            std::uint32_t* row = &delta_[state * class_count_];
+            if (state != 0) {
+                std::copy_n(&delta_[fail_[state] * class_count_], class_count_, row);
+            }
+            for (std::uint32_t e = edge_offsets_[state]; e < edge_offsets_[state + 1]; ++e) {
+                row[byte_class_[edge_labels_[e]]] = edge_targets_[e];
+            }
+        }
+
+        // The trie edges are only needed by the compact representation
+        edge_offsets_ = {};
+        edge_labels_ = {};
+        edge_targets_ = {};
+    }
+}
+
+std::uint32_t AhoCorasick::next_state(std::uint32_t state, unsigned char c) const {
+    while (true) {
+        const auto first = edge_labels_.begin() + edge_offsets_[state];
+        const auto last = edge_labels_.begin() + edge_offsets_[state + 1];
+        const auto it = std::lower_bound(first, last, c);
+        if (it != last && *it == c) {
+            return edge_targets_[static_cast<std::size_t>(it - edge_labels_.begin())];
+        }
+        if (state == 0) {
+            return 0;
+        }
+        state = fail_[state];
+    }
+}
+
+template <typename OnMatch>
+void AhoCorasick::scan(std::string_view text, OnMatch&& on_match) const {
+    // Runs the automaton with the given transition function; on_match
+    // returns false to stop the scan early
+    auto run = [&](auto&& step) {
+        std::uint32_t state = 0;
+        for (std::size_t i = 0; i < text.length(); ++i) {
+            state = step(state, static_cast<unsigned char>(text[i]));
+            for (std::uint32_t t = report_[state]; t != 0; t = report_[fail_[t]]) {
+                for (std::uint32_t k = output_offsets_[t]; k < output_offsets_[t + 1]; ++k) {
+                    const std::uint32_t id = output_ids_[k];
+                    if (!on_match(id, i + 1 - pattern_lengths_[id])) {
+                        return;
+                    }
+                }
+            }
+        }
+    };
+
+    if (mode_ == Mode::Dense) {
+        run([this](std::uint32_t state, unsigned char c) {
+            return delta_[state * class_count_ + byte_class_[c]];
+        });
+    } else {
+        run([this](std::uint32_t state, unsigned char c) {
+            return next_state(state, c);
+        });
+    }
+}
+
+std::vector<AhoCorasick::Match> AhoCorasick::find_all(std::string_view text) const {
+    std::vector<Match> matches;
+    scan(text, [&matches](std::size_t id, std::size_t offset) {
+        matches.emplace_back(id, offset);
+        return true;
+    });
+
+    // The automaton reports by end position; order by start like find_pattern
+    std::sort(matches.begin(), matches.end(), [](const Match& a, const Match& b) {
+        return a.second != b.second ? a.second < b.second : a.first < b.first;
+    });
+    return matches;
+}
+
+std::size_t AhoCorasick::count(std::string_view text) const {
+    std::size_t total = 0;
+    scan(text, [&total](std::size_t, std::size_t) {
+        ++total;
+        return true;
+    });
+    return total;
+}
+
+bool AhoCorasick::contains(std::string_view text) const {
+    bool found = false;
+    scan(text, [&found](std::size_t, std::size_t) {
+        found = true;
+        return false;
+    });
+    return found;
+}
+
+} // namespace pystringpp
@@ -0,0 +1,163 @@
+#include "pystringpp.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace pystringpp {
+
+namespace {
+
+// Bit-parallel approximate matching in Shift-And form: bit i of the state
+// for d errors is set when pattern[0, i] matches a suffix of the text read
+// so far with at most d errors. Per text byte c, with B[c] the pattern
+// positions holding c and D / D' the states before / after c:
+//
+//   D'[0] = ((D[0] << 1) | 1) & B[c]
+//   D'[d] = ((D[d] << 1) | 1) & B[c]                  match
+//         | (D[d-1] << 1) | 1                         substitution
+//         | D[d-1]                                    insertion (Edits only)
+//         | (D'[d-1] << 1) | 1                        deletion (Edits only)
+//
+// Under Edits the first d pattern bytes can always be deleted, so D[d]
+// starts with its low d bits set. Bits shifted past the pattern's last
+// position only ever move further up and never reach the accept bit.
+
+std::uint64_t low_bits(std::size_t count) {
+    return count >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << count) - 1;
+}
+
+constexpr std::size_t kNoMatch = static_cast<std::size_t>(-1);
+
+// Patterns of up to 64 bytes: one word per error count
+template <bool Edits>
+void search_word(std::string_view text, std::string_view pattern, std::size_t k,
+                 std::vector<ApproximateMatch>& matches) {
+    std::uint64_t masks[256] = {};
+    for (std::size_t i = 0; i < pattern.size(); ++i) {
+        masks[static_cast<unsigned char>(pattern[i])] |= std::uint64_t(1) << i;
+    }
+    const std::uint64_t accept = std::uint64_t(1) << (pattern.size() - 1);
+
+    std::vector<std::uint64_t> state(k + 1);
+    for (std::size_t d = 0; d <= k; ++d) {
+        state[d] = Edits ? low_bits(d) : 0;
+    }
+
+    for (std::size_t j = 0; j < text.size(); ++j) {
+        const std::uint64_t b = masks[static_cast<unsigned char>(text[j])];
+        std::uint64_t lower_old = state[0];
+        std::uint64_t lower_new = ((lower_old << 1) | 1) & b;
+        state[0] = lower_new;
+        std::size_t errors = (lower_new & accept) != 0 ? 0 : kNoMatch;
+
+        for (std::size_t d = 1; d <= k; ++d) {
+            const std::uint64_t old = state[d];
+            std::uint64_t next = ((old << 1) | 1) & b;
+            if (Edits) {
+                next |= lower_old | ((lower_old | lower_new) << 1) | 1;
+            } else {
+                next |= (lower_old << 1) | 1;
+            }
+            state[d] = next;
+            lower_old = old;
+            lower_new = next;
+            if (errors == kNoMatch && (next & accept) != 0) {
+                errors = d;
+            }
+        }
+        if (errors != kNoMatch) {
+            matches.push_back({j + 1, errors});
+        }
+    }
+}
+
+// Longer patterns: each state is `words` 64-bit words, least significant
+// first, and shifts carry the top bit of one word into the next
+template <bool Edits>
+void search_blocks(std::string_view text, std::string_view pattern, std::size_t k,
+                   std::vector<ApproximateMatch>& matches) {
+    const std::size_t m = pattern.size();
+    const std::size_t words = (m + 63) / 64;
+    std::vector<std::uint64_t> masks(256 * words, 0);
+    for (std::size_t i = 0; i < m; ++i) {
+        masks[static_cast<unsigned char>(pattern[i]) * words + i / 64] |= std::uint64_t(1) << (i % 64);
+    }
+    const std::size_t accept_word = (m - 1) / 64;
+    const std::uint64_t accept = std::uint64_t(1) << ((m - 1) % 64);
+
+    // state[d * words + w]; lower_old holds the previous byte's state for d - 1
+    std::vector<std::uint64_t> state((k + 1) * words, 0);
+    if (Edits) {
+        for (std::size_t d = 0; d <= k; ++d) {
+            for (std::size_t w = 0; w < words && w * 64 < d; ++w) {
+                state[d * words + w] = low_bits(d - w * 64);
+            }
+        }
+    }
+    std::vector<std::uint64_t> lower_old(words);
+
+    for (std::size_t j = 0; j < text.size(); ++j) {
+        const std::uint64_t* b = &masks[static_cast<unsigned char>(text[j]) * words];
+
+        std::uint64_t carry = 1;
+        for (std::size_t w = 0; w < words; ++w) {
+            const std::uint64_t old = state[w];
+            lower_old[w] = old;
+            state[w] = ((old << 1) | carry) & b[w];
+            carry = old >> 63;
+        }
+        std::size_t errors = (state[accept_word] & accept) != 0 ? 0 : kNoMatch;
+
+        for (std::size_t d = 1; d <= k; ++d) {
+            std::uint64_t* row = &state[d * words];
+            const std::uint64_t* lower_new = &state[(d - 1) * words];
+            std::uint64_t match_carry = 1;
+            std::uint64_t error_carry = 1;
+            for (std::size_t w = 0; w < words; ++w) {
+                const std::uint64_t old = row[w];
+                const std::uint64_t below = lower_old[w];
+                std::uint64_t next = ((old << 1) | match_carry) & b[w];
+                if (Edits) {
+                    const std::uint64_t shifted = below | lower_new[w];
+                    next |= below | (shifted << 1) | error_carry;
+                    error_carry = shifted >> 63;
+                } else {
+                    next |= (below << 1) | error_carry;
+                    error_carry = below >> 63;
+                }
+                match_carry = old >> 63;
+                lower_old[w] = old;
+                row[w] = next;
+            }
+            if (errors == kNoMatch && (row[accept_word] & accept) != 0) {
+                errors = d;
+            }
+        }
+        if (errors != kNoMatch) {
+            matches.push_back({j + 1, errors});
+        }
+    }
+}
+
+} // namespace
+
+std::vector<ApproximateMatch> find_approximate(std::string_view text, std::string_view pattern,
+                                               std::size_t max_errors, ErrorModel model) {
+    std::vector<ApproximateMatch> matches;
+    if (pattern.empty() || text.empty()) {
+        return matches;
+    }
+
+    // Every occurrence needs at most m errors (m substitutions, or m
+    // deletions), so larger k only adds states that match everywhere
+    const std::size_t k = std::min(max_errors, pattern.size());
+    const bool edits = model == ErrorModel::Edits;
+    if (pattern.size() <= 64) {
+        edits ? search_word<true>(text, pattern, k, matches) : search_word<false>(text, pattern, k, matches);
+    } else {
+        edits ? search_blocks<true>(text, pattern, k, matches) : search_blocks<false>(text, pattern, k, matches);
+    }
+    return matches;
+}
+
+} // namespace pystringpp
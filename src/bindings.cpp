@@ -1,16 +1,546 @@
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 #include "pystringpp.h"
 
 namespace py = pybind11;
 
+namespace pybind11 {
+namespace detail {
+
+// Zero-copy std::string_view caster, replacing pybind11's default one (which
+// only takes str and bytes) for every binding in this module. Accepts:
+//   - str: the UTF-8 representation CPython caches on the object itself
+//   - bytes: the object's internal storage
+//   - any C-contiguous buffer of 1-byte items: bytearray, memoryview, mmap,
+//     numpy uint8/int8 arrays, array.array('B')
+// Buffer exports are held by the caster, which lives for the duration of the
+// bound call, so the view stays valid (and a bytearray cannot be resized).
+template <>
+class type_caster<std::string_view> {
+public:
+    PYBIND11_TYPE_CASTER(std::string_view, const_name("Union[str, bytes, Buffer]"));
+    
+    bool load(handle src, bool) {
+        PyObject* obj = src.ptr();
+        
+        if (PyUnicode_Check(obj)) {
+            Py_ssize_t size = 0;
+            const char* data = PyUnicode_AsUTF8AndSize(obj, &size);
+            if (data == nullptr) {
+                PyErr_Clear();
+                return false;
+            }
+            value = std::string_view(data, static_cast<std::size_t>(size));
+            return true;
+        }
+        
+        if (PyBytes_Check(obj)) {
+            value = std::string_view(PyBytes_AS_STRING(obj), static_cast<std::size_t>(PyBytes_GET_SIZE(obj)));
+            return true;
+        }
+        
+        if (PyObject_CheckBuffer(obj)) {
+            auto view = std::make_unique<Py_buffer>();
+            if (PyObject_GetBuffer(obj, view.get(), PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) {
+                PyErr_Clear();
+                return false;
+            }
+            buffer_.reset(view.release(), [](Py_buffer* exported) {
+                PyBuffer_Release(exported);
+                delete exported;
+            });
+            if (buffer_->itemsize != 1) {
+                return false;
+            }
+            value = std::string_view(static_cast<const char*>(buffer_->buf), static_cast<std::size_t>(buffer_->len));
+            return true;
+        }
+        
+        return false;
+    }
+    
+    static handle cast(std::string_view src, return_value_policy, handle) {
+        PyObject* result = PyUnicode_DecodeUTF8(src.data(), static_cast<Py_ssize_t>(src.size()), nullptr);
+        if (result == nullptr) {
+            throw error_already_set();
+        }
+        return result;
+    }
+    
+private:
+    std::shared_ptr<Py_buffer> buffer_;
+};
+
+} // namespace detail
+} // namespace pybind11
+
+namespace {
+
+using Offsets = py::array_t<std::int64_t, py::array::c_style | py::array::forcecast>;
+
+// Views over a batch of records: either the elements of a Python sequence or
+// Arrow-style slices data[offsets[i], offsets[i + 1]). Keeps the per-element
+// casters (and so any buffer exports) alive while the views are in use.
+class BatchViews {
+public:
+    explicit BatchViews(const py::sequence& items) {
+        if (py::isinstance<py::str>(items) || py::isinstance<py::bytes>(items)) {
+            throw py::type_error("expected a sequence of texts, not a single text");
+        }
+        const std::size_t count = items.size();
+        casters_.resize(count);
+        views_.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const py::object item = items[i];
+            if (!casters_[i].load(item, true)) {
+                throw py::type_error("batch element " + std::to_string(i) +
+                                     " is not str, bytes or a contiguous byte buffer");
+            }
+            views_.push_back(static_cast<std::string_view&>(casters_[i]));
+        }
+    }
+    
+    BatchViews(std::string_view data, const Offsets& offsets) {
+        if (offsets.ndim() != 1 || offsets.size() < 1) {
+            throw py::value_error("offsets must be a non-empty 1-D array");
+        }
+        const auto bounds = offsets.unchecked<1>();
+        const auto count = static_cast<std::size_t>(offsets.size() - 1);
+        views_.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::int64_t begin = bounds(i);
+            const std::int64_t end = bounds(i + 1);
+            if (begin < 0 || end < begin || static_cast<std::uint64_t>(end) > data.size()) {
+                throw py::value_error("offsets must be non-decreasing and within data");
+            }
+            views_.push_back(data.substr(static_cast<std::size_t>(begin), static_cast<std::size_t>(end - begin)));
+        }
+    }
+    
+    const std::vector<std::string_view>& views() const { return views_; }
+    
+private:
+    std::vector<py::detail::make_caster<std::string_view>> casters_;
+    std::vector<std::string_view> views_;
+};
+
+// Run fn with the GIL released and return its result
+template <typename Fn>
+auto without_gil(Fn&& fn) {
+    py::gil_scoped_release release;
+    return fn();
+}
+
+// Hand a vector to numpy without copying; the array owns the storage
+template <typename T>
+py::array_t<T> to_numpy(std::vector<T>&& values) {
+    auto* owned = new std::vector<T>(std::move(values));
+    py::capsule release(owned, [](void* ptr) {
+        delete static_cast<std::vector<T>*>(ptr);
+    });
+    return py::array_t<T>(static_cast<py::ssize_t>(owned->size()), owned->data(), release);
+}
+
+py::tuple matches_to_numpy(pystringpp::BatchMatches&& matches) {
+    return py::make_tuple(to_numpy(std::move(matches.offsets)), to_numpy(std::move(matches.positions)));
+}
+
+// SequenceReader is stateful and parses without the GIL, so each Python
+// object carries a lock against iteration from several threads at once.
+// The lock is only ever waited for with the GIL released, so a thread that
+// holds it may reacquire the GIL (to copy the record) without deadlocking.
+struct LockedSequenceReader {
+    LockedSequenceReader(const std::string& path, pystringpp::SequenceReader::Format format,
+                         std::size_t buffer_size)
+        : reader(path, format, buffer_size) {}
+    
+    pystringpp::SequenceReader reader;
+    std::mutex mutex;
+};
+
+// Python-side record: the C++ views are invalidated by the next read
+struct SequenceRecordCopy {
+    py::str name;
+    py::str sequence;
+    py::str quality;
+    pystringpp::DnaStats stats;
+};
+
+// Record fields are arbitrary bytes (e.g. Latin-1 sample names); undecodable
+// bytes round-trip as lone surrogates, as with os.fsdecode()
+py::str decode_field(std::string_view field) {
+    PyObject* decoded = PyUnicode_DecodeUTF8(field.data(), static_cast<py::ssize_t>(field.size()),
+                                             "surrogateescape");
+    if (decoded == nullptr) {
+        throw py::error_already_set();
+    }
+    return py::reinterpret_steal<py::str>(decoded);
+}
+
+} // namespace
+
 PYBIND11_MODULE(pystringpp, m) {
     m.doc() = "High-performance string processing library with C++/Python bindings";
     
-    // String processing functions
-    m.def("reverse_string", &pystringpp::reverse_string, "Reverse a string");
-    m.def("count_char", &pystringpp::count_char, "Count occurrences of a character");
-    m.def("find_pattern", &pystringpp::find_pattern, "Find pattern positions using KMP algorithm");
+    // String processing functions; text arguments accept str, bytes and any
+    // byte buffer without copying (see the std::string_view caster above).
+    // Every O(n) entry point drops the GIL once its arguments are converted;
+    // results are converted back to Python objects after it is reacquired.
+    // A str is reversed by code point, like s[::-1]; bytes and buffers by byte
+    m.def("reverse_string", [](const py::str& text) {
+        const auto view = text.cast<std::string_view>();
+        return without_gil([&] { return pystringpp::reverse_utf8(view); });
+    }, py::arg("text"), "Reverse a string");
+    // Byte reversal can split UTF-8 sequences, so it returns bytes
+    m.def("reverse_string", [](std::string_view text) {
+        return py::bytes(without_gil([&] { return pystringpp::reverse_string(text); }));
+    }, py::arg("text"), "Reverse a string");
+    m.def("reverse_utf8", &pystringpp::reverse_utf8,
+          "Reverse UTF-8 text by code point; ValueError on invalid UTF-8",
+          py::arg("text"), py::call_guard<py::gil_scoped_release>());
+    m.def("reverse_graphemes", &pystringpp::reverse_graphemes,
+          "Reverse UTF-8 text by extended grapheme cluster (combining marks, emoji sequences, flags stay whole)",
+          py::arg("text"), py::call_guard<py::gil_scoped_release>());
+    // Needs a writable export, so it does not go through the string_view caster:
+    // str and bytes are immutable and rejected by the buffer protocol itself
+    m.def("reverse_inplace", [](py::object buffer) {
+        Py_buffer view;
+        if (PyObject_GetBuffer(buffer.ptr(), &view, PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS) != 0) {
+            throw py::error_already_set();
+        }
+        std::unique_ptr<Py_buffer, void (*)(Py_buffer*)> release(&view, PyBuffer_Release);
+        if (view.itemsize != 1) {
+            throw py::type_error("reverse_inplace needs a buffer of 1-byte items");
+        }
+        py::gil_scoped_release nogil;
+        pystringpp::reverse_inplace(static_cast<char*>(view.buf), static_cast<std::size_t>(view.len));
+    }, py::arg("buffer"),
+       "Reverse a writable contiguous byte buffer (bytearray, memoryview, numpy uint8) in place");
+    m.def("count_char", &pystringpp::count_char, "Count occurrences of a character",
+          py::call_guard<py::gil_scoped_release>());
+    m.def("byte_histogram", [](std::string_view text, bool as_dict) -> py::object {
+        const auto counts = without_gil([&] { return pystringpp::byte_histogram(text); });
+        if (as_dict) {
+            py::dict result;
+            for (std::size_t b = 0; b < counts.size(); ++b) {
+                if (counts[b] != 0) {
+                    result[py::int_(b)] = py::int_(counts[b]);
+                }
+            }
+            return std::move(result);
+        }
+        return to_numpy(std::vector<std::uint64_t>(counts.begin(), counts.end()));
+    }, py::arg("text"), py::arg("as_dict") = false,
+       "Occurrences of every byte value: uint64 numpy array of 256, or {byte: count} of the non-zero ones");
+    m.def("find_pattern_parallel", &pystringpp::find_pattern_parallel,
+          "find_pattern split across a thread pool; identical output",
+          py::arg("text"), py::arg("pattern"), py::arg("threads") = 0,
+          py::arg("min_parallel_size") = std::size_t(1) << 22,
+          py::call_guard<py::gil_scoped_release>());
+    py::enum_<pystringpp::ErrorModel>(m, "ErrorModel", "What find_approximate counts as an error")
+        .value("Substitutions", pystringpp::ErrorModel::Substitutions)
+        .value("Edits", pystringpp::ErrorModel::Edits);
+    m.def("find_approximate", [](std::string_view text, std::string_view pattern, std::size_t max_errors,
+                                 pystringpp::ErrorModel model) {
+        const auto matches = without_gil([&] {
+            return pystringpp::find_approximate(text, pattern, max_errors, model);
+        });
+        py::list result(matches.size());
+        for (std::size_t i = 0; i < matches.size(); ++i) {
+            result[i] = py::make_tuple(matches[i].end, matches[i].errors);
+        }
+        return result;
+    }, py::arg("text"), py::arg("pattern"), py::arg("max_errors"),
+       py::arg("model") = pystringpp::ErrorModel::Substitutions,
+       "(end, errors) for every end offset where pattern occurs with at most max_errors "
+       "substitutions (or edits); bit-parallel Shift-And");
+    m.def("levenshtein_distance", &pystringpp::levenshtein_distance,
+          "Edit distance using bit-parallel Myers/Hyyro", py::call_guard<py::gil_scoped_release>());
+    m.def("levenshtein_within", &pystringpp::levenshtein_within,
+          "True if the edit distance is at most max_distance (banded, early exit)",
+          py::arg("str1"), py::arg("str2"), py::arg("max_distance"),
+          py::call_guard<py::gil_scoped_release>());
+    m.def("longest_common_subsequence", &pystringpp::longest_common_subsequence,
+          "Longest common subsequence in linear space (Hirschberg)",
+          py::call_guard<py::gil_scoped_release>());
+    m.def("lcs_length", &pystringpp::lcs_length, "LCS length using bit-parallel Allison-Dix",
+          py::call_guard<py::gil_scoped_release>());
+    // Byte-level deduplication can split UTF-8 sequences, so it returns bytes
+    m.def("remove_duplicates", [](std::string_view text) {
+        return py::bytes(without_gil([&] { return pystringpp::remove_duplicates(text); }));
+    }, py::arg("text"), "Distinct bytes in order of first occurrence, as bytes");
+    m.def("remove_duplicates_utf8", &pystringpp::remove_duplicates_utf8,
+          "Distinct code points in order of first occurrence; ValueError on invalid UTF-8",
+          py::arg("text"), py::call_guard<py::gil_scoped_release>());
+    m.def("is_palindrome", &pystringpp::is_palindrome,
+          "True if the ASCII letters and digits read the same backwards, ignoring case",
+          py::arg("text"), py::call_guard<py::gil_scoped_release>());
+    m.def("is_palindrome_utf8", &pystringpp::is_palindrome_utf8,
+          "is_palindrome over Unicode letters and digits with case folding; ValueError on invalid UTF-8",
+          py::arg("text"), py::call_guard<py::gil_scoped_release>());
+    m.def("validate_dna", &pystringpp::validate_dna, "Check a sequence contains only A, T, G, C",
+          py::call_guard<py::gil_scoped_release>());
+    m.def("calculate_gc_content", &pystringpp::calculate_gc_content, "GC content percentage",
+          py::call_guard<py::gil_scoped_release>());
+    m.def("dna_stats", &pystringpp::dna_stats, "Validity and per-base counts in one pass",
+          py::arg("sequence"), py::call_guard<py::gil_scoped_release>());
+    m.def("simd_level", &pystringpp::simd_level, "Name of the active SIMD kernel level");
+    
+    // Batch variants: a sequence of texts, or Arrow-style (data, offsets),
+    // processed in one call with the GIL released; results are numpy arrays
+    m.def("count_char_batch", [](const py::sequence& texts, char c) {
+        const BatchViews batch(texts);
+        return to_numpy(without_gil([&] { return pystringpp::count_char_batch(batch.views(), c); }));
+    }, py::arg("texts"), py::arg("c"), "count_char over every text");
+    m.def("count_char_batch", [](std::string_view data, const Offsets& offsets, char c) {
+        const BatchViews batch(data, offsets);
+        return to_numpy(without_gil([&] { return pystringpp::count_char_batch(batch.views(), c); }));
+    }, py::arg("data"), py::arg("offsets"), py::arg("c"));
+    
+    m.def("find_pattern_batch", [](const py::sequence& texts, std::string_view pattern) {
+        const BatchViews batch(texts);
+        return matches_to_numpy(without_gil([&] { return pystringpp::find_pattern_batch(batch.views(), pattern); }));
+    }, py::arg("texts"), py::arg("pattern"),
+       "find_pattern over every text; returns (offsets, positions) with text i's matches at "
+       "positions[offsets[i]:offsets[i + 1]]");
+    m.def("find_pattern_batch", [](std::string_view data, const Offsets& offsets, std::string_view pattern) {
+        const BatchViews batch(data, offsets);
+        return matches_to_numpy(without_gil([&] { return pystringpp::find_pattern_batch(batch.views(), pattern); }));
+    }, py::arg("data"), py::arg("offsets"), py::arg("pattern"));
+    
+    m.def("is_palindrome_batch", [](const py::sequence& texts) {
+        const BatchViews batch(texts);
+        return to_numpy(without_gil([&] { return pystringpp::is_palindrome_batch(batch.views()); }))
+            .attr("view")(py::dtype::of<bool>());
+    }, py::arg("texts"), "is_palindrome over every text; returns a bool array");
+    m.def("is_palindrome_batch", [](std::string_view data, const Offsets& offsets) {
+        const BatchViews batch(data, offsets);
+        return to_numpy(without_gil([&] { return pystringpp::is_palindrome_batch(batch.views()); }))
+            .attr("view")(py::dtype::of<bool>());
+    }, py::arg("data"), py::arg("offsets"));
+    
+    m.def("gc_content_batch", [](const py::sequence& sequences) {
+        const BatchViews batch(sequences);
+        return to_numpy(without_gil([&] { return pystringpp::gc_content_batch(batch.views()); }));
+    }, py::arg("sequences"), "calculate_gc_content over every sequence");
+    m.def("gc_content_batch", [](std::string_view data, const Offsets& offsets) {
+        const BatchViews batch(data, offsets);
+        return to_numpy(without_gil([&] { return pystringpp::gc_content_batch(batch.views()); }));
+    }, py::arg("data"), py::arg("offsets"));
+    
+    py::class_<pystringpp::DnaStats>(m, "DnaStats", "Result of dna_stats()")
+        .def_readonly("valid", &pystringpp::DnaStats::valid)
+        .def_property_readonly("first_invalid", [](const pystringpp::DnaStats& self) -> py::ssize_t {
+            // -1 when the sequence is valid, like Pattern.find_first()
+            return self.valid ? -1 : static_cast<py::ssize_t>(self.first_invalid);
+        })
+        .def_readonly("length", &pystringpp::DnaStats::length)
+        .def_readonly("a", &pystringpp::DnaStats::a)
+        .def_readonly("c", &pystringpp::DnaStats::c)
+        .def_readonly("g", &pystringpp::DnaStats::g)
+        .def_readonly("t", &pystringpp::DnaStats::t)
+        .def_readonly("n", &pystringpp::DnaStats::n)
+        .def_property_readonly("gc_content", &pystringpp::DnaStats::gc_content)
+        .def("__repr__", [](const pystringpp::DnaStats& self) {
+            return "DnaStats(valid=" + std::string(self.valid ? "True" : "False") +
+                   ", length=" + std::to_string(self.length) +
+                   ", a=" + std::to_string(self.a) + ", c=" + std::to_string(self.c) +
+                   ", g=" + std::to_string(self.g) + ", t=" + std::to_string(self.t) +
+                   ", n=" + std::to_string(self.n) + ")";
+        });
+    
+    // Precompiled single-pattern search
+    py::class_<pystringpp::Pattern> pattern(m, "Pattern",
+        "Precompiled pattern: search algorithm and tables chosen once, reused per search");
+    
+    py::enum_<pystringpp::Pattern::Algorithm>(pattern, "Algorithm")
+        .value("Empty", pystringpp::Pattern::Algorithm::Empty)
+        .value("Memchr", pystringpp::Pattern::Algorithm::Memchr)
+        .value("Prefilter", pystringpp::Pattern::Algorithm::Prefilter)
+        .value("TwoWay", pystringpp::Pattern::Algorithm::TwoWay)
+        .value("CodePoints", pystringpp::Pattern::Algorithm::CodePoints);
+    
+    py::enum_<pystringpp::Pattern::CaseMode>(pattern, "CaseMode")
+        .value("Sensitive", pystringpp::Pattern::CaseMode::Sensitive)
+        .value("AsciiFold", pystringpp::Pattern::CaseMode::AsciiFold)
+        .value("UnicodeFold", pystringpp::Pattern::CaseMode::UnicodeFold);
+    // Also at module level, for find_pattern(text, pattern, case_mode=CaseMode.AsciiFold)
+    m.attr("CaseMode") = pattern.attr("CaseMode");
+    
+    pattern
+        .def(py::init<std::string_view, pystringpp::Pattern::CaseMode>(), py::arg("pattern"),
+             py::arg("case_mode") = pystringpp::Pattern::CaseMode::Sensitive)
+        .def("find_all", py::overload_cast<std::string_view>(&pystringpp::Pattern::find_all, py::const_),
+             "All match offsets in text", py::call_guard<py::gil_scoped_release>())
+        .def("find_first", [](const pystringpp::Pattern& self, std::string_view text) -> py::ssize_t {
+            // Mirror str.find(): -1 when there is no match
+            const std::size_t pos = self.find_first(text);
+            return pos == pystringpp::Pattern::npos ? -1 : static_cast<py::ssize_t>(pos);
+        }, py::arg("text"), "Offset of the first match, or -1", py::call_guard<py::gil_scoped_release>())
+        .def("count", &pystringpp::Pattern::count, "Number of overlapping matches in text",
+             py::call_guard<py::gil_scoped_release>())
+        .def("contains", &pystringpp::Pattern::contains, "True if the pattern occurs in text",
+             py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("pattern", &pystringpp::Pattern::pattern)
+        .def_property_readonly("algorithm", &pystringpp::Pattern::algorithm)
+        .def_property_readonly("case_mode", &pystringpp::Pattern::case_mode);
+    // Defined after Pattern so that the CaseMode default can be converted
+    m.def("find_pattern", &pystringpp::find_pattern, "All (overlapping) match offsets of pattern in text",
+          py::arg("text"), py::arg("pattern"), py::arg("case_mode") = pystringpp::Pattern::CaseMode::Sensitive,
+          py::call_guard<py::gil_scoped_release>());
+    
+    // Stream search; feed() keeps the GIL since the matcher is stateful and
+    // chunks are small
+    py::class_<pystringpp::StreamingMatcher>(m, "StreamingMatcher",
+        "KMP state carried across feed() calls; reports absolute stream offsets")
+        .def(py::init<std::string_view>(), py::arg("pattern"))
+        .def("feed", py::overload_cast<std::string_view>(&pystringpp::StreamingMatcher::feed),
+             py::arg("chunk"), "Absolute offsets of matches ending in this chunk")
+        .def("reset", &pystringpp::StreamingMatcher::reset, "Restart at offset 0")
+        .def_property_readonly("consumed", &pystringpp::StreamingMatcher::consumed)
+        .def_property_readonly("pattern", &pystringpp::StreamingMatcher::pattern);
+    
+    // Multi-pattern search
+    py::class_<pystringpp::AhoCorasick> aho_corasick(m, "AhoCorasick",
+        "Compiled Aho-Corasick automaton: build once, search many texts");
+    
+    py::enum_<pystringpp::AhoCorasick::Mode>(aho_corasick, "Mode")
+        .value("Auto", pystringpp::AhoCorasick::Mode::Auto)
+        .value("Dense", pystringpp::AhoCorasick::Mode::Dense)
+        .value("Compact", pystringpp::AhoCorasick::Mode::Compact);
+    
+    aho_corasick
+        .def(py::init<const std::vector<std::string>&, pystringpp::AhoCorasick::Mode>(),
+             py::arg("patterns"), py::arg("mode") = pystringpp::AhoCorasick::Mode::Auto,
+             py::call_guard<py::gil_scoped_release>())
+        .def("find_all", &pystringpp::AhoCorasick::find_all,
+             "All matches as (pattern_id, offset) pairs sorted by offset",
+             py::call_guard<py::gil_scoped_release>())
+        .def("count", &pystringpp::AhoCorasick::count, "Number of matches in text",
+             py::call_guard<py::gil_scoped_release>())
+        .def("contains", &pystringpp::AhoCorasick::contains, "True if any pattern occurs in text",
+             py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("mode", &pystringpp::AhoCorasick::mode)
+        .def("__len__", &pystringpp::AhoCorasick::pattern_count);
+    
+    // Suffix array index; the arrays are exposed as read-only numpy views
+    // that keep the index alive
+    auto index_array = [](const py::object& self, const std::vector<std::uint32_t>& values) {
+        py::array_t<std::uint32_t> array(static_cast<py::ssize_t>(values.size()), values.data(), self);
+        array.attr("setflags")(py::arg("write") = false);
+        return array;
+    };
+    py::class_<pystringpp::SuffixIndex>(m, "SuffixIndex",
+        "SA-IS suffix array with LCP: index a text once, then locate patterns in O(m log n)")
+        .def(py::init([](std::string_view text, std::size_t threads) {
+            return without_gil([&] { return pystringpp::SuffixIndex(std::string(text), threads); });
+        }), py::arg("text"), py::arg("threads") = 0)
+        .def_static("load", [](const py::object& path) {
+            const auto fspath = py::module_::import("os").attr("fspath")(path).cast<std::string>();
+            return without_gil([&] { return pystringpp::SuffixIndex::load(fspath); });
+        }, py::arg("path"), "Read an index written by save()")
+        .def("save", [](const pystringpp::SuffixIndex& self, const py::object& path) {
+            const auto fspath = py::module_::import("os").attr("fspath")(path).cast<std::string>();
+            without_gil([&] { self.save(fspath); });
+        }, py::arg("path"), "Write the text, suffix array and LCP array to path")
+        .def("locate", &pystringpp::SuffixIndex::locate, py::arg("pattern"),
+             "All (overlapping) match offsets of pattern, ascending",
+             py::call_guard<py::gil_scoped_release>())
+        .def("count", &pystringpp::SuffixIndex::count, py::arg("pattern"), "Number of matches of pattern",
+             py::call_guard<py::gil_scoped_release>())
+        .def("contains", &pystringpp::SuffixIndex::contains, py::arg("pattern"), "True if pattern occurs",
+             py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("suffix_array", [index_array](const py::object& self) {
+            return index_array(self, self.cast<const pystringpp::SuffixIndex&>().suffix_array());
+        })
+        .def_property_readonly("lcp", [index_array](const py::object& self) {
+            return index_array(self, self.cast<const pystringpp::SuffixIndex&>().lcp());
+        })
+        .def("__len__", &pystringpp::SuffixIndex::size);
+    
+    // Streaming FASTA/FASTQ; only copying records into Python objects needs the GIL
+    py::class_<SequenceRecordCopy>(m, "SequenceRecord", "One FASTA/FASTQ record")
+        .def_readonly("name", &SequenceRecordCopy::name)
+        .def_readonly("sequence", &SequenceRecordCopy::sequence)
+        .def_readonly("quality", &SequenceRecordCopy::quality)
+        .def_readonly("stats", &SequenceRecordCopy::stats)
+        .def("__repr__", [](const SequenceRecordCopy& self) {
+            return "SequenceRecord(name=" + py::repr(self.name).cast<std::string>() +
+                   ", length=" + std::to_string(self.stats.length) + ")";
+        });
+    
+    py::class_<LockedSequenceReader> sequence_reader(m, "SequenceReader",
+        "Streaming FASTA/FASTQ parser (gzip if built with zlib); iterate for records");
+    
+    py::enum_<pystringpp::SequenceReader::Format>(sequence_reader, "Format")
+        .value("Auto", pystringpp::SequenceReader::Format::Auto)
+        .value("Fasta", pystringpp::SequenceReader::Format::Fasta)
+        .value("Fastq", pystringpp::SequenceReader::Format::Fastq);
+    
+    sequence_reader
+        .def(py::init([](const py::object& path, pystringpp::SequenceReader::Format format,
+                         std::size_t buffer_size) {
+            // Accept str, bytes and os.PathLike
+            const auto fspath = py::module_::import("os").attr("fspath")(path).cast<std::string>();
+            return std::make_unique<LockedSequenceReader>(fspath, format, buffer_size);
+        }), py::arg("path"), py::arg("format") = pystringpp::SequenceReader::Format::Auto,
+            py::arg("buffer_size") = std::size_t(1) << 20)
+        .def("__iter__", [](LockedSequenceReader& self) -> LockedSequenceReader& { return self; })
+        .def("__next__", [](LockedSequenceReader& self) {
+            pystringpp::SequenceRecord record;
+            std::unique_lock<std::mutex> lock(self.mutex, std::defer_lock);
+            const bool found = without_gil([&] {
+                lock.lock();
+                return self.reader.next(record);
+            });
+            if (!found) {
+                throw py::stop_iteration();
+            }
+            // Still locked, so the views cannot be overwritten while copying
+            return SequenceRecordCopy{
+                decode_field(record.name),
+                decode_field(record.sequence),
+                decode_field(record.quality),
+                record.stats};
+        })
+        .def("scan", [](LockedSequenceReader& self) {
+            return without_gil([&] {
+                std::lock_guard<std::mutex> lock(self.mutex);
+                pystringpp::SequenceRecord record;
+                while (self.reader.next(record)) {
+                }
+                return self.reader.totals();
+            });
+        }, "Consume the remaining records without creating Python objects; returns totals")
+        .def_property_readonly("format", [](LockedSequenceReader& self) {
+            return without_gil([&] {
+                std::lock_guard<std::mutex> lock(self.mutex);
+                return self.reader.format();
+            });
+        })
+        .def_property_readonly("records", [](LockedSequenceReader& self) {
+            return without_gil([&] {
+                std::lock_guard<std::mutex> lock(self.mutex);
+                return self.reader.records();
+            });
+        }, "Number of records read so far")
+        .def_property_readonly("totals", [](LockedSequenceReader& self) {
+            return without_gil([&] {
+                std::lock_guard<std::mutex> lock(self.mutex);
+                return self.reader.totals();
+            });
+        }, "DnaStats over every record read so far");
+    
+    // Resolve the SIMD dispatch table at import rather than on the first call
+    pystringpp::simd_level();
     
     m.attr("__version__") = "0.1.0";
 }
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+/**
+ * @file internal.h
+ * @brief Internal algorithm variants behind the public API
+ *
+ * Not part of the public API. The functions in pystringpp.h dispatch between
+ * the variants declared here; the simple reference implementations are kept
+ * alongside so every fast path can be checked against them.
+ */
+
+namespace pystringpp {
+namespace detail {
+
+    // Levenshtein distance variants; all return identical results
+    std::size_t levenshtein_two_row(std::string_view str1, std::string_view str2);
+    std::size_t levenshtein_myers64(std::string_view pattern, std::string_view text);
+    std::size_t levenshtein_myers_blocked(std::string_view pattern, std::string_view text);
+
+} // namespace detail
+} // namespace pystringpp
@@ -1,197 +1,1475 @@
 #include "pystringpp.h"
+#include "internal.h"
+#include "unicode.h"
+#include "simd.h"
+#include "thread_pool.h"
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <stdexcept>
 #include <algorithm>
+#include <array>
+#include <bitset>
 #include <vector>
-#include <cctype>
+#include <cstdint>
+#include <cstring>
 #include <numeric>
+#include <utility>
 
 namespace pystringpp {
 
-std::string reverse_string(const std::string& input) {
-    // Handle empty string edge case
-    if (input.empty()) {
-        return input;
+namespace {
+
+[[noreturn]] void throw_invalid_utf8(const char* function, std::size_t offset) {
+    throw std::invalid_argument(std::string(function) + ": invalid UTF-8 at byte offset " + std::to_string(offset));
+}
+
+// Writes the input into the result unit by unit from the back, keeping the
+// bytes of each code point (or grapheme cluster) in order. Runs of ASCII are
+// found with the SIMD ASCII-prefix kernel and, being one byte per unit,
+// reversed with the byte kernel in one call; only the non-ASCII units are
+// decoded. In grapheme mode CR LF and the last byte of a run (which a
+// following mark may extend) go through the cluster rules instead.
+std::string reverse_utf8_units(std::string_view input, bool graphemes, const char* function) {
+    const detail::Kernels& kernels = detail::kernels();
+    const char* data = input.data();
+    const std::size_t size = input.size();
+    std::string result(size, '\0');
+    char* out = result.data() + size;
+    std::size_t i = 0;
+
+    auto reverse_bytes = [&](std::size_t count) {
+        out -= count;
+        kernels.reverse_copy(data + i, count, out);
+        i += count;
+    };
+    auto copy_unit = [&] {
+        std::size_t length;
+        if (graphemes) {
+            length = detail::grapheme_cluster_length(data + i, size - i);
+        } else {
+            char32_t codepoint;
+            length = detail::decode_utf8(data + i, size - i, codepoint);
+        }
+        if (length == 0) {
+            throw_invalid_utf8(function, i);
+        }
+        out -= length;
+        std::memcpy(out, data + i, length);
+        i += length;
+    };
+
+    while (i < size) {
+        const std::size_t run_end = i + kernels.ascii_prefix(data + i, size - i);
+        if (!graphemes) {
+            reverse_bytes(run_end - i);
+        } else if (run_end > i) {
+            const std::size_t last = run_end - 1;
+            while (i < last) {
+                const void* cr = std::memchr(data + i, '\r', last - i);
+                if (cr == nullptr) {
+                    reverse_bytes(last - i);
+                    break;
+                }
+                reverse_bytes(static_cast<std::size_t>(static_cast<const char*>(cr) - (data + i)));
+                copy_unit();
+            }
+            if (i == last) {
+                copy_unit();
+            }
+        }
+        while (i < size && static_cast<unsigned char>(data[i]) >= 0x80) {
+            copy_unit();
+        }
     }
-    
-    // Use move semantics for optimal performance
-    std::string result = input;
-    std::reverse(result.begin(), result.end());
     return result;
 }
 
-std::unordered_map<char, int> count_chars(const std::string& input) {
+} // namespace
+
+std::string reverse_string(std::string_view input) {
+    std::string result(input.size(), '\0');
+    detail::kernels().reverse_copy(input.data(), input.size(), result.data());
+    return result;
+}
+
+void reverse_inplace(char* data, std::size_t size) {
+    detail::kernels().reverse_inplace(data, size);
+}
+
+void reverse_inplace(std::string& text) {
+    reverse_inplace(text.data(), text.size());
+}
+
+std::string reverse_utf8(std::string_view input) {
+    return reverse_utf8_units(input, false, "reverse_utf8");
+}
+
+std::string reverse_graphemes(std::string_view input) {
+    return reverse_utf8_units(input, true, "reverse_graphemes");
+}
+
+namespace {
+
+// Byte histogram: consecutive bytes go to different count tables, so a run
+// of one byte value does not serialize on a single counter's load/store
+// (store-to-load forwarding) chain; eight tables keep low-entropy input such
+// as DNA at full speed. Tables use 32-bit counters to fit in 8 KiB of L1,
+// and blocks are small enough that none can overflow.
+constexpr std::size_t kHistogramTables = 8;
+constexpr std::size_t kHistogramBlock = std::size_t(1) << 30;
+constexpr std::size_t kHistogramMinTableSize = 256;
+
+PYSTRINGPP_MULTIVERSION
+void histogram_block(const unsigned char* data, std::size_t size, std::uint64_t* counts) {
+    std::uint32_t tables[kHistogramTables][256] = {};
+    std::size_t i = 0;
+    // One 8-byte load feeds one increment per table
+    for (; i + 8 <= size; i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        for (std::size_t k = 0; k < 8; ++k) {
+            ++tables[k][(word >> (8 * k)) & 0xff];
+        }
+    }
+    for (; i < size; ++i) {
+        ++tables[0][data[i]];
+    }
+    for (std::size_t b = 0; b < 256; ++b) {
+        for (std::size_t t = 0; t < kHistogramTables; ++t) {
+            counts[b] += tables[t][b];
+        }
+    }
+}
+
+} // namespace
+
+std::array<std::uint64_t, 256> byte_histogram(std::string_view input) {
+    std::array<std::uint64_t, 256> counts{};
+    const auto* data = reinterpret_cast<const unsigned char*>(input.data());
+    
+    // Clearing and merging the tables costs more than it saves on short input
+    if (input.size() < kHistogramMinTableSize) {
+        for (unsigned char c : input) {
+            ++counts[c];
+        }
+        return counts;
+    }
+    for (std::size_t offset = 0; offset < input.size(); offset += kHistogramBlock) {
+        histogram_block(data + offset, std::min(kHistogramBlock, input.size() - offset), counts.data());
+    }
+    return counts;
+}
+
+std::unordered_map<char, int> count_chars(std::string_view input) {
+    const std::array<std::uint64_t, 256> histogram = byte_histogram(input);
     std::unordered_map<char, int> counts;
-    for (char c : input) {
-        counts[c]++;
+    for (std::size_t b = 0; b < 256; ++b) {
+        if (histogram[b] != 0) {
+            counts.emplace(static_cast<char>(b), static_cast<int>(histogram[b]));
+        }
     }
     return counts;
 }
 
-std::string remove_duplicates(const std::string& input) {
+std::string remove_duplicates(std::string_view input) {
+    // At most 256 distinct bytes, so the result never reallocates
     std::string result;
-    std::unordered_map<char, bool> seen;
+    result.reserve(std::min<std::size_t>(input.size(), 256));
     
+    std::uint64_t seen[4] = {0, 0, 0, 0};
     for (char c : input) {
-        if (seen.find(c) == seen.end()) {
-            seen[c] = true;
-            result += c;
+        const auto byte = static_cast<unsigned char>(c);
+        const std::uint64_t bit = std::uint64_t(1) << (byte & 63);
+        if ((seen[byte >> 6] & bit) == 0) {
+            seen[byte >> 6] |= bit;
+            result.push_back(c);
+            // Every byte value has been seen: nothing later can be new
+            if (result.size() == 256) {
+                break;
+            }
         }
     }
     return result;
 }
 
-bool is_palindrome(const std::string& input) {
-    std::string cleaned;
-    for (char c : input) {
-        if (std::isalnum(c)) {
-            cleaned += std::tolower(c);
+std::string remove_duplicates_utf8(std::string_view input) {
+    std::string result;
+    std::uint64_t ascii_seen[2] = {0, 0};
+    std::unordered_set<char32_t> seen;
+    
+    std::size_t i = 0;
+    while (i < input.size()) {
+        const auto lead = static_cast<unsigned char>(input[i]);
+        if (lead < 0x80) {
+            const std::uint64_t bit = std::uint64_t(1) << (lead & 63);
+            if ((ascii_seen[lead >> 6] & bit) == 0) {
+                ascii_seen[lead >> 6] |= bit;
+                result.push_back(input[i]);
+            }
+            ++i;
+            continue;
         }
+        
+        char32_t codepoint;
+        const std::size_t length = detail::decode_utf8(input.data() + i, input.size() - i, codepoint);
+        if (length == 0) {
+            throw_invalid_utf8("remove_duplicates_utf8", i);
+        }
+        if (seen.insert(codepoint).second) {
+            result.append(input.data() + i, length);
+        }
+        i += length;
+    }
+    return result;
+}
+
+namespace {
+
+// is_palindrome() byte classes: 0 for bytes that are skipped, otherwise the
+// byte itself lowercased. ASCII only, so independent of the C locale.
+constexpr std::array<char, 256> make_palindrome_fold() {
+    std::array<char, 256> fold{};
+    for (int c = '0'; c <= '9'; ++c) {
+        fold[c] = static_cast<char>(c);
+    }
+    for (int c = 'a'; c <= 'z'; ++c) {
+        fold[c] = static_cast<char>(c);
+        fold[c - 'a' + 'A'] = static_cast<char>(c);
+    }
+    return fold;
+}
+
+constexpr std::array<char, 256> kPalindromeFold = make_palindrome_fold();
+
+// A letter or digit plus the combining marks attached to it: bytes
+// [begin, end) of the text, with the marks starting at `marks`
+struct Cluster {
+    std::size_t begin;
+    std::size_t marks;
+    std::size_t end;
+    char32_t base;
+};
+
+// First cluster in text[pos, limit), skipping everything that is not a
+// letter or digit (including marks with no such base); false if none
+bool next_cluster(std::string_view text, std::size_t pos, std::size_t limit, Cluster& cluster) {
+    while (pos < limit) {
+        char32_t codepoint;
+        const std::size_t length = detail::decode_utf8(text.data() + pos, limit - pos, codepoint);
+        if (length == 0) {
+            throw_invalid_utf8("is_palindrome_utf8", pos);
+        }
+        if (!detail::is_alnum(codepoint) || detail::is_combining_mark(codepoint)) {
+            pos += length;
+            continue;
+        }
+        cluster.begin = pos;
+        cluster.marks = pos + length;
+        cluster.base = codepoint;
+        std::size_t end = cluster.marks;
+        while (end < limit) {
+            char32_t mark;
+            const std::size_t mark_length = detail::decode_utf8(text.data() + end, limit - end, mark);
+            if (mark_length == 0) {
+                throw_invalid_utf8("is_palindrome_utf8", end);
+            }
+            if (!detail::is_combining_mark(mark)) {
+                break;
+            }
+            end += mark_length;
+        }
+        cluster.end = end;
+        return true;
+    }
+    return false;
+}
+
+// Last cluster in text[limit, pos), mirroring next_cluster()
+bool previous_cluster(std::string_view text, std::size_t limit, std::size_t pos, Cluster& cluster) {
+    while (pos > limit) {
+        // Trailing marks belong to the base character before them
+        const std::size_t end = pos;
+        char32_t codepoint = 0;
+        std::size_t length = 0;
+        while (pos > limit) {
+            length = detail::decode_utf8_before(text.data() + limit, pos - limit, codepoint);
+            if (length == 0) {
+                throw_invalid_utf8("is_palindrome_utf8", pos - 1);
+            }
+            if (!detail::is_combining_mark(codepoint)) {
+                break;
+            }
+            pos -= length;
+        }
+        if (pos == limit) {
+            return false;
+        }
+        const std::size_t begin = pos - length;
+        if (detail::is_alnum(codepoint)) {
+            cluster.begin = begin;
+            cluster.marks = pos;
+            cluster.end = end;
+            cluster.base = codepoint;
+            return true;
+        }
+        pos = begin;
+    }
+    return false;
+}
+
+} // namespace
+
+bool is_palindrome(std::string_view input) {
+    if (input.empty()) {
+        return true;
     }
     
-    std::string reversed = cleaned;
-    std::reverse(reversed.begin(), reversed.end());
-    return cleaned == reversed;
+    // Two pointers moving inwards, skipping non-alphanumeric bytes in place
+    const char* front = input.data();
+    const char* back = input.data() + input.size() - 1;
+    while (front < back) {
+        const char head = kPalindromeFold[static_cast<unsigned char>(*front)];
+        if (head == 0) {
+            ++front;
+            continue;
+        }
+        const char tail = kPalindromeFold[static_cast<unsigned char>(*back)];
+        if (tail == 0) {
+            --back;
+            continue;
+        }
+        if (head != tail) {
+            return false;
+        }
+        ++front;
+        --back;
+    }
+    return true;
 }
 
-std::string longest_common_subsequence(const std::string& str1, const std::string& str2) {
-    int m = str1.length();
-    int n = str2.length();
+bool is_palindrome_utf8(std::string_view input) {
+    std::size_t front = 0;
+    std::size_t back = input.size();
+    for (;;) {
+        // ASCII fast path. Combining marks are never ASCII, so an ASCII byte
+        // followed by another is a whole character, as is a final ASCII byte.
+        while (front < back) {
+            const auto first = static_cast<unsigned char>(input[front]);
+            if (first >= 0x80 || (front + 1 < back && static_cast<unsigned char>(input[front + 1]) >= 0x80)) {
+                break;
+            }
+            const char head = kPalindromeFold[first];
+            if (head == 0) {
+                ++front;
+                continue;
+            }
+            const auto last = static_cast<unsigned char>(input[back - 1]);
+            if (last >= 0x80) {
+                break;
+            }
+            const char tail = kPalindromeFold[last];
+            if (tail == 0) {
+                --back;
+                continue;
+            }
+            if (head != tail) {
+                return false;
+            }
+            ++front;
+            --back;
+        }
+        
+        Cluster head;
+        Cluster tail;
+        if (!next_cluster(input, front, back, head) || !previous_cluster(input, front, back, tail) ||
+            head.begin >= tail.begin) {
+            return true;
+        }
+        if (detail::simple_casefold(head.base) != detail::simple_casefold(tail.base) ||
+            input.substr(head.marks, head.end - head.marks) != input.substr(tail.marks, tail.end - tail.marks)) {
+            return false;
+        }
+        front = head.end;
+        back = tail.begin;
+    }
+}
+
+namespace {
+
+std::size_t popcount64(std::uint64_t x) {
+    return std::bitset<64>(x).count();
+}
+
+// row[j] = LCS length of a and b[0, j), for j = 0..n
+PYSTRINGPP_MULTIVERSION
+void lcs_row_forward(std::string_view a, std::string_view b, std::vector<std::size_t>& row) {
+    std::fill(row.begin(), row.begin() + b.length() + 1, 0);
+    for (char c : a) {
+        std::size_t diagonal = 0;
+        for (std::size_t j = 1; j <= b.length(); ++j) {
+            const std::size_t above = row[j];
+            row[j] = c == b[j-1] ? diagonal + 1 : std::max(above, row[j-1]);
+            diagonal = above;
+        }
+    }
+}
+
+// row[j] = LCS length of a and the last j bytes of b, for j = 0..n
+PYSTRINGPP_MULTIVERSION
+void lcs_row_backward(std::string_view a, std::string_view b, std::vector<std::size_t>& row) {
+    const std::size_t n = b.length();
+    std::fill(row.begin(), row.begin() + n + 1, 0);
+    for (auto it = a.rbegin(); it != a.rend(); ++it) {
+        std::size_t diagonal = 0;
+        for (std::size_t j = 1; j <= n; ++j) {
+            const std::size_t above = row[j];
+            row[j] = *it == b[n-j] ? diagonal + 1 : std::max(above, row[j-1]);
+            diagonal = above;
+        }
+    }
+}
+
+// Appends an LCS of a and b to out; forward/backward are scratch rows sized
+// for the longest b seen at the top level
+void hirschberg(std::string_view a, std::string_view b, std::vector<std::size_t>& forward,
+                std::vector<std::size_t>& backward, std::string& out) {
+    // Common prefixes and suffixes are always part of some LCS
+    std::size_t prefix = 0;
+    while (prefix < a.length() && prefix < b.length() && a[prefix] == b[prefix]) {
+        ++prefix;
+    }
+    out.append(a.substr(0, prefix));
+    a.remove_prefix(prefix);
+    b.remove_prefix(prefix);
     
-    std::vector<std::vector<int>> dp(m + 1, std::vector<int>(n + 1, 0));
+    std::size_t suffix = 0;
+    while (suffix < a.length() && suffix < b.length() &&
+           a[a.length() - 1 - suffix] == b[b.length() - 1 - suffix]) {
+        ++suffix;
+    }
+    const std::string_view common_suffix = a.substr(a.length() - suffix);
+    a.remove_suffix(suffix);
+    b.remove_suffix(suffix);
     
-    for (int i = 1; i <= m; i++) {
-        for (int j = 1; j <= n; j++) {
-            if (str1[i-1] == str2[j-1]) {
-                dp[i][j] = dp[i-1][j-1] + 1;
-            } else {
-                dp[i][j] = std::max(dp[i-1][j], dp[i][j-1]);
+    if (a.length() == 1) {
+        if (b.find(a[0]) != std::string_view::npos) {
+            out.push_back(a[0]);
+        }
+    } else if (!a.empty() && !b.empty()) {
+        const std::size_t mid = a.length() / 2;
+        lcs_row_forward(a.substr(0, mid), b, forward);
+        lcs_row_backward(a.substr(mid), b, backward);
+        
+        // Split b where LCS(first half, b[0, k)) + LCS(second half, b[k, n)) peaks
+        std::size_t split = 0;
+        std::size_t best = 0;
+        for (std::size_t k = 0; k <= b.length(); ++k) {
+            const std::size_t total = forward[k] + backward[b.length() - k];
+            if (total > best) {
+                best = total;
+                split = k;
             }
         }
+        
+        hirschberg(a.substr(0, mid), b.substr(0, split), forward, backward, out);
+        hirschberg(a.substr(mid), b.substr(split), forward, backward, out);
     }
     
-    std::string result;
-    int i = m, j = n;
-    while (i > 0 && j > 0) {
-        if (str1[i-1] == str2[j-1]) {
-            result = str1[i-1] + result;
-            i--;
-            j--;
-        } else if (dp[i-1][j] > dp[i][j-1]) {
-            i--;
-        } else {
-            j--;
-        }
+    out.append(common_suffix);
+}
+
+} // namespace
+
+std::string longest_common_subsequence(std::string_view str1, std::string_view str2) {
+    // Keep the DP rows as short as possible
+    if (str2.length() > str1.length()) {
+        std::swap(str1, str2);
     }
     
+    std::string result;
+    result.reserve(lcs_length(str1, str2));
+    
+    std::vector<std::size_t> forward(str2.length() + 1);
+    std::vector<std::size_t> backward(str2.length() + 1);
+    hirschberg(str1, str2, forward, backward, result);
     return result;
 }
 
-int levenshtein_distance(const std::string& str1, const std::string& str2) {
-    int m = str1.length();
-    int n = str2.length();
+PYSTRINGPP_MULTIVERSION
+std::size_t lcs_length(std::string_view str1, std::string_view str2) {
+    // Pack the shorter string into the bit vectors
+    if (str1.length() > str2.length()) {
+        std::swap(str1, str2);
+    }
+    const std::size_t m = str1.length();
+    if (m == 0) {
+        return 0;
+    }
+    const std::size_t words = (m + 63) / 64;
+    
+    std::vector<std::uint64_t> match(256 * words, 0);
+    for (std::size_t i = 0; i < m; ++i) {
+        match[static_cast<unsigned char>(str1[i]) * words + i / 64] |= std::uint64_t(1) << (i % 64);
+    }
+    
+    // Zero bits of v mark the rows where the LCS length steps up
+    std::vector<std::uint64_t> v(words, ~std::uint64_t(0));
+    for (char c : str2) {
+        const std::uint64_t* mask = &match[static_cast<unsigned char>(c) * words];
+        std::uint64_t carry = 0;
+        for (std::size_t w = 0; w < words; ++w) {
+            const std::uint64_t u = v[w] & mask[w];
+            const std::uint64_t partial = v[w] + u;
+            const std::uint64_t sum = partial + carry;
+            carry = (partial < v[w] || sum < partial) ? 1 : 0;
+            v[w] = sum | (v[w] - u);
+        }
+    }
+    
+    std::size_t ones = 0;
+    for (std::size_t w = 0; w + 1 < words; ++w) {
+        ones += popcount64(v[w]);
+    }
+    const std::size_t tail_bits = m - (words - 1) * 64;
+    const std::uint64_t tail_mask = tail_bits == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << tail_bits) - 1;
+    ones += popcount64(v[words - 1] & tail_mask);
     
-    std::vector<std::vector<int>> dp(m + 1, std::vector<int>(n + 1));
+    return m - ones;
+}
+
+namespace detail {
+
+std::size_t levenshtein_two_row(std::string_view str1, std::string_view str2) {
+    // Classic DP keeping only the previous and current rows
+    if (str1.length() < str2.length()) {
+        std::swap(str1, str2);
+    }
+    const std::size_t n = str2.length();
     
-    for (int i = 0; i <= m; i++) dp[i][0] = i;
-    for (int j = 0; j <= n; j++) dp[0][j] = j;
+    std::vector<std::size_t> prev(n + 1);
+    std::vector<std::size_t> curr(n + 1);
+    for (std::size_t j = 0; j <= n; ++j) {
+        prev[j] = j;
+    }
     
-    for (int i = 1; i <= m; i++) {
-        for (int j = 1; j <= n; j++) {
+    for (std::size_t i = 1; i <= str1.length(); ++i) {
+        curr[0] = i;
+        for (std::size_t j = 1; j <= n; ++j) {
             if (str1[i-1] == str2[j-1]) {
-                dp[i][j] = dp[i-1][j-1];
+                curr[j] = prev[j-1];
             } else {
-                dp[i][j] = 1 + std::min({dp[i-1][j], dp[i][j-1], dp[i-1][j-1]});
+                curr[j] = 1 + std::min({prev[j], curr[j-1], prev[j-1]});
             }
         }
+        std::swap(prev, curr);
+    }
+    
+    return prev[n];
+}
+
+PYSTRINGPP_MULTIVERSION
+std::size_t levenshtein_myers64(std::string_view pattern, std::string_view text) {
+    // Bit i of peq[c] is set when pattern[i] == c
+    std::uint64_t peq[256] = {};
+    for (std::size_t i = 0; i < pattern.length(); ++i) {
+        peq[static_cast<unsigned char>(pattern[i])] |= std::uint64_t(1) << i;
+    }
+    
+    // Pv/Mv encode the +1/-1 vertical deltas of the current DP column
+    const std::uint64_t last = std::uint64_t(1) << (pattern.length() - 1);
+    std::uint64_t pv = ~std::uint64_t(0);
+    std::uint64_t mv = 0;
+    std::size_t score = pattern.length();
+    
+    for (char c : text) {
+        const std::uint64_t eq = peq[static_cast<unsigned char>(c)];
+        const std::uint64_t xv = eq | mv;
+        const std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        std::uint64_t ph = mv | ~(xh | pv);
+        std::uint64_t mh = pv & xh;
+        
+        if (ph & last) {
+            ++score;
+        } else if (mh & last) {
+            --score;
+        }
+        
+        // Row 0 of the global DP grows by one per column: shift in a +1
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+    }
+    
+    return score;
+}
+
+PYSTRINGPP_MULTIVERSION
+std::size_t levenshtein_myers_blocked(std::string_view pattern, std::string_view text) {
+    const std::size_t m = pattern.length();
+    const std::size_t blocks = (m + 63) / 64;
+    
+    std::vector<std::uint64_t> peq(256 * blocks, 0);
+    for (std::size_t i = 0; i < m; ++i) {
+        peq[static_cast<unsigned char>(pattern[i]) * blocks + i / 64] |= std::uint64_t(1) << (i % 64);
+    }
+    
+    std::vector<std::uint64_t> pv(blocks, ~std::uint64_t(0));
+    std::vector<std::uint64_t> mv(blocks, 0);
+    const std::uint64_t high = std::uint64_t(1) << 63;
+    const std::uint64_t last = std::uint64_t(1) << ((m - 1) % 64);
+    std::size_t score = m;
+    
+    for (char c : text) {
+        const std::uint64_t* eq_column = &peq[static_cast<unsigned char>(c) * blocks];
+        
+        // Horizontal delta entering the bottom of block b from block b - 1;
+        // row 0 always contributes +1
+        int hin = 1;
+        for (std::size_t b = 0; b < blocks; ++b) {
+            std::uint64_t eq = eq_column[b];
+            const std::uint64_t hin_negative = hin < 0 ? 1 : 0;
+            const std::uint64_t xv = eq | mv[b];
+            eq |= hin_negative;
+            const std::uint64_t xh = (((eq & pv[b]) + pv[b]) ^ pv[b]) | eq;
+            std::uint64_t ph = mv[b] | ~(xh | pv[b]);
+            std::uint64_t mh = pv[b] & xh;
+            
+            const std::uint64_t out_bit = b + 1 == blocks ? last : high;
+            const int hout = (ph & out_bit) ? 1 : ((mh & out_bit) ? -1 : 0);
+            
+            ph = (ph << 1) | (hin > 0 ? 1 : 0);
+            mh = (mh << 1) | hin_negative;
+            pv[b] = mh | ~(xv | ph);
+            mv[b] = ph & xv;
+            hin = hout;
+        }
+        
+        if (hin > 0) {
+            ++score;
+        } else if (hin < 0) {
+            --score;
+        }
+    }
+    
+    return score;
+}
+
+} // namespace detail
+
+std::size_t levenshtein_distance(std::string_view str1, std::string_view str2) {
+    // Common prefixes and suffixes never change the distance
+    while (!str1.empty() && !str2.empty() && str1.front() == str2.front()) {
+        str1.remove_prefix(1);
+        str2.remove_prefix(1);
+    }
+    while (!str1.empty() && !str2.empty() && str1.back() == str2.back()) {
+        str1.remove_suffix(1);
+        str2.remove_suffix(1);
+    }
+    
+    // Use the shorter string as the bit-parallel pattern
+    if (str1.length() > str2.length()) {
+        std::swap(str1, str2);
+    }
+    if (str1.empty()) {
+        return str2.length();
+    }
+    if (str1.length() <= 64) {
+        return detail::levenshtein_myers64(str1, str2);
+    }
+    return detail::levenshtein_myers_blocked(str1, str2);
+}
+
+bool levenshtein_within(std::string_view str1, std::string_view str2, std::size_t max_distance) {
+    const std::size_t k = max_distance;
+    
+    // Common prefixes and suffixes never change the distance
+    while (!str1.empty() && !str2.empty() && str1.front() == str2.front()) {
+        str1.remove_prefix(1);
+        str2.remove_prefix(1);
+    }
+    while (!str1.empty() && !str2.empty() && str1.back() == str2.back()) {
+        str1.remove_suffix(1);
+        str2.remove_suffix(1);
+    }
+    
+    if (str1.length() > str2.length()) {
+        std::swap(str1, str2);
+    }
+    const std::size_t m = str1.length();
+    const std::size_t n = str2.length();
+    
+    // Every alignment needs at least n - m insertions
+    if (n - m > k) {
+        return false;
+    }
+    if (m == 0) {
+        return true;
+    }
+    
+    // A band at least as wide as the bit-parallel pass gains nothing
+    if (2 * k + 1 >= ((m + 63) / 64) * 64) {
+        return levenshtein_distance(str1, str2) <= k;
+    }
+    
+    // Banded DP over rows i of str1 and columns j of str2, with values capped
+    // at k + 1. Only cells with |i - j| <= k can lie on a path of cost <= k.
+    const std::size_t inf = k + 1;
+    std::vector<std::size_t> prev(n + 2, inf);
+    std::vector<std::size_t> curr(n + 2, inf);
+    for (std::size_t j = 0; j <= std::min(n, k); ++j) {
+        prev[j] = j;
+    }
+    
+    for (std::size_t i = 1; i <= m; ++i) {
+        const std::size_t lo = i > k ? i - k : 0;
+        const std::size_t hi = std::min(n, i + k);
+        
+        // Cells just outside the band must read as unreachable
+        if (lo > 0) {
+            curr[lo - 1] = inf;
+        } else {
+            curr[0] = std::min(i, inf);
+        }
+        curr[hi + 1] = inf;
+        
+        // Ukkonen's cutoff: a cell still needs at least |remaining length
+        // difference| edits to reach the end, so stop once none can make it
+        std::size_t best = lo == 0 ? curr[0] + (n - m + i) : inf;
+        for (std::size_t j = std::max<std::size_t>(lo, 1); j <= hi; ++j) {
+            const std::size_t substitute = prev[j-1] + (str1[i-1] != str2[j-1] ? 1 : 0);
+            const std::size_t value = std::min({substitute, prev[j] + 1, curr[j-1] + 1, inf});
+            curr[j] = value;
+            
+            const std::size_t remaining_rows = m - i;
+            const std::size_t remaining_cols = n - j;
+            const std::size_t gap = remaining_rows > remaining_cols ? remaining_rows - remaining_cols
+                                                                    : remaining_cols - remaining_rows;
+            best = std::min(best, value + gap);
+        }
+        if (best > k) {
+            return false;
+        }
+        
+        std::swap(prev, curr);
     }
     
-    return dp[m][n];
+    return prev[n] <= k;
 }
 
-int count_char(const std::string& input, char c) {
+std::size_t count_char(std::string_view input, char c) {
     // Handle empty string edge case
     if (input.empty()) {
         return 0;
     }
     
-    // Use std::count for optimal performance - it's highly optimized
-    return static_cast<int>(std::count(input.begin(), input.end(), c));
+    // Dispatch to the widest byte-count kernel this CPU supports
+    return detail::kernels().count_byte(input.data(), input.size(), c);
+}
+
+const char* simd_level() {
+    return detail::simd_level_name(detail::kernels().level);
+}
+
+namespace {
+
+// Rough frequency rank of a byte in typical text and log data: lower means
+// rarer. Used to pick the bytes a Pattern prefilters on.
+constexpr int byte_frequency_rank(unsigned char c) {
+    if (c == ' ' || c == 'e' || c == 't' || c == 'a' || c == 'o' || c == 'i' ||
+        c == 'n' || c == 's' || c == 'r' || c == 'h' || c == 'l' || c == 'd') {
+        return 6;
+    }
+    if (c >= 'a' && c <= 'z') {
+        return 5;
+    }
+    if ((c >= '0' && c <= '9') || c == '\n' || c == '\0' || c == 0xFF) {
+        return 4;
+    }
+    if (c >= 'A' && c <= 'Z') {
+        return 3;
+    }
+    if (c >= 0x21 && c <= 0x7E) {
+        return 2; // punctuation
+    }
+    return 1; // other control bytes and non-ASCII
+}
+
+// Needles at least this long are searched with Two-Way rather than the
+// prefilter, whose verification cost grows with the needle
+constexpr std::size_t kTwoWayMinLength = 32;
+
+// The prefilter hands over to KMP once false positives exceed this many plus
+// one per 16 bytes searched, keeping total verification work O(n)
+constexpr std::size_t kPrefilterSlack = 64;
+constexpr unsigned kPrefilterBytesPerMiss = 4; // log2(16)
+
+// Maximal suffix of needle under one byte ordering (or its reverse), as
+// (start, period of that suffix); building block of the critical
+// factorization. max_suffix starts at "-1" and relies on unsigned wraparound.
+std::pair<std::size_t, std::size_t> maximal_suffix(std::string_view needle, bool reversed) {
+    std::size_t max_suffix = static_cast<std::size_t>(-1);
+    std::size_t j = 0;
+    std::size_t k = 1;
+    std::size_t p = 1;
+    while (j + k < needle.size()) {
+        const auto a = static_cast<unsigned char>(needle[j + k]);
+        const auto b = static_cast<unsigned char>(needle[max_suffix + k]);
+        if (reversed ? b < a : a < b) {
+            j += k;
+            k = 1;
+            p = j - max_suffix;
+        } else if (a == b) {
+            if (k != p) {
+                ++k;
+            } else {
+                j += p;
+                k = 1;
+            }
+        } else {
+            max_suffix = j++;
+            k = p = 1;
+        }
+    }
+    return {max_suffix + 1, p};
+}
+
+// KMP failure function: failure[i] is the length of the longest proper
+// border of needle[0, i]
+template <typename Sequence>
+std::vector<std::size_t> kmp_failure(const Sequence& needle) {
+    std::vector<std::size_t> failure(needle.size(), 0);
+    std::size_t j = 0;
+    for (std::size_t i = 1; i < needle.size(); ++i) {
+        while (j > 0 && needle[i] != needle[j]) {
+            j = failure[j - 1];
+        }
+        if (needle[i] == needle[j]) {
+            ++j;
+        }
+        failure[i] = j;
+    }
+    return failure;
+}
+
+constexpr std::array<char, 256> make_ascii_lower() {
+    std::array<char, 256> table{};
+    for (int c = 0; c < 256; ++c) {
+        table[c] = static_cast<char>(c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c);
+    }
+    return table;
 }
 
-std::vector<int> find_pattern(const std::string& text, const std::string& pattern) {
-    std::vector<int> positions;
+constexpr std::array<char, 256> kAsciiLower = make_ascii_lower();
+
+// How the byte algorithms read the text. ExactBytes is the case-sensitive
+// default; AsciiFoldBytes lowers A-Z as each byte is read and searches with
+// the case-insensitive prefilter kernel (the needle is stored lowered).
+struct ExactBytes {
+    static char fold(char c) {
+        return c;
+    }
     
-    // Handle edge cases
-    if (pattern.empty() || text.empty() || pattern.length() > text.length()) {
-        return positions;
+    static bool equal(const char* text, const char* needle, std::size_t m) {
+        return std::memcmp(text, needle, m) == 0;
     }
     
+    // First i < count with data[i] == byte, or count
+    static std::size_t find(const char* data, std::size_t count, char byte) {
+        const void* hit = std::memchr(data, byte, count);
+        return hit == nullptr ? count : static_cast<std::size_t>(static_cast<const char*>(hit) - data);
+    }
+    
+    static auto pair_kernel() {
+        return detail::kernels().find_byte_pair;
+    }
+};
+
+struct AsciiFoldBytes {
+    static char fold(char c) {
+        return kAsciiLower[static_cast<unsigned char>(c)];
+    }
+    
+    static bool equal(const char* text, const char* needle, std::size_t m) {
+        for (std::size_t i = 0; i < m; ++i) {
+            if (fold(text[i]) != needle[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    static std::size_t find(const char* data, std::size_t count, char byte) {
+        if (byte < 'a' || byte > 'z') {
+            return ExactBytes::find(data, count, byte);
+        }
+        return detail::kernels().find_byte_pair_fold(data, count, 0, byte, 0, byte);
+    }
+    
+    static auto pair_kernel() {
+        return detail::kernels().find_byte_pair_fold;
+    }
+};
+
+// Stands in for a malformed text sequence in the CodePoints search; no
+// needle code point equals it
+constexpr char32_t kMalformedCodePoint = 0xffffffff;
+
+} // namespace
+
+Pattern::Pattern(std::string_view pattern, CaseMode mode)
+    : pattern_(pattern),
+      algorithm_(Algorithm::Empty),
+      case_mode_(mode),
+      fold_ascii_(mode != CaseMode::Sensitive),
+      rare_index_(0),
+      rare_byte_('\0'),
+      anchor_index_(0),
+      anchor_byte_('\0'),
+      critical_(0),
+      period_(1),
+      periodic_(false) {
+    if (mode == CaseMode::UnicodeFold) {
+        // Fold the needle once; the text is folded as it is read
+        std::string folded;
+        bool byte_search = true;
+        for (std::size_t i = 0; i < pattern.size();) {
+            char32_t codepoint;
+            const std::size_t length = detail::decode_utf8(pattern.data() + i, pattern.size() - i, codepoint);
+            if (length == 0) {
+                throw_invalid_utf8("Pattern", i);
+            }
+            codepoint = detail::simple_casefold(codepoint);
+            code_points_.push_back(codepoint);
+            detail::append_utf8(codepoint, folded);
+            // Long s folds to 's' and the Kelvin sign to 'k', so only needles
+            // without them match ASCII text bytewise
+            byte_search = byte_search && codepoint < 0x80 && codepoint != 's' && codepoint != 'k';
+            i += length;
+        }
+        pattern_ = std::move(folded);
+        if (!byte_search) {
+            algorithm_ = Algorithm::CodePoints;
+            failure_ = kmp_failure(code_points_);
+            return;
+        }
+        code_points_.clear();
+    } else if (mode == CaseMode::AsciiFold) {
+        for (char& c : pattern_) {
+            c = AsciiFoldBytes::fold(c);
+        }
+    }
+    
+    const std::size_t m = pattern_.length();
+    
     // Build KMP failure function for optimal O(n+m) performance
-    auto build_failure_function = [](const std::string& pattern) {
-        std::vector<int> failure(pattern.length(), 0);
-        int j = 0;
+    failure_ = kmp_failure(pattern_);
+    
+    // Prefilter on the rarest bytes; ties go to the earliest position
+    const auto rank = [this](std::size_t i) {
+        return byte_frequency_rank(static_cast<unsigned char>(pattern_[i]));
+    };
+    for (size_t i = 1; i < m; ++i) {
+        if (rank(i) < rank(rare_index_)) {
+            rare_index_ = i;
+        }
+    }
+    anchor_index_ = rare_index_ == 0 ? 1 : 0;
+    for (size_t i = anchor_index_ + 1; i < m; ++i) {
+        if (i != rare_index_ && rank(i) < rank(anchor_index_)) {
+            anchor_index_ = i;
+        }
+    }
+    if (m > 0) {
+        rare_byte_ = pattern_[rare_index_];
+    }
+    if (m > 1) {
+        anchor_byte_ = pattern_[anchor_index_];
+    }
+    
+    if (m == 0) {
+        algorithm_ = Algorithm::Empty;
+    } else if (m == 1) {
+        algorithm_ = Algorithm::Memchr;
+    } else if (m < kTwoWayMinLength) {
+        algorithm_ = Algorithm::Prefilter;
+    } else {
+        algorithm_ = Algorithm::TwoWay;
         
-        for (size_t i = 1; i < pattern.length(); ++i) {
-            while (j > 0 && pattern[i] != pattern[j]) {
-                j = failure[j - 1];
+        // Critical factorization: the later of the two maximal suffixes
+        const auto forward = maximal_suffix(pattern_, false);
+        const auto reverse = maximal_suffix(pattern_, true);
+        const auto& chosen = forward.first > reverse.first ? forward : reverse;
+        critical_ = chosen.first;
+        period_ = chosen.second;
+        
+        // Periodic needles can reuse matched bytes between windows; otherwise
+        // max(left, right) + 1 is a safe lower bound on the period
+        periodic_ = std::memcmp(pattern_.data(), pattern_.data() + period_, critical_) == 0;
+        if (!periodic_) {
+            period_ = std::max(critical_, m - critical_) + 1;
+        }
+        
+        // Distance from each byte's last occurrence to the end of the
+        // needle; 0 for the needle's last byte
+        last_byte_shift_.assign(256, m);
+        for (std::size_t i = 0; i < m; ++i) {
+            last_byte_shift_[static_cast<unsigned char>(pattern_[i])] = m - 1 - i;
+        }
+    }
+}
+
+template <typename OnMatch>
+void Pattern::search(std::string_view text, OnMatch&& on_match) const {
+    if (algorithm_ == Algorithm::CodePoints) {
+        search_code_points(text, on_match);
+    } else if (fold_ascii_) {
+        search_bytes<AsciiFoldBytes>(text, on_match);
+    } else {
+        search_bytes<ExactBytes>(text, on_match);
+    }
+}
+
+template <typename Bytes, typename OnMatch>
+void Pattern::search_bytes(std::string_view text, OnMatch&& on_match) const {
+    const std::size_t m = pattern_.length();
+    if (m == 0 || text.length() < m) {
+        return;
+    }
+    
+    switch (algorithm_) {
+        case Algorithm::Empty:
+        case Algorithm::CodePoints:
+            return;
+        case Algorithm::Memchr: {
+            const char* data = text.data();
+            const std::size_t n = text.length();
+            std::size_t i = 0;
+            while (i < n) {
+                i += Bytes::find(data + i, n - i, rare_byte_);
+                if (i == n) {
+                    return;
+                }
+                if (!on_match(i)) {
+                    return;
+                }
+                ++i;
             }
-            if (pattern[i] == pattern[j]) {
-                ++j;
+            return;
+        }
+        case Algorithm::Prefilter:
+            search_prefilter<Bytes>(text, on_match);
+            return;
+        case Algorithm::TwoWay:
+            search_two_way<Bytes>(text, on_match);
+            return;
+    }
+}
+
+template <typename Bytes, typename OnMatch>
+void Pattern::search_prefilter(std::string_view text, OnMatch&& on_match) const {
+    const std::size_t m = pattern_.length();
+    const char* data = text.data();
+    const auto find_byte_pair = Bytes::pair_kernel();
+    
+    // Candidate starts are [0, count); the kernel reads up to data[count - 1 + m - 1]
+    const std::size_t count = text.length() - m + 1;
+    std::size_t misses = 0;
+    std::size_t i = 0;
+    while (i < count) {
+        i += find_byte_pair(data + i, count - i, rare_index_, rare_byte_, anchor_index_, anchor_byte_);
+        if (i == count) {
+            return;
+        }
+        if (Bytes::equal(data + i, pattern_.data(), m)) {
+            if (!on_match(i)) {
+                return;
             }
-            failure[i] = j;
+        } else if (++misses > kPrefilterSlack + (i >> kPrefilterBytesPerMiss)) {
+            // The filter is not selective on this text: finish with KMP
+            const std::size_t base = i;
+            scan<Bytes>(text.substr(base), 0, [&on_match, base, m](std::size_t end) {
+                return on_match(base + end - m);
+            });
+            return;
         }
-        return failure;
-    };
+        ++i;
+    }
+}
+
+template <typename Bytes, typename OnMatch>
+void Pattern::search_two_way(std::string_view text, OnMatch&& on_match) const {
+    const std::size_t m = pattern_.length();
+    const std::size_t n = text.length();
+    const char* data = text.data();
+    const char* needle = pattern_.data();
     
-    // KMP pattern matching algorithm
-    const auto failure = build_failure_function(pattern);
-    int j = 0;
+    // Window start j; in the periodic case, memory is the length of the
+    // needle prefix already known to match at j
+    const auto find_byte_pair = Bytes::pair_kernel();
+    std::size_t memory = 0;
+    std::size_t j = 0;
+    while (j <= n - m) {
+        // With nothing carried over, jump to the next start where the two
+        // rarest needle bytes line up; j never moves back, so this stays linear
+        if (memory == 0) {
+            j += find_byte_pair(data + j, n - m + 1 - j, rare_index_, rare_byte_, anchor_index_, anchor_byte_);
+            if (j > n - m) {
+                return;
+            }
+        }
+        
+        // Bad-character skip on the window's last byte
+        const std::size_t shift = last_byte_shift_[static_cast<unsigned char>(Bytes::fold(data[j + m - 1]))];
+        if (shift > 0) {
+            if (periodic_ && memory > 0 && shift < period_) {
+                // The last period has a byte out of place: no match before it
+                j += m - period_;
+            } else {
+                j += shift;
+            }
+            memory = 0;
+            continue;
+        }
+        
+        // Right half, left to right; the last byte is already known to match
+        std::size_t i = periodic_ ? std::max(critical_, memory) : critical_;
+        while (i < m - 1 && needle[i] == Bytes::fold(data[j + i])) {
+            ++i;
+        }
+        if (i < m - 1) {
+            j += i - critical_ + 1;
+            memory = 0;
+            continue;
+        }
+        
+        // Left half, right to left, down to what is already known to match
+        const std::size_t known = periodic_ ? memory : 0;
+        i = critical_;
+        while (i > known && needle[i - 1] == Bytes::fold(data[j + i - 1])) {
+            --i;
+        }
+        if (i <= known) {
+            if (!on_match(j)) {
+                return;
+            }
+        }
+        
+        // Matched or not, the next possible start is a period away
+        j += period_;
+        memory = periodic_ ? m - period_ : 0;
+    }
+}
+
+template <typename OnMatch>
+void Pattern::search_code_points(std::string_view text, OnMatch&& on_match) const {
+    const std::size_t m = code_points_.size();
+    const std::size_t n = text.length();
+    const char* data = text.data();
+    const auto ascii_prefix = detail::kernels().ascii_prefix;
     
-    for (size_t i = 0; i < text.length(); ++i) {
-        while (j > 0 && text[i] != pattern[j]) {
-            j = failure[j - 1];
+    // While no match is in progress, skip ahead to where the first needle
+    // code point can start: past ASCII runs when it is not ASCII, to either
+    // case of it when no non-ASCII code point folds to it, and otherwise to
+    // either case of it or the next non-ASCII byte, whichever comes first
+    const char32_t first = code_points_[0];
+    const bool skip_ascii = first >= 0x80;
+    const bool find_first = first < 0x80 && first != 's' && first != 'k';
+    const auto first_byte = static_cast<char>(first);
+    
+    // Byte offsets of the last m code points read, oldest at starts[slot]
+    std::vector<std::size_t> starts(m);
+    std::size_t slot = 0;
+    std::size_t j = 0;
+    std::size_t i = 0;
+    while (i < n) {
+        if (j == 0) {
+            if (skip_ascii) {
+                i += ascii_prefix(data + i, n - i);
+            } else if (find_first) {
+                i += AsciiFoldBytes::find(data + i, n - i, first_byte);
+            } else {
+                // Bounded windows keep this linear when the letter is common
+                for (;;) {
+                    const std::size_t run = ascii_prefix(data + i, std::min<std::size_t>(n - i, 64));
+                    const std::size_t hit = AsciiFoldBytes::find(data + i, run, first_byte);
+                    i += hit;
+                    if (hit < run || run < 64) {
+                        break;
+                    }
+                }
+            }
+            if (i == n) {
+                return;
+            }
+        }
+        
+        char32_t codepoint;
+        std::size_t length = 1;
+        if (static_cast<unsigned char>(data[i]) < 0x80) {
+            codepoint = static_cast<unsigned char>(AsciiFoldBytes::fold(data[i]));
+        } else {
+            length = detail::decode_utf8(data + i, n - i, codepoint);
+            if (length == 0) {
+                codepoint = kMalformedCodePoint;
+                length = 1;
+            } else {
+                codepoint = detail::simple_casefold(codepoint);
+            }
         }
-        if (text[i] == pattern[j]) {
+        starts[slot] = i;
+        slot = slot + 1 == m ? 0 : slot + 1;
+        i += length;
+        
+        // KMP step over folded code points
+        while (j > 0 && codepoint != code_points_[j]) {
+            j = failure_[j - 1];
+        }
+        if (codepoint == code_points_[j]) {
             ++j;
         }
-        if (static_cast<size_t>(j) == pattern.length()) {
-            positions.push_back(static_cast<int>(i - pattern.length() + 1));
-            j = failure[j - 1];
+        if (j == m) {
+            if (!on_match(starts[slot])) {
+                return;
+            }
+            j = failure_[j - 1];
         }
     }
+}
+
+template <typename Bytes, typename OnMatch>
+std::size_t Pattern::scan(std::string_view text, std::size_t state, OnMatch&& on_match) const {
+    const std::size_t m = pattern_.length();
+    const std::size_t n = text.length();
     
+    // Handle edge cases
+    if (m == 0) {
+        return 0;
+    }
+    
+    const char* data = text.data();
+    std::size_t j = state;
+    std::size_t i = 0;
+    
+    while (i < n) {
+        // With no partial match in progress, any match starting at s >= i has
+        // the rare byte at s + rare_index_: jump straight to the next candidate.
+        // Without one, skip to where a match could still be in progress at the
+        // end of text, so the returned state stays exact.
+        if (j == 0 && n - i >= m && Bytes::fold(data[i + rare_index_]) != rare_byte_) {
+            const std::size_t count = n - m - i + 1;
+            const std::size_t skip = Bytes::find(data + i + rare_index_, count, rare_byte_);
+            if (skip == count) {
+                i = n - m + 1;
+                continue;
+            }
+            i += skip;
+        }
+        
+        // KMP step
+        const char c = Bytes::fold(data[i]);
+        while (j > 0 && c != pattern_[j]) {
+            j = failure_[j - 1];
+        }
+        if (c == pattern_[j]) {
+            ++j;
+        }
+        ++i;
+        if (j == m) {
+            if (!on_match(i)) {
+                return 0;
+            }
+            j = failure_[j - 1];
+        }
+    }
+    return j;
+}
+
+std::vector<std::size_t> Pattern::find_all(std::string_view text) const {
+    std::vector<std::size_t> positions;
+    find_all(text, positions);
     return positions;
 }
 
-bool validate_dna(const std::string& sequence) {
-    // Empty sequence is considered valid
-    if (sequence.empty()) {
+void Pattern::find_all(std::string_view text, std::vector<std::size_t>& positions) const {
+    search(text, [&positions](std::size_t pos) {
+        positions.push_back(pos);
+        return true;
+    });
+}
+
+std::size_t Pattern::find_first(std::string_view text) const {
+    std::size_t first = npos;
+    search(text, [&first](std::size_t pos) {
+        first = pos;
+        return false;
+    });
+    return first;
+}
+
+std::size_t Pattern::count(std::string_view text) const {
+    std::size_t total = 0;
+    search(text, [&total](std::size_t) {
+        ++total;
         return true;
+    });
+    return total;
+}
+
+bool Pattern::contains(std::string_view text) const {
+    return find_first(text) != npos;
+}
+
+StreamingMatcher::StreamingMatcher(std::string_view pattern)
+    : pattern_(pattern), state_(0), consumed_(0) {}
+
+std::vector<std::size_t> StreamingMatcher::feed(std::string_view chunk) {
+    std::vector<std::size_t> positions;
+    feed(chunk, positions);
+    return positions;
+}
+
+void StreamingMatcher::feed(std::string_view chunk, std::vector<std::size_t>& positions) {
+    // Match ends are relative to this chunk; the start may lie in an earlier one
+    const std::size_t consumed = consumed_;
+    const std::size_t m = pattern_.pattern_.length();
+    state_ = pattern_.scan<ExactBytes>(chunk, state_, [&positions, consumed, m](std::size_t end) {
+        positions.push_back(consumed + end - m);
+        return true;
+    });
+    consumed_ += chunk.length();
+}
+
+void StreamingMatcher::reset() {
+    state_ = 0;
+    consumed_ = 0;
+}
+
+std::vector<std::size_t> find_pattern(std::string_view text, std::string_view pattern, Pattern::CaseMode mode) {
+    // Handle edge cases before paying for the failure table; under Unicode
+    // folding a match need not be as long in the text as the needle
+    if (pattern.empty() || text.empty() ||
+        (mode != Pattern::CaseMode::UnicodeFold && pattern.length() > text.length())) {
+        return {};
+    }
+    
+    return Pattern(pattern, mode).find_all(text);
+}
+
+std::vector<std::size_t> find_pattern_parallel(std::string_view text, std::string_view pattern,
+                                               std::size_t threads, std::size_t min_parallel_size) {
+    auto& pool = detail::ThreadPool::shared();
+    if (threads == 0) {
+        threads = pool.size() + 1;
+    }
+    if (threads <= 1 || text.length() < min_parallel_size) {
+        return find_pattern(text, pattern);
+    }
+    if (pattern.empty() || pattern.length() > text.length()) {
+        return {};
     }
     
-    // Use std::all_of for optimal performance and readability
-    return std::all_of(sequence.begin(), sequence.end(), [](char c) {
-        // Convert to uppercase for case-insensitive comparison
-        char upper_c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
-        return upper_c == 'A' || upper_c == 'T' || upper_c == 'G' || upper_c == 'C';
+    // A few chunks per thread evens out uneven match density, but keep each
+    // chunk large enough that the (m - 1) byte overlap stays negligible
+    constexpr std::size_t kMinChunk = std::size_t(64) << 10;
+    const std::size_t starts = text.length() - pattern.length() + 1;
+    const std::size_t chunk = std::max({(starts + threads * 4 - 1) / (threads * 4), kMinChunk, pattern.length()});
+    const std::size_t chunks = (starts + chunk - 1) / chunk;
+    
+    // Chunk k owns the match starts [k * chunk, (k + 1) * chunk)
+    const Pattern compiled(pattern);
+    std::vector<std::vector<std::size_t>> partial(chunks);
+    pool.parallel_for(chunks, threads, [&](std::size_t k) {
+        const std::size_t begin = k * chunk;
+        const std::size_t owned = std::min(chunk, starts - begin);
+        compiled.find_all(text.substr(begin, owned + pattern.length() - 1), partial[k]);
+        for (auto& pos : partial[k]) {
+            pos += begin;
+        }
     });
+    
+    std::size_t total = 0;
+    for (const auto& positions : partial) {
+        total += positions.size();
+    }
+    std::vector<std::size_t> positions;
+    positions.reserve(total);
+    for (const auto& chunk_positions : partial) {
+        positions.insert(positions.end(), chunk_positions.begin(), chunk_positions.end());
+    }
+    return positions;
+}
+
+bool validate_dna(std::string_view sequence) {
+    // Empty sequence is considered valid
+    return detail::kernels().dna_first_invalid(sequence.data(), sequence.size()) == sequence.size();
 }
 
-double calculate_gc_content(const std::string& sequence) {
+double calculate_gc_content(std::string_view sequence) {
     // Handle empty sequence edge case
     if (sequence.empty()) {
         return 0.0;
     }
     
-    // Count G and C nucleotides using std::count_if for performance
-    const int gc_count = std::count_if(sequence.begin(), sequence.end(), [](char c) {
-        char upper_c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
-        return upper_c == 'G' || upper_c == 'C';
-    });
+    const std::size_t gc_count = detail::kernels().count_gc(sequence.data(), sequence.size());
     
     // Calculate percentage - use double division to avoid integer truncation
     return (static_cast<double>(gc_count) / static_cast<double>(sequence.length())) * 100.0;
 }
 
-}
\ No newline at end of file
+DnaStats dna_stats(std::string_view sequence) {
+    std::size_t counts[5] = {0, 0, 0, 0, 0};
+    const std::size_t first_invalid = detail::kernels().dna_stats(sequence.data(), sequence.size(), counts);
+    
+    DnaStats stats;
+    stats.valid = first_invalid == sequence.size();
+    stats.first_invalid = stats.valid ? DnaStats::npos : first_invalid;
+    stats.length = sequence.size();
+    stats.a = counts[0];
+    stats.c = counts[1];
+    stats.g = counts[2];
+    stats.t = counts[3];
+    stats.n = counts[4];
+    return stats;
+}
+
+std::vector<std::size_t> count_char_batch(const std::vector<std::string_view>& inputs, char c) {
+    std::vector<std::size_t> counts(inputs.size());
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        counts[i] = count_char(inputs[i], c);
+    }
+    return counts;
+}
+
+BatchMatches find_pattern_batch(const std::vector<std::string_view>& texts, std::string_view pattern) {
+    // Compile once, then append every record's matches into one flat array
+    const Pattern compiled(pattern);
+    BatchMatches matches;
+    matches.offsets.reserve(texts.size() + 1);
+    matches.offsets.push_back(0);
+    for (std::string_view text : texts) {
+        compiled.find_all(text, matches.positions);
+        matches.offsets.push_back(matches.positions.size());
+    }
+    return matches;
+}
+
+std::vector<std::uint8_t> is_palindrome_batch(const std::vector<std::string_view>& inputs) {
+    std::vector<std::uint8_t> results(inputs.size());
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        results[i] = is_palindrome(inputs[i]) ? 1 : 0;
+    }
+    return results;
+}
+
+std::vector<double> gc_content_batch(const std::vector<std::string_view>& sequences) {
+    std::vector<double> contents(sequences.size());
+    for (std::size_t i = 0; i < sequences.size(); ++i) {
+        contents[i] = calculate_gc_content(sequences[i]);
+    }
+    return contents;
+}
+
+}
@@ -1,6 +1,12 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include <unordered_map>
 
@@ -10,17 +16,23 @@
  * 
  * This header defines a collection of optimized string processing functions
  * designed for maximum performance using modern C++17 features.
+ *
+ * Inputs are taken as std::string_view so callers can pass std::string,
+ * string literals, or views over mmap'd and foreign buffers without a copy.
  */
 
 namespace pystringpp {
 
     /**
-     * @brief Efficiently reverse a string in-place using iterators
+     * @brief Reverse the bytes of a string
      * 
-     * This function reverses the input string using the most efficient
-     * approach available in the STL. It handles empty strings gracefully.
+     * Writes the input reversed straight into the result in one pass, with
+     * the widest byte-shuffle kernel available (pshufb on SSSE3, plus a lane
+     * swap on AVX2, 8-byte bswap otherwise); see simd_level(). Bytes are
+     * reversed as-is, so multi-byte UTF-8 characters are not preserved;
+     * use reverse_utf8() or reverse_graphemes() for text.
      * 
-     * @param input The string to reverse (passed by const reference for efficiency)
+     * @param input The string to reverse (non-owning view, never copied)
      * @return std::string A new string containing the reversed input
      * 
      * Time Complexity: O(n) where n is the length of the string
@@ -30,46 +42,571 @@ namespace pystringpp {
      * std::string result = reverse_string("hello");
      * // result == "olleh"
      */
-    std::string reverse_string(const std::string& input);
+    std::string reverse_string(std::string_view input);
+
+    /**
+     * @brief Reverse the bytes of a caller-owned buffer in place
+     * 
+     * Same kernels as reverse_string(), swapping one vector from each end
+     * per step: no allocation, and each byte is read and written once.
+     * 
+     * @param data Start of the buffer
+     * @param size Number of bytes to reverse
+     * 
+     * Time Complexity: O(n)
+     * Space Complexity: O(1)
+     * 
+     * @example
+     * std::string s = "hello";
+     * reverse_inplace(s);
+     * // s == "olleh"
+     */
+    void reverse_inplace(char* data, std::size_t size);
+    void reverse_inplace(std::string& text);
+
+    /**
+     * @brief Reverse UTF-8 text by code point
+     * 
+     * The bytes of each multi-byte character keep their order, so the result
+     * is valid UTF-8 again. Single pass into the result: SIMD finds each run
+     * of ASCII, which is reversed with the reverse_string() kernels, and only
+     * the characters in between are decoded one by one.
+     * 
+     * @param input UTF-8 text (non-owning view)
+     * @return std::string The code points of input in reverse order
+     * @throws std::invalid_argument if input is not well-formed UTF-8
+     * 
+     * Time Complexity: O(n)
+     * Space Complexity: O(n) for the return value
+     * 
+     * @example
+     * std::string s = reverse_utf8("añb");
+     * // s == "bña"
+     */
+    std::string reverse_utf8(std::string_view input);
+
+    /**
+     * @brief Reverse UTF-8 text by extended grapheme cluster
+     * 
+     * Like reverse_utf8(), but a user-perceived character stays whole: a
+     * base with its combining marks ("e" + U+0301) or Indic vowel signs,
+     * CR LF, Hangul jamo sequences, emoji with modifiers or variation
+     * selectors, ZWJ sequences such as family emoji, and regional-indicator
+     * flag pairs. Cluster boundaries follow UAX #29 with Extend, SpacingMark
+     * and Control taken from the UCD; Prepend characters and Indic conjunct
+     * rules are not applied.
+     * 
+     * @param input UTF-8 text (non-owning view)
+     * @return std::string The grapheme clusters of input in reverse order
+     * @throws std::invalid_argument if input is not well-formed UTF-8
+     * 
+     * Time Complexity: O(n)
+     * Space Complexity: O(n) for the return value
+     * 
+     * @example
+     * std::string s = reverse_graphemes("e\u0301a");
+     * // s == "ae\u0301"
+     */
+    std::string reverse_graphemes(std::string_view input);
 
     /**
      * @brief Count occurrences of a specific character in a string
      * 
      * Efficiently counts how many times a specific character appears in the
      * input string. The search is case-sensitive and handles null characters.
+     * Uses the widest SIMD kernel (SSE2, AVX2 or AVX-512BW) the CPU supports,
+     * selected once at load time; see simd_level().
      * 
-     * @param input The string to search in (passed by const reference)
+     * @param input The string to search in (non-owning view)
      * @param c The character to count
-     * @return int The number of times the character appears in the string
+     * @return std::size_t The number of times the character appears in the string
      * 
      * Time Complexity: O(n) where n is the length of the string
      * Space Complexity: O(1)
      * 
      * @example
-     * int count = count_char("hello world", 'l');
+     * std::size_t count = count_char("hello world", 'l');
      * // count == 3
      */
-    int count_char(const std::string& input, char c);
+    std::size_t count_char(std::string_view input, char c);
+
+    /**
+     * @brief Count every byte value in a string in one pass
+     * 
+     * Builds the full 256-entry histogram with eight interleaved count tables
+     * fed from 8-byte loads, so long runs of one byte do not stall on a
+     * single counter. Much faster than hashing each byte into a map, and
+     * cheaper than 256 count_char() passes.
+     * 
+     * @param input The string to scan (non-owning view)
+     * @return std::array<std::uint64_t, 256> Occurrences of each byte value,
+     *         indexed by the byte as unsigned char
+     * 
+     * Time Complexity: O(n) where n is the length of the string
+     * Space Complexity: O(1) (8 KiB of count tables on the stack)
+     * 
+     * @example
+     * auto counts = byte_histogram("hello");
+     * // counts['l'] == 2, counts['z'] == 0
+     */
+    std::array<std::uint64_t, 256> byte_histogram(std::string_view input);
 
     /**
-     * @brief Find all positions where a pattern occurs in text using KMP algorithm
+     * @brief Precompiled single-pattern matcher
+     * 
+     * Analyzes the needle once and picks a search algorithm, so that searching
+     * many texts for the same needle pays the setup cost only once:
+     * 
+     * - Memchr for one-byte needles.
+     * - Prefilter for needles shorter than 32 bytes: a SIMD kernel compares
+     *   the needle's two rarest bytes (by a static byte frequency ranking)
+     *   at a whole vector of candidate starts at once, and memcmp verifies
+     *   the candidates. If too many candidates turn out to be false positives
+     *   for the text at hand, the rest of it is searched with KMP instead.
+     * - TwoWay for longer needles: Crochemore-Perrin Two-Way, linear in the
+     *   worst case, with the same SIMD prefilter and a bad-character shift on
+     *   the window's last byte to skip ahead on typical text.
+     * 
+     * Every algorithm reports exactly the same matches. Overlapping matches
+     * are all reported and an empty pattern never matches.
+     * 
+     * Matching is case-sensitive unless another CaseMode is given. Folding
+     * happens on the fly as the text is read, so no lowered copy of the text
+     * is made:
+     * 
+     * - AsciiFold: A-Z match a-z, all other bytes compare exactly. The same
+     *   algorithms run on the lowered needle; the SIMD prefilter matches
+     *   either case of its two bytes.
+     * - UnicodeFold: needle and text are UTF-8 and code points compare under
+     *   simple (one-to-one) case folding, so "STRASSE" does not match
+     *   "straße". The CodePoints algorithm runs KMP over folded code points,
+     *   skipping ASCII runs with SIMD while no match is in progress; an ASCII
+     *   needle without 's' or 'k' (the only letters a non-ASCII code point
+     *   folds to) is searched like AsciiFold. Match offsets are byte offsets
+     *   and a match may be longer or shorter in the text than the needle.
+     *   Malformed UTF-8 in the text never matches.
+     * 
+     * Time Complexity: O(m) to build, O(n + m) worst case per search
+     * Space Complexity: O(m) for the KMP failure table
      * 
-     * Uses the Knuth-Morris-Pratt (KMP) algorithm for efficient pattern matching.
+     * @example
+     * Pattern needle("abc");
+     * auto positions = needle.find_all("abcabcabc");
+     * // positions == {0, 3, 6}
+     */
+    class Pattern {
+    public:
+        /// Returned by find_first() when there is no match
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        /// Search algorithm chosen for the needle (see class description)
+        enum class Algorithm {
+            Empty,
+            Memchr,
+            Prefilter,
+            TwoWay,
+            CodePoints
+        };
+
+        /// How letters compare (see class description)
+        enum class CaseMode {
+            Sensitive,
+            AsciiFold,
+            UnicodeFold
+        };
+
+        /// @throws std::invalid_argument if mode is UnicodeFold and pattern is not well-formed UTF-8
+        explicit Pattern(std::string_view pattern, CaseMode mode = CaseMode::Sensitive);
+
+        /// All 0-based start offsets, in increasing order
+        std::vector<std::size_t> find_all(std::string_view text) const;
+
+        /// Append all 0-based start offsets to positions (no allocation if it has capacity)
+        void find_all(std::string_view text, std::vector<std::size_t>& positions) const;
+
+        /// Offset of the first match, or npos
+        std::size_t find_first(std::string_view text) const;
+
+        /// Number of (possibly overlapping) matches, without allocating
+        std::size_t count(std::string_view text) const;
+
+        /// True if the pattern occurs anywhere in text
+        bool contains(std::string_view text) const;
+
+        /// The needle as searched: lowered under AsciiFold, case folded under UnicodeFold
+        const std::string& pattern() const { return pattern_; }
+
+        Algorithm algorithm() const { return algorithm_; }
+
+        CaseMode case_mode() const { return case_mode_; }
+
+    private:
+        friend class StreamingMatcher;
+
+        // Calls on_match(start offset) for every match until it returns false,
+        // using the selected algorithm
+        template <typename OnMatch>
+        void search(std::string_view text, OnMatch&& on_match) const;
+
+        // The byte algorithms, with Bytes deciding how text bytes compare to
+        // the needle (exactly, or ASCII case folded)
+        template <typename Bytes, typename OnMatch>
+        void search_bytes(std::string_view text, OnMatch&& on_match) const;
+
+        template <typename Bytes, typename OnMatch>
+        void search_prefilter(std::string_view text, OnMatch&& on_match) const;
+
+        template <typename Bytes, typename OnMatch>
+        void search_two_way(std::string_view text, OnMatch&& on_match) const;
+
+        // KMP over the simple case folded code points of UTF-8 text
+        template <typename OnMatch>
+        void search_code_points(std::string_view text, OnMatch&& on_match) const;
+
+        // Runs KMP over text starting from `state` pattern bytes already
+        // matched, calling on_match(end offset) until it returns false.
+        // Returns the state after text, for resuming on the next chunk.
+        template <typename Bytes, typename OnMatch>
+        std::size_t scan(std::string_view text, std::size_t state, OnMatch&& on_match) const;
+
+        std::string pattern_;
+        std::vector<std::size_t> failure_;
+        Algorithm algorithm_;
+        CaseMode case_mode_;
+
+        // Byte algorithms compare text bytes ASCII case folded
+        bool fold_ascii_;
+
+        // CodePoints: the folded needle, with failure_ built over it
+        std::vector<char32_t> code_points_;
+
+        // Rarest byte (also used by the KMP scan) and second rarest, by position
+        std::size_t rare_index_;
+        char rare_byte_;
+        std::size_t anchor_index_;
+        char anchor_byte_;
+
+        // Two-Way: critical factorization, the needle's period (a lower bound
+        // of it when not periodic) and the shift for each window-final byte
+        std::size_t critical_;
+        std::size_t period_;
+        bool periodic_;
+        std::vector<std::size_t> last_byte_shift_;
+    };
+
+    /**
+     * @brief Incremental single-pattern search over a stream of chunks
+     * 
+     * Keeps the KMP state between feed() calls, so matches spanning chunk
+     * boundaries are found without buffering or concatenating the stream.
+     * Offsets are absolute positions in the stream: feeding a text in any
+     * split reports the same offsets as Pattern::find_all() on the whole.
+     * Only the compiled pattern is retained, never the data fed.
+     * 
+     * @example
+     * StreamingMatcher matcher("needle");
+     * matcher.feed("...nee");   // {}
+     * matcher.feed("dle...");   // {3}
+     */
+    class StreamingMatcher {
+    public:
+        explicit StreamingMatcher(std::string_view pattern);
+
+        /// Absolute offsets of the matches that end within chunk, in increasing order
+        std::vector<std::size_t> feed(std::string_view chunk);
+
+        /// Append the absolute offsets of the matches that end within chunk
+        void feed(std::string_view chunk, std::vector<std::size_t>& positions);
+
+        /// Forget any partial match and restart offsets at 0
+        void reset();
+
+        /// Total number of bytes fed since construction or reset()
+        std::size_t consumed() const { return consumed_; }
+
+        const std::string& pattern() const { return pattern_.pattern(); }
+
+    private:
+        Pattern pattern_;
+        std::size_t state_;
+        std::size_t consumed_;
+    };
+
+    /**
+     * @brief Find all positions where a pattern occurs in text
+     * 
+     * Searches with the algorithm Pattern selects for the needle (SIMD
+     * prefilter, Two-Way or memchr, with KMP as the worst-case fallback).
      * Returns all starting positions where the pattern is found in the text.
-     * Handles edge cases like empty patterns or text.
+     * Handles edge cases like empty patterns or text. Equivalent to
+     * Pattern(pattern, mode).find_all(text); compile a Pattern once instead
+     * when searching many texts for the same needle.
      * 
-     * @param text The text to search in (passed by const reference)
-     * @param pattern The pattern to search for (passed by const reference)
-     * @return std::vector<int> Vector of 0-based indices where pattern starts
+     * @param text The text to search in (non-owning view)
+     * @param pattern The pattern to search for (non-owning view)
+     * @param mode Case-sensitive, ASCII or simple Unicode case folding (see Pattern)
+     * @return std::vector<std::size_t> Vector of 0-based indices where pattern starts
+     * @throws std::invalid_argument if mode is UnicodeFold and pattern is not well-formed UTF-8
      * 
      * Time Complexity: O(n + m) where n is text length, m is pattern length
-     * Space Complexity: O(m) for the failure function
+     * Space Complexity: O(m) for the pattern tables
      * 
      * @example
      * auto positions = find_pattern("abcabcabc", "abc");
      * // positions == {0, 3, 6}
+     * auto errors = find_pattern("Error, ERROR", "error", Pattern::CaseMode::AsciiFold);
+     * // errors == {0, 7}
+     */
+    std::vector<std::size_t> find_pattern(std::string_view text, std::string_view pattern,
+                                          Pattern::CaseMode mode = Pattern::CaseMode::Sensitive);
+
+    /**
+     * @brief Multi-threaded find_pattern for very large texts
+     * 
+     * Splits the text into chunks whose search windows overlap by
+     * pattern.length() - 1 bytes, so every match is found by exactly the chunk
+     * it starts in. Chunks are searched on a shared worker pool with one
+     * compiled Pattern, and their (already sorted) results are concatenated in
+     * chunk order: output is identical to find_pattern(), overlapping matches
+     * included. Texts shorter than min_parallel_size are searched on the
+     * calling thread.
+     * 
+     * @param text The text to search in (non-owning view)
+     * @param pattern The pattern to search for (non-owning view)
+     * @param threads Maximum threads to use, including the caller; 0 means
+     *                one per hardware thread
+     * @param min_parallel_size Texts shorter than this stay single-threaded
+     * @return std::vector<std::size_t> Vector of 0-based indices where pattern starts
+     * 
+     * Time Complexity: O((n + m * chunks) / threads)
+     * Space Complexity: O(m) plus per-chunk result buffers
+     */
+    std::vector<std::size_t> find_pattern_parallel(std::string_view text, std::string_view pattern,
+                                                   std::size_t threads = 0,
+                                                   std::size_t min_parallel_size = std::size_t(1) << 22);
+
+    /// Differences find_approximate() counts as errors
+    enum class ErrorModel {
+        Substitutions,  ///< Hamming distance: the occurrence is as long as the pattern
+        Edits           ///< Levenshtein distance: substitutions, insertions and deletions
+    };
+
+    /// One approximate occurrence found by find_approximate()
+    struct ApproximateMatch {
+        std::size_t end;     ///< Offset just past the occurrence's last byte
+        std::size_t errors;  ///< Fewest errors of any occurrence ending there
+
+        bool operator==(const ApproximateMatch& other) const {
+            return end == other.end && errors == other.errors;
+        }
+    };
+
+    /**
+     * @brief Find where a pattern occurs with at most max_errors errors
+     * 
+     * Bit-parallel Shift-And over the text in one pass, keeping one state
+     * word per error count: Baeza-Yates-Gonnet for Substitutions, Wu-Manber
+     * for Edits. Patterns up to 64 bytes fit a single 64-bit word per state;
+     * longer patterns use one word per 64 bytes with carries between them.
+     * 
+     * An occurrence is reported by its end rather than its start, since
+     * under Edits several starts (of different lengths) may share one end.
+     * Every end offset in [1, n] at which some occurrence ends is reported
+     * once, in increasing order, with the smallest error count among the
+     * occurrences ending there. With Substitutions an occurrence at end e is
+     * text[e - m, e). An empty pattern never matches.
+     * 
+     * @param text The text to search in (non-owning view)
+     * @param pattern The pattern to search for (non-owning view)
+     * @param max_errors Largest error count k to accept
+     * @param model Whether errors are substitutions only or any edit
+     * @return std::vector<ApproximateMatch> Matches in increasing end order
+     * 
+     * Time Complexity: O(n * (k + 1) * ceil(m / 64))
+     * Space Complexity: O(256 * ceil(m / 64) + (k + 1) * ceil(m / 64))
+     * 
+     * @example
+     * auto matches = find_approximate("ACGTTGCA", "ACGA", 1);
+     * // matches == {{4, 1}}: "ACGT" differs from "ACGA" in one byte
+     */
+    std::vector<ApproximateMatch> find_approximate(std::string_view text, std::string_view pattern,
+                                                   std::size_t max_errors,
+                                                   ErrorModel model = ErrorModel::Substitutions);
+
+    /**
+     * @brief Compiled Aho-Corasick automaton for searching many patterns at once
+     * 
+     * Built once from a list of patterns, then reused to scan any number of
+     * texts in a single pass each. Matches follow find_pattern() semantics:
+     * empty patterns never match, overlapping matches are all reported, and a
+     * pattern that is a suffix of another is reported at its own offset.
+     * 
+     * Two state representations are available:
+     * - Dense: a full DFA transition table over the byte classes used by the
+     *   patterns. One table lookup per text byte; best for small alphabets.
+     * - Compact: a sorted edge list per trie node plus failure links. Memory
+     *   is linear in the total pattern length; best for large pattern sets.
+     * Mode::Auto picks Dense while the table stays under a fixed memory budget.
+     * 
+     * Time Complexity: O(n + z) per search where z is the number of matches
+     * Space Complexity: O(L * k) dense or O(L) compact, L = total pattern length
+     * 
+     * @example
+     * AhoCorasick ac({"he", "she", "hers"});
+     * auto matches = ac.find_all("ushers");
+     * // matches == {{1, 1}, {0, 2}, {2, 2}}
+     */
+    class AhoCorasick {
+    public:
+        /// A match as (pattern_id, offset): index into the pattern list and 0-based start
+        using Match = std::pair<std::size_t, std::size_t>;
+
+        enum class Mode {
+            Auto,
+            Dense,
+            Compact
+        };
+
+        /**
+         * @brief Compile the automaton
+         * 
+         * @param patterns Patterns to search for; pattern ids are their indices
+         * @param mode State representation (see class description)
+         * @throws std::length_error if the patterns need more than 2^32 - 1 states
+         */
+        explicit AhoCorasick(const std::vector<std::string>& patterns, Mode mode = Mode::Auto);
+
+        /**
+         * @brief Find every occurrence of every pattern in text
+         * 
+         * @return std::vector<Match> Matches sorted by offset, then pattern id
+         */
+        std::vector<Match> find_all(std::string_view text) const;
+
+        /// Number of matches find_all() would return, without materializing them
+        std::size_t count(std::string_view text) const;
+
+        /// True if any pattern occurs in text; stops at the first match
+        bool contains(std::string_view text) const;
+
+        /// Number of patterns the automaton was built from (including empty ones)
+        std::size_t pattern_count() const { return pattern_lengths_.size(); }
+
+        /// Representation actually in use (never Mode::Auto)
+        Mode mode() const { return mode_; }
+
+    private:
+        std::uint32_t next_state(std::uint32_t state, unsigned char c) const;
+
+        template <typename OnMatch>
+        void scan(std::string_view text, OnMatch&& on_match) const;
+
+        Mode mode_;
+        std::vector<std::size_t> pattern_lengths_;
+
+        // Failure link per state, and the first state on the suffix chain
+        // (including the state itself) that ends a pattern, 0 if none
+        std::vector<std::uint32_t> fail_;
+        std::vector<std::uint32_t> report_;
+
+        // Pattern ids ending at each state, in CSR layout
+        std::vector<std::uint32_t> output_offsets_;
+        std::vector<std::uint32_t> output_ids_;
+
+        // Compact mode: sorted trie edges per state in CSR layout
+        std::vector<std::uint32_t> edge_offsets_;
+        std::vector<unsigned char> edge_labels_;
+        std::vector<std::uint32_t> edge_targets_;
+
+        // Dense mode: byte -> class map and a states x classes transition table
+        std::array<std::uint16_t, 256> byte_class_;
+        std::size_t class_count_;
+        std::vector<std::uint32_t> delta_;
+    };
+
+    /**
+     * @brief Suffix array index over one text, for repeated exact searches
+     * 
+     * Built once per text, after which each query costs O(m log n) instead
+     * of find_pattern()'s O(n) scan. The suffix array is constructed in
+     * linear time with SA-IS (Nong, Zhang and Chan); the LCP array uses the
+     * permuted-LCP form of Kasai's algorithm, split into blocks that are
+     * computed on the shared worker pool. Queries binary-search the suffix
+     * array, skipping the prefix already known to match both bounds.
+     * 
+     * The index owns a copy of the text and stores 32-bit suffix offsets,
+     * so texts must be shorter than 4 GiB; memory use is about 9n bytes.
+     * save() and load() write and read the text with both arrays so that a
+     * corpus only needs to be indexed once.
+     * 
+     * Time Complexity: O(n) to build, O(m log n + z) per locate() with z matches
+     * Space Complexity: O(n)
+     * 
+     * @example
+     * SuffixIndex index("abracadabra");
+     * auto positions = index.locate("abra");
+     * // positions == {0, 7}
      */
-    std::vector<int> find_pattern(const std::string& text, const std::string& pattern);
+    class SuffixIndex {
+    public:
+        /**
+         * @brief Index a text
+         * 
+         * @param text The text to index; the index keeps its own copy
+         * @param threads Maximum threads for the LCP pass, including the
+         *                caller; 0 means one per hardware thread
+         * @throws std::length_error if text is 4 GiB or longer
+         */
+        explicit SuffixIndex(std::string text, std::size_t threads = 0);
+
+        /**
+         * @brief Read an index written by save()
+         * 
+         * @throws std::runtime_error if the file cannot be opened, is not a
+         *         suffix index, was written on a machine of the other
+         *         endianness, or is truncated or corrupt
+         */
+        static SuffixIndex load(const std::string& path);
+
+        /**
+         * @brief Write the text, suffix array and LCP array to a file
+         * 
+         * @throws std::runtime_error if the file cannot be written
+         */
+        void save(const std::string& path) const;
+
+        /// Every offset where pattern occurs, ascending like find_pattern()
+        std::vector<std::size_t> locate(std::string_view pattern) const;
+
+        /// Number of occurrences of pattern; O(m log n) regardless of the count
+        std::size_t count(std::string_view pattern) const;
+
+        /// True if pattern occurs in the text
+        bool contains(std::string_view pattern) const { return count(pattern) != 0; }
+
+        /// The indexed text
+        const std::string& text() const { return text_; }
+
+        /// Length of the indexed text
+        std::size_t size() const { return text_.size(); }
+
+        /// Start offsets of the text's suffixes in lexicographic order
+        const std::vector<std::uint32_t>& suffix_array() const { return suffix_array_; }
+
+        /// lcp()[i] is the longest common prefix of suffixes i - 1 and i of
+        /// suffix_array(); lcp()[0] is 0
+        const std::vector<std::uint32_t>& lcp() const { return lcp_; }
+
+    private:
+        SuffixIndex() = default;
+
+        /// [first, last) range of suffix_array() starting with pattern
+        std::pair<std::size_t, std::size_t> range(std::string_view pattern) const;
+
+        std::string text_;
+        std::vector<std::uint32_t> suffix_array_;
+        std::vector<std::uint32_t> lcp_;
+    };
 
     /**
      * @brief Validate if a string represents a valid DNA sequence
@@ -77,7 +614,7 @@ namespace pystringpp {
      * Checks if the input string contains only valid DNA nucleotide characters:
      * A, T, G, C (case-insensitive). Empty strings are considered valid.
      * 
-     * @param sequence The DNA sequence to validate (passed by const reference)
+     * @param sequence The DNA sequence to validate (non-owning view)
      * @return bool True if sequence contains only A, T, G, C; false otherwise
      * 
      * Time Complexity: O(n) where n is the length of the sequence
@@ -89,16 +626,17 @@ namespace pystringpp {
      * bool invalid = validate_dna("ATGX");
      * // invalid == false
      */
-    bool validate_dna(const std::string& sequence);
+    bool validate_dna(std::string_view sequence);
 
     /**
      * @brief Calculate GC content percentage in a DNA sequence
      * 
      * Computes the percentage of Guanine (G) and Cytosine (C) nucleotides
-     * in the given DNA sequence. The calculation is case-insensitive.
+     * in the given DNA sequence. The calculation is case-insensitive and
+     * locale-independent, using a SIMD byte-classification kernel.
      * Returns 0.0 for empty sequences or sequences with no valid nucleotides.
      * 
-     * @param sequence The DNA sequence to analyze (passed by const reference)
+     * @param sequence The DNA sequence to analyze (non-owning view)
      * @return double GC content as a percentage (0.0 to 100.0)
      * 
      * Time Complexity: O(n) where n is the length of the sequence
@@ -108,13 +646,366 @@ namespace pystringpp {
      * double gc = calculate_gc_content("ATGC");
      * // gc == 50.0 (2 GC out of 4 total)
      */
-    double calculate_gc_content(const std::string& sequence);
+    double calculate_gc_content(std::string_view sequence);
+
+    /**
+     * @brief Per-nucleotide composition of a DNA sequence
+     * 
+     * Result of dna_stats(). Letters are counted case-insensitively; any
+     * other byte is counted only in length.
+     */
+    struct DnaStats {
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        bool valid = true;                ///< Same result as validate_dna()
+        std::size_t first_invalid = npos; ///< Offset of the first non-ACGT byte, npos if valid
+        std::size_t length = 0;           ///< Total number of bytes
+        std::size_t a = 0;
+        std::size_t c = 0;
+        std::size_t g = 0;
+        std::size_t t = 0;
+        std::size_t n = 0;                ///< Ambiguous base; makes the sequence invalid
+
+        /// GC content as a percentage, same result as calculate_gc_content()
+        double gc_content() const {
+            return length == 0 ? 0.0 : static_cast<double>(g + c) / static_cast<double>(length) * 100.0;
+        }
+    };
+
+    /**
+     * @brief Validate and count nucleotides in a single fused pass
+     * 
+     * Equivalent to calling validate_dna() and calculate_gc_content() plus
+     * counting each base, but reads the sequence only once. Bytes are
+     * classified with the same SIMD lookup-table kernels (SSSE3/AVX2) as
+     * those functions, with a scalar table fallback.
+     * 
+     * @param sequence The DNA sequence to analyze (non-owning view)
+     * @return DnaStats Validity, first invalid offset and per-base counts
+     * 
+     * Time Complexity: O(n) where n is the length of the sequence
+     * Space Complexity: O(1)
+     * 
+     * @example
+     * DnaStats stats = dna_stats("ACGTN");
+     * // stats.valid == false, stats.first_invalid == 4, stats.n == 1
+     */
+    DnaStats dna_stats(std::string_view sequence);
+
+    namespace detail {
+        class ByteSource;
+    }
+
+    /**
+     * @brief One FASTA/FASTQ record, viewing the reader's buffer
+     * 
+     * The views stay valid until the next call to SequenceReader::next().
+     */
+    struct SequenceRecord {
+        std::string_view name;     ///< Header line without the leading '>' or '@'
+        std::string_view sequence; ///< Sequence with line breaks removed
+        std::string_view quality;  ///< FASTQ quality string, empty for FASTA
+        DnaStats stats;            ///< dna_stats() of sequence
+    };
+
+    /**
+     * @brief Streaming FASTA/FASTQ parser
+     * 
+     * Reads the file through a fixed buffer and yields one record at a time,
+     * so memory use is bounded by the largest record rather than the file.
+     * Multi-line FASTA sequences are joined in place inside the buffer; no
+     * per-record allocation is made. FASTQ records must use the common
+     * four-line layout. Gzip-compressed input is detected by its magic bytes
+     * and decompressed on the fly when the library was built with zlib
+     * (PYSTRINGPP_HAVE_ZLIB).
+     * 
+     * Per-record DnaStats are computed as each record is parsed, and the
+     * running totals over all records so far are available from totals(),
+     * as if every sequence had been concatenated.
+     * 
+     * @example
+     * SequenceReader reader("reads.fastq.gz");
+     * SequenceRecord record;
+     * while (reader.next(record)) {
+     *     double gc = record.stats.gc_content();
+     * }
+     * double file_gc = reader.totals().gc_content();
+     */
+    class SequenceReader {
+    public:
+        enum class Format {
+            Auto,
+            Fasta,
+            Fastq
+        };
+
+        /**
+         * @brief Open a file for reading
+         * 
+         * @param path File to read (plain or gzip-compressed)
+         * @param format Record format; Auto decides from the first record
+         * @param buffer_size Initial buffer size; grows only to fit a longer record
+         * @throws std::runtime_error if the file cannot be opened, or is
+         *         gzip-compressed and zlib support was not built in
+         */
+        explicit SequenceReader(const std::string& path, Format format = Format::Auto,
+                                std::size_t buffer_size = std::size_t(1) << 20);
+        ~SequenceReader();
+
+        SequenceReader(const SequenceReader&) = delete;
+        SequenceReader& operator=(const SequenceReader&) = delete;
+
+        /**
+         * @brief Parse the next record
+         * 
+         * @return bool False at end of input (record is left unchanged)
+         * @throws std::runtime_error on malformed input or read errors
+         */
+        bool next(SequenceRecord& record);
+
+        /// Format in use; Auto until the first record has been read
+        Format format() const { return format_; }
+
+        /// Number of records returned so far
+        std::size_t records() const { return records_; }
+
+        /// DnaStats accumulated over every record returned so far
+        const DnaStats& totals() const { return totals_; }
+
+    private:
+        bool refill();
+        std::size_t available() const { return end_ - begin_; }
+        std::size_t find_newline(std::size_t from);
+        bool skip_blank_lines();
+        std::string_view line(std::size_t from, std::size_t to) const;
+        bool next_fasta(SequenceRecord& record);
+        bool next_fastq(SequenceRecord& record);
+
+        std::unique_ptr<detail::ByteSource> source_;
+        Format format_;
+
+        // Unconsumed input is buffer_[begin_, end_); offsets passed between
+        // the helpers are relative to begin_, since refill() moves the data
+        std::vector<char> buffer_;
+        std::size_t begin_ = 0;
+        std::size_t end_ = 0;
+        bool eof_ = false;
+
+        std::size_t records_ = 0;
+        DnaStats totals_;
+    };
+
+    /**
+     * @brief Matches of one pattern across a batch of texts, in CSR layout
+     * 
+     * Positions for text i are positions[offsets[i], offsets[i + 1]).
+     */
+    struct BatchMatches {
+        std::vector<std::size_t> offsets;
+        std::vector<std::size_t> positions;
+    };
+
+    /**
+     * @brief Batch variants: one call processes many records
+     * 
+     * Equivalent to calling the single-record function on every element, but
+     * setup (such as compiling the search pattern) is done once and the whole
+     * loop stays in C++, which matters when records are short and per-call
+     * overhead would dominate. The Python bindings accept either a sequence
+     * of texts or an Arrow-style (data, offsets) pair and return numpy arrays.
+     * 
+     * Time Complexity: O(total length) (plus O(m) once for find_pattern_batch)
+     */
+    std::vector<std::size_t> count_char_batch(const std::vector<std::string_view>& inputs, char c);
+    BatchMatches find_pattern_batch(const std::vector<std::string_view>& texts, std::string_view pattern);
+    std::vector<double> gc_content_batch(const std::vector<std::string_view>& sequences);
+    /// is_palindrome() of every input, 1 or 0
+    std::vector<std::uint8_t> is_palindrome_batch(const std::vector<std::string_view>& inputs);
+
+    /**
+     * @brief Name of the SIMD instruction set used by the vectorized kernels
+     * 
+     * One of "scalar", "sse2", "ssse3", "avx2" or "avx512bw". Detected from cpuid on
+     * first use and capped by the PYSTRINGPP_FORCE_SIMD environment variable.
+     * 
+     * @return const char* Static string naming the active kernel level
+     */
+    const char* simd_level();
+
+    /**
+     * @brief Compute the Levenshtein (edit) distance between two strings
+     * 
+     * Minimum number of single-byte insertions, deletions and substitutions
+     * turning str1 into str2. Common prefixes and suffixes are stripped first;
+     * the rest runs Myers' bit-parallel algorithm (Hyyro's formulation) with
+     * the shorter string as the pattern: a single 64-bit word when it is at
+     * most 64 bytes long, otherwise a blocked multi-word variant.
+     * 
+     * @param str1 First string (non-owning view)
+     * @param str2 Second string (non-owning view)
+     * @return std::size_t The edit distance
+     * 
+     * Time Complexity: O(ceil(m / 64) * n), m the shorter and n the longer length
+     * Space Complexity: O(ceil(m / 64) * 256) for the match bitmasks
+     * 
+     * @example
+     * std::size_t d = levenshtein_distance("kitten", "sitting");
+     * // d == 3
+     */
+    std::size_t levenshtein_distance(std::string_view str1, std::string_view str2);
+
+    /**
+     * @brief Check whether the Levenshtein distance is at most max_distance
+     * 
+     * Cheaper than levenshtein_distance() when only a small threshold matters.
+     * Rejects immediately when the lengths differ by more than max_distance,
+     * then fills only the diagonal band of width 2k + 1 (Ukkonen's cutoff),
+     * stopping as soon as no cell in a row can still finish within k. Falls
+     * back to the bit-parallel distance when the band would be wider than the
+     * bit-parallel pass.
+     * 
+     * @param str1 First string (non-owning view)
+     * @param str2 Second string (non-owning view)
+     * @param max_distance The threshold k
+     * @return bool True if levenshtein_distance(str1, str2) <= max_distance
+     * 
+     * Time Complexity: O(k * min(m, n)), and O(1) when |m - n| > k
+     * Space Complexity: O(n) for two DP rows
+     * 
+     * @example
+     * bool close = levenshtein_within("kitten", "sitting", 3);
+     * // close == true
+     */
+    bool levenshtein_within(std::string_view str1, std::string_view str2, std::size_t max_distance);
+
+    /**
+     * @brief Compute a longest common subsequence of two strings
+     * 
+     * Uses Hirschberg's divide-and-conquer algorithm: each level computes LCS
+     * length rows forwards over the first half of str1 and backwards over the
+     * second half, splits str2 where their sum peaks, and recurses. Only two
+     * rows are ever live, common prefixes and suffixes are emitted directly,
+     * and the result is appended into a buffer reserved to the exact LCS
+     * length (from lcs_length()). When several LCSs exist, any one of them
+     * may be returned.
+     * 
+     * @param str1 First string (non-owning view)
+     * @param str2 Second string (non-owning view)
+     * @return std::string A longest common subsequence
+     * 
+     * Time Complexity: O(m * n)
+     * Space Complexity: O(min(m, n)) plus the result
+     * 
+     * @example
+     * std::string lcs = longest_common_subsequence("ABCBDAB", "BDCABA");
+     * // lcs.length() == 4
+     */
+    std::string longest_common_subsequence(std::string_view str1, std::string_view str2);
+
+    /**
+     * @brief Length of the longest common subsequence, without building it
+     * 
+     * Bit-parallel Allison-Dix algorithm (in Hyyro's formulation) with the
+     * shorter string packed into 64-bit words, processing 64 DP cells per
+     * word operation.
+     * 
+     * @param str1 First string (non-owning view)
+     * @param str2 Second string (non-owning view)
+     * @return std::size_t The LCS length
+     * 
+     * Time Complexity: O(ceil(m / 64) * n), m the shorter and n the longer length
+     * Space Complexity: O(ceil(m / 64) * 256) for the match bitmasks
+     * 
+     * @example
+     * std::size_t len = lcs_length("ABCBDAB", "BDCABA");
+     * // len == 4
+     */
+    std::size_t lcs_length(std::string_view str1, std::string_view str2);
+
+    /**
+     * @brief Keep the first occurrence of every byte value, in input order
+     * 
+     * Tracks seen bytes in a 256-bit set; the result is reserved once and the
+     * scan stops as soon as all 256 byte values have been emitted.
+     * 
+     * @param input The string to deduplicate (non-owning view)
+     * @return std::string The distinct bytes in order of first occurrence
+     * 
+     * Time Complexity: O(n), and O(1) after the 256th distinct byte
+     * Space Complexity: O(1) besides the result (at most 256 bytes)
+     * 
+     * @example
+     * std::string s = remove_duplicates("programming");
+     * // s == "progamin"
+     */
+    std::string remove_duplicates(std::string_view input);
+
+    /**
+     * @brief Keep the first occurrence of every code point of UTF-8 text
+     * 
+     * Like remove_duplicates() but treats each UTF-8 sequence as one unit,
+     * so multi-byte characters are never split. ASCII is tracked in a
+     * 128-bit set, other code points in a hash set.
+     * 
+     * @param input UTF-8 text (non-owning view)
+     * @return std::string The distinct code points, UTF-8 encoded, in order of first occurrence
+     * @throws std::invalid_argument if input is not well-formed UTF-8
+     * 
+     * Time Complexity: O(n) expected
+     * Space Complexity: O(d) for d distinct non-ASCII code points
+     * 
+     * @example
+     * std::string s = remove_duplicates_utf8("αβα");
+     * // s == "αβ"
+     */
+    std::string remove_duplicates_utf8(std::string_view input);
+
+    /**
+     * @brief Check whether a string reads the same backwards, ignoring case and punctuation
+     * 
+     * Only ASCII letters and digits take part, compared case-insensitively;
+     * every other byte is skipped. Two pointers move inwards over the input
+     * itself, classifying bytes with a constexpr table (independent of the
+     * C locale), so nothing is allocated or copied.
+     * 
+     * @param input The string to check (non-owning view)
+     * @return bool True if the letters and digits form a palindrome
+     * 
+     * Time Complexity: O(n), stopping at the first mismatch
+     * Space Complexity: O(1)
+     * 
+     * @example
+     * bool p = is_palindrome("A man, a plan, a canal: Panama");
+     * // p == true
+     */
+    bool is_palindrome(std::string_view input);
+
+    /**
+     * @brief Unicode-aware is_palindrome() for UTF-8 text
+     * 
+     * Compares characters rather than bytes: letters and digits of any
+     * script take part, compared under simple Unicode case folding, and
+     * combining marks stay attached to the character they follow, so "é"
+     * written as e + U+0301 is one character. Punctuation, symbols, spaces
+     * and emoji are skipped. No canonical composition is applied: normalize
+     * the text to one form (e.g. NFC) first if it may mix them.
+     * 
+     * @param input UTF-8 text (non-owning view)
+     * @return bool True if the letters and digits form a palindrome
+     * @throws std::invalid_argument on malformed UTF-8 in the scanned part of input
+     * 
+     * Time Complexity: O(n)
+     * Space Complexity: O(1)
+     * 
+     * @example
+     * bool p = is_palindrome_utf8("А роза упала на лапу Азора");
+     * // p == true
+     */
+    bool is_palindrome_utf8(std::string_view input);
 
     // Legacy functions (maintained for backward compatibility)
-    std::unordered_map<char, int> count_chars(const std::string& input);
-    std::string remove_duplicates(const std::string& input);
-    bool is_palindrome(const std::string& input);
-    std::string longest_common_subsequence(const std::string& str1, const std::string& str2);
-    int levenshtein_distance(const std::string& str1, const std::string& str2);
+
+    /// Non-zero entries of byte_histogram() as a map
+    std::unordered_map<char, int> count_chars(std::string_view input);
 
 } // namespace pystringpp
\ No newline at end of file
@@ -0,0 +1,305 @@
+#include "pystringpp.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#if defined(PYSTRINGPP_HAVE_ZLIB)
+#include <zlib.h>
+#endif
+
+namespace pystringpp {
+
+namespace detail {
+
+    // Sequential byte input behind SequenceReader: a plain file, or a gzip
+    // stream when zlib is available
+    class ByteSource {
+    public:
+        virtual ~ByteSource() = default;
+
+        /// Read up to size bytes into out; returns 0 only at end of input
+        virtual std::size_t read(char* out, std::size_t size) = 0;
+    };
+
+} // namespace detail
+
+namespace {
+
+class FileSource : public detail::ByteSource {
+public:
+    explicit FileSource(const std::string& path) : file_(std::fopen(path.c_str(), "rb")) {
+        if (file_ == nullptr) {
+            throw std::runtime_error("cannot open " + path);
+        }
+        // The reader does its own buffering; stdio's would only add a copy
+        std::setvbuf(file_, nullptr, _IONBF, 0);
+    }
+    
+    ~FileSource() override {
+        std::fclose(file_);
+    }
+    
+    std::size_t read(char* out, std::size_t size) override {
+        const std::size_t got = std::fread(out, 1, size, file_);
+        if (got == 0 && std::ferror(file_)) {
+            throw std::runtime_error("error reading sequence file");
+        }
+        return got;
+    }
+    
+private:
+    std::FILE* file_;
+};
+
+#if defined(PYSTRINGPP_HAVE_ZLIB)
+class GzipSource : public detail::ByteSource {
+public:
+    explicit GzipSource(const std::string& path) : file_(gzopen(path.c_str(), "rb")) {
+        if (file_ == nullptr) {
+            throw std::runtime_error("cannot open " + path);
+        }
+        gzbuffer(file_, 1 << 17);
+    }
+    
+    ~GzipSource() override {
+        gzclose(file_);
+    }
+    
+    std::size_t read(char* out, std::size_t size) override {
+        // gzread takes an unsigned length and returns an int
+        const auto chunk = static_cast<unsigned>(
+            std::min<std::size_t>(size, static_cast<std::size_t>(std::numeric_limits<int>::max())));
+        const int got = gzread(file_, out, chunk);
+        if (got < 0) {
+            int code = 0;
+            throw std::runtime_error(std::string("error reading gzip stream: ") + gzerror(file_, &code));
+        }
+        return static_cast<std::size_t>(got);
+    }
+    
+private:
+    gzFile file_;
+};
+#endif
+
+bool is_gzip(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        throw std::runtime_error("cannot open " + path);
+    }
+    unsigned char magic[2] = {0, 0};
+    const std::size_t got = std::fread(magic, 1, 2, file);
+    std::fclose(file);
+    return got == 2 && magic[0] == 0x1f && magic[1] == 0x8b;
+}
+
+std::unique_ptr<detail::ByteSource> open_source(const std::string& path) {
+    if (!is_gzip(path)) {
+        return std::make_unique<FileSource>(path);
+    }
+#if defined(PYSTRINGPP_HAVE_ZLIB)
+    return std::make_unique<GzipSource>(path);
+#else
+    throw std::runtime_error(path + " is gzip-compressed, but pystringpp was built without zlib");
+#endif
+}
+
+bool is_space(char c) {
+    return c == '\n' || c == '\r' || c == ' ' || c == '\t';
+}
+
+} // namespace
+
+SequenceReader::SequenceReader(const std::string& path, Format format, std::size_t buffer_size)
+    : source_(open_source(path)),
+      format_(format),
+      buffer_(std::max<std::size_t>(buffer_size, 4096)) {}
+
+SequenceReader::~SequenceReader() = default;
+
+bool SequenceReader::refill() {
+    if (eof_) {
+        return false;
+    }
+    
+    // Slide the partial record to the front; grow only when it fills the
+    // whole buffer, so the size is bounded by the longest record
+    if (begin_ > 0) {
+        std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+        end_ -= begin_;
+        begin_ = 0;
+    }
+    if (end_ == buffer_.size()) {
+        buffer_.resize(buffer_.size() * 2);
+    }
+    
+    const std::size_t got = source_->read(buffer_.data() + end_, buffer_.size() - end_);
+    if (got == 0) {
+        eof_ = true;
+        return false;
+    }
+    end_ += got;
+    return true;
+}
+
+std::size_t SequenceReader::find_newline(std::size_t from) {
+    // Offset of the next '\n' at or after from, or available() at end of input
+    for (;;) {
+        if (from < available()) {
+            const char* data = buffer_.data() + begin_;
+            const void* hit = std::memchr(data + from, '\n', available() - from);
+            if (hit != nullptr) {
+                return static_cast<std::size_t>(static_cast<const char*>(hit) - data);
+            }
+            from = available();
+        }
+        if (!refill()) {
+            return available();
+        }
+    }
+}
+
+bool SequenceReader::skip_blank_lines() {
+    for (;;) {
+        while (begin_ < end_ && is_space(buffer_[begin_])) {
+            ++begin_;
+        }
+        if (begin_ < end_) {
+            return true;
+        }
+        if (!refill()) {
+            return false;
+        }
+    }
+}
+
+std::string_view SequenceReader::line(std::size_t from, std::size_t to) const {
+    // Tolerate CRLF line endings
+    if (to > from && buffer_[begin_ + to - 1] == '\r') {
+        --to;
+    }
+    return std::string_view(buffer_.data() + begin_ + from, to - from);
+}
+
+bool SequenceReader::next_fasta(SequenceRecord& record) {
+    if (!skip_blank_lines()) {
+        return false;
+    }
+    if (buffer_[begin_] != '>') {
+        throw std::runtime_error("malformed FASTA: record does not start with '>'");
+    }
+    
+    // The record runs up to the next line starting with '>', or end of input.
+    // Locate it before taking any views, since reading more moves the data.
+    const std::size_t header_end = find_newline(0);
+    std::size_t record_end = header_end;
+    while (record_end < available()) {
+        if (record_end + 1 == available() && !refill()) {
+            break;
+        }
+        if (buffer_[begin_ + record_end + 1] == '>') {
+            break;
+        }
+        record_end = find_newline(record_end + 1);
+    }
+    
+    record.name = line(1, header_end);
+    
+    // Join the sequence lines in place, over the newlines they leave behind
+    char* data = buffer_.data() + begin_;
+    const std::size_t sequence_begin = std::min(header_end + 1, available());
+    std::size_t write = sequence_begin;
+    std::size_t read = sequence_begin;
+    while (read < record_end) {
+        const void* hit = std::memchr(data + read, '\n', record_end - read);
+        const std::size_t line_end = hit != nullptr
+            ? static_cast<std::size_t>(static_cast<const char*>(hit) - data)
+            : record_end;
+        std::size_t length = line_end - read;
+        if (length > 0 && data[line_end - 1] == '\r') {
+            --length;
+        }
+        std::memmove(data + write, data + read, length);
+        write += length;
+        read = line_end + 1;
+    }
+    record.sequence = std::string_view(data + sequence_begin, write - sequence_begin);
+    record.quality = std::string_view();
+    
+    begin_ += std::min(record_end + 1, available());
+    return true;
+}
+
+bool SequenceReader::next_fastq(SequenceRecord& record) {
+    if (!skip_blank_lines()) {
+        return false;
+    }
+    if (buffer_[begin_] != '@') {
+        throw std::runtime_error("malformed FASTQ: record does not start with '@'");
+    }
+    
+    // Header, sequence, '+' separator and quality lines; the last one may
+    // end at end of input without a newline
+    std::size_t line_ends[4];
+    std::size_t from = 0;
+    for (int k = 0; k < 4; ++k) {
+        line_ends[k] = find_newline(from);
+        if (line_ends[k] == available() && k < 3) {
+            throw std::runtime_error("malformed FASTQ: truncated record");
+        }
+        from = line_ends[k] + 1;
+    }
+    if (buffer_[begin_ + line_ends[1] + 1] != '+') {
+        throw std::runtime_error("malformed FASTQ: missing '+' separator line");
+    }
+    
+    record.name = line(1, line_ends[0]);
+    record.sequence = line(line_ends[0] + 1, line_ends[1]);
+    record.quality = line(line_ends[2] + 1, line_ends[3]);
+    if (record.quality.size() != record.sequence.size()) {
+        throw std::runtime_error("malformed FASTQ: quality and sequence lengths differ");
+    }
+    
+    begin_ += std::min(line_ends[3] + 1, available());
+    return true;
+}
+
+bool SequenceReader::next(SequenceRecord& record) {
+    if (format_ == Format::Auto) {
+        if (!skip_blank_lines()) {
+            return false;
+        }
+        if (buffer_[begin_] == '>') {
+            format_ = Format::Fasta;
+        } else if (buffer_[begin_] == '@') {
+            format_ = Format::Fastq;
+        } else {
+            throw std::runtime_error("unrecognized sequence format: expected '>' (FASTA) or '@' (FASTQ)");
+        }
+    }
+    
+    const bool found = format_ == Format::Fasta ? next_fasta(record) : next_fastq(record);
+    if (!found) {
+        return false;
+    }
+    
+    record.stats = dna_stats(record.sequence);
+    
+    // Totals describe all sequences so far as if concatenated
+    if (totals_.valid && !record.stats.valid) {
+        totals_.valid = false;
+        totals_.first_invalid = totals_.length + record.stats.first_invalid;
+    }
+    totals_.length += record.stats.length;
+    totals_.a += record.stats.a;
+    totals_.c += record.stats.c;
+    totals_.g += record.stats.g;
+    totals_.t += record.stats.t;
+    totals_.n += record.stats.n;
+    ++records_;
+    return true;
+}
+
+} // namespace pystringpp
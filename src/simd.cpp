@@ -0,0 +1,845 @@
+#include "simd.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if PYSTRINGPP_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace pystringpp {
+namespace detail {
+
+namespace {
+
+#if PYSTRINGPP_X86
+
+void cpuid(unsigned int leaf, unsigned int subleaf, unsigned int regs[4]) {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int k = 0; k < 4; ++k) {
+        regs[k] = static_cast<unsigned int>(info[k]);
+    }
+#else
+    if (!__get_cpuid_count(leaf, subleaf, &regs[0], &regs[1], &regs[2], &regs[3])) {
+        regs[0] = regs[1] = regs[2] = regs[3] = 0;
+    }
+#endif
+}
+
+// Extended control register 0: which register files the OS saves on context switch
+std::uint64_t read_xcr0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned int eax = 0;
+    unsigned int edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<std::uint64_t>(edx) << 32) | eax;
+#endif
+}
+
+SimdLevel query_cpu() {
+    unsigned int regs[4];
+    cpuid(0, 0, regs);
+    const unsigned int max_leaf = regs[0];
+
+    cpuid(1, 0, regs);
+    const bool sse2 = (regs[3] >> 26) & 1;
+    const bool ssse3 = (regs[2] >> 9) & 1;
+    const bool osxsave = (regs[2] >> 27) & 1;
+    const bool avx = (regs[2] >> 28) & 1;
+    if (!sse2) {
+        return SimdLevel::Scalar;
+    }
+    const SimdLevel baseline = ssse3 ? SimdLevel::SSSE3 : SimdLevel::SSE2;
+    if (!osxsave || !avx || max_leaf < 7) {
+        return baseline;
+    }
+
+    const std::uint64_t xcr0 = read_xcr0();
+    const bool ymm_state = (xcr0 & 0x6) == 0x6;
+    const bool zmm_state = (xcr0 & 0xE6) == 0xE6;
+
+    cpuid(7, 0, regs);
+    const bool avx2 = (regs[1] >> 5) & 1;
+    const bool avx512f = (regs[1] >> 16) & 1;
+    const bool avx512bw = (regs[1] >> 30) & 1;
+
+    if (avx512f && avx512bw && zmm_state) {
+        return SimdLevel::AVX512BW;
+    }
+    if (avx2 && ymm_state) {
+        return SimdLevel::AVX2;
+    }
+    return baseline;
+}
+
+#else
+
+SimdLevel query_cpu() {
+    return SimdLevel::Scalar;
+}
+
+#endif
+
+SimdLevel parse_level(const char* name, SimdLevel fallback) {
+    const SimdLevel levels[] = {
+        SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::SSSE3, SimdLevel::AVX2, SimdLevel::AVX512BW
+    };
+    for (SimdLevel level : levels) {
+        if (std::strcmp(name, simd_level_name(level)) == 0) {
+            return level;
+        }
+    }
+    return fallback;
+}
+
+// DNA byte classes: one bit per nucleotide, 0 for anything else. The same
+// bits are produced by the scalar table and the SIMD nibble lookups.
+constexpr std::uint8_t kDnaA = 1;
+constexpr std::uint8_t kDnaC = 2;
+constexpr std::uint8_t kDnaG = 4;
+constexpr std::uint8_t kDnaT = 8;
+constexpr std::uint8_t kDnaN = 16;
+constexpr std::uint8_t kDnaValid = kDnaA | kDnaC | kDnaG | kDnaT;
+constexpr std::uint8_t kDnaGC = kDnaC | kDnaG;
+constexpr std::uint8_t kDnaBits[5] = {kDnaA, kDnaC, kDnaG, kDnaT, kDnaN};
+
+struct DnaClassTable {
+    std::uint8_t classes[256];
+};
+
+constexpr DnaClassTable make_dna_class_table() {
+    DnaClassTable table{};
+    const char upper[] = "ACGTN";
+    const char lower[] = "acgtn";
+    for (int k = 0; k < 5; ++k) {
+        table.classes[static_cast<unsigned char>(upper[k])] = kDnaBits[k];
+        table.classes[static_cast<unsigned char>(lower[k])] = kDnaBits[k];
+    }
+    return table;
+}
+
+constexpr DnaClassTable kDnaClasses = make_dna_class_table();
+
+// 0x20 for a lowercase ASCII letter, whose uppercase form differs only in
+// that bit; 0 for every other byte
+constexpr unsigned ascii_case_bit(char byte) {
+    return byte >= 'a' && byte <= 'z' ? 0x20u : 0u;
+}
+
+#if PYSTRINGPP_X86
+
+unsigned int trailing_zeros(std::uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned int>(index);
+#else
+    return static_cast<unsigned int>(__builtin_ctz(mask));
+#endif
+}
+
+// Horizontal sum of byte counters, via psadbw against zero
+PYSTRINGPP_TARGET("sse2")
+std::size_t sum_bytes_sse2(__m128i counters) {
+    alignas(16) std::uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_sad_epu8(counters, _mm_setzero_si128()));
+    return static_cast<std::size_t>(lanes[0] + lanes[1]);
+}
+
+PYSTRINGPP_TARGET("avx2")
+std::size_t sum_bytes_avx2(__m256i counters) {
+    alignas(32) std::uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_sad_epu8(counters, _mm256_setzero_si256()));
+    return static_cast<std::size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+}
+
+// The vector count kernels share one scheme: compare a block against the
+// broadcast needle (matching lanes become 0xFF == -1) and subtract the result
+// from per-byte accumulators. A byte lane overflows after 255 blocks, so the
+// accumulators are flushed into 64-bit sums with psadbw at least that often.
+constexpr std::size_t kMaxBlocksPerFlush = 255;
+
+PYSTRINGPP_TARGET("sse2")
+std::size_t count_byte_sse2(const char* data, std::size_t size, char c) {
+    const __m128i needle = _mm_set1_epi8(c);
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t count = 0;
+    std::size_t i = 0;
+
+    while (size - i >= 16) {
+        const std::size_t blocks = std::min((size - i) / 16, kMaxBlocksPerFlush);
+        __m128i acc = zero;
+        for (std::size_t b = 0; b < blocks; ++b, i += 16) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            acc = _mm_sub_epi8(acc, _mm_cmpeq_epi8(chunk, needle));
+        }
+        count += sum_bytes_sse2(acc);
+    }
+
+    return count + count_byte_scalar(data + i, size - i, c);
+}
+
+PYSTRINGPP_TARGET("avx2")
+std::size_t count_byte_avx2(const char* data, std::size_t size, char c) {
+    const __m256i needle = _mm256_set1_epi8(c);
+    const __m256i zero = _mm256_setzero_si256();
+    std::size_t count = 0;
+    std::size_t i = 0;
+
+    while (size - i >= 32) {
+        const std::size_t blocks = std::min((size - i) / 32, kMaxBlocksPerFlush);
+        __m256i acc = zero;
+        for (std::size_t b = 0; b < blocks; ++b, i += 32) {
+            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            acc = _mm256_sub_epi8(acc, _mm256_cmpeq_epi8(chunk, needle));
+        }
+        count += sum_bytes_avx2(acc);
+    }
+
+    return count + count_byte_scalar(data + i, size - i, c);
+}
+
+// Horizontal sum of the eight psadbw lanes (stored rather than using
+// _mm512_reduce_add_epi64, which trips -Wmaybe-uninitialized in GCC headers)
+PYSTRINGPP_TARGET("avx512f,avx512bw")
+std::size_t sum_sad_lanes_avx512(__m512i sums) {
+    alignas(64) std::uint64_t lanes[8];
+    _mm512_store_si512(lanes, sums);
+    std::uint64_t total = 0;
+    for (std::uint64_t lane : lanes) {
+        total += lane;
+    }
+    return static_cast<std::size_t>(total);
+}
+
+PYSTRINGPP_TARGET("avx512f,avx512bw")
+std::size_t count_byte_avx512bw(const char* data, std::size_t size, char c) {
+    const __m512i needle = _mm512_set1_epi8(c);
+    const __m512i zero = _mm512_setzero_si512();
+    std::size_t count = 0;
+    std::size_t i = 0;
+
+    while (size - i >= 64) {
+        const std::size_t blocks = std::min((size - i) / 64, kMaxBlocksPerFlush);
+        __m512i acc = zero;
+        for (std::size_t b = 0; b < blocks; ++b, i += 64) {
+            const __m512i chunk = _mm512_loadu_si512(data + i);
+            acc = _mm512_sub_epi8(acc, _mm512_movm_epi8(_mm512_cmpeq_epi8_mask(chunk, needle)));
+        }
+        count += sum_sad_lanes_avx512(_mm512_sad_epu8(acc, zero));
+    }
+
+    // Masked load and compare for the tail, so no scalar loop is needed
+    if (i < size) {
+        const __mmask64 tail = (~0ULL) >> (64 - (size - i));
+        const __m512i chunk = _mm512_maskz_loadu_epi8(tail, data + i);
+        const __m512i hits = _mm512_movm_epi8(_mm512_mask_cmpeq_epi8_mask(tail, chunk, needle));
+        count += sum_sad_lanes_avx512(_mm512_sad_epu8(_mm512_sub_epi8(zero, hits), zero));
+    }
+
+    return count;
+}
+
+// DNA classification with two pshufb nibble lookups: the low-nibble table
+// gives the candidate nucleotide, the high-nibble table the letters allowed
+// in that row of ASCII (0x4_/0x6_: A C G N, 0x5_/0x7_: T), and their AND is
+// the class bit, or 0 for any other byte (bytes >= 0x80 hit a zero row).
+constexpr std::uint8_t kDnaRowACGN = kDnaA | kDnaC | kDnaG | kDnaN;
+
+PYSTRINGPP_TARGET("ssse3")
+__m128i dna_low_table() {
+    return _mm_setr_epi8(0, kDnaA, 0, kDnaC, kDnaT, 0, 0, kDnaG, 0, 0, 0, 0, 0, 0, kDnaN, 0);
+}
+
+PYSTRINGPP_TARGET("ssse3")
+__m128i dna_high_table() {
+    return _mm_setr_epi8(0, 0, 0, 0, kDnaRowACGN, kDnaT, kDnaRowACGN, kDnaT, 0, 0, 0, 0, 0, 0, 0, 0);
+}
+
+PYSTRINGPP_TARGET("ssse3")
+__m128i classify_dna_ssse3(__m128i bytes, __m128i low_table, __m128i high_table) {
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    const __m128i low = _mm_and_si128(bytes, nibble);
+    const __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble);
+    return _mm_and_si128(_mm_shuffle_epi8(low_table, low), _mm_shuffle_epi8(high_table, high));
+}
+
+PYSTRINGPP_TARGET("ssse3")
+std::size_t dna_first_invalid_ssse3(const char* data, std::size_t size) {
+    const __m128i low_table = dna_low_table();
+    const __m128i high_table = dna_high_table();
+    const __m128i valid = _mm_set1_epi8(static_cast<char>(kDnaValid));
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t i = 0;
+    
+    for (; size - i >= 16; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i classes = classify_dna_ssse3(bytes, low_table, high_table);
+        const auto invalid = static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(classes, valid), zero)));
+        if (invalid != 0) {
+            return i + trailing_zeros(invalid);
+        }
+    }
+    
+    return i + dna_first_invalid_scalar(data + i, size - i);
+}
+
+PYSTRINGPP_TARGET("ssse3")
+std::size_t count_gc_ssse3(const char* data, std::size_t size) {
+    const __m128i low_table = dna_low_table();
+    const __m128i high_table = dna_high_table();
+    const __m128i gc = _mm_set1_epi8(static_cast<char>(kDnaGC));
+    const __m128i one = _mm_set1_epi8(1);
+    std::size_t count = 0;
+    std::size_t i = 0;
+    
+    while (size - i >= 16) {
+        const std::size_t blocks = std::min((size - i) / 16, kMaxBlocksPerFlush);
+        __m128i acc = _mm_setzero_si128();
+        for (std::size_t b = 0; b < blocks; ++b, i += 16) {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            const __m128i classes = classify_dna_ssse3(bytes, low_table, high_table);
+            acc = _mm_add_epi8(acc, _mm_min_epu8(_mm_and_si128(classes, gc), one));
+        }
+        count += sum_bytes_sse2(acc);
+    }
+    
+    return count + count_gc_scalar(data + i, size - i);
+}
+
+PYSTRINGPP_TARGET("ssse3")
+std::size_t dna_stats_ssse3(const char* data, std::size_t size, std::size_t counts[5]) {
+    const __m128i low_table = dna_low_table();
+    const __m128i high_table = dna_high_table();
+    const __m128i valid = _mm_set1_epi8(static_cast<char>(kDnaValid));
+    const __m128i zero = _mm_setzero_si128();
+    __m128i bits[5];
+    for (int k = 0; k < 5; ++k) {
+        bits[k] = _mm_set1_epi8(static_cast<char>(kDnaBits[k]));
+    }
+    std::size_t first_invalid = size;
+    std::size_t i = 0;
+    
+    while (size - i >= 16) {
+        const std::size_t blocks = std::min((size - i) / 16, kMaxBlocksPerFlush);
+        __m128i acc[5] = {zero, zero, zero, zero, zero};
+        for (std::size_t b = 0; b < blocks; ++b, i += 16) {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            const __m128i classes = classify_dna_ssse3(bytes, low_table, high_table);
+            if (first_invalid == size) {
+                const auto invalid = static_cast<std::uint32_t>(
+                    _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(classes, valid), zero)));
+                if (invalid != 0) {
+                    first_invalid = i + trailing_zeros(invalid);
+                }
+            }
+            for (int k = 0; k < 5; ++k) {
+                acc[k] = _mm_sub_epi8(acc[k], _mm_cmpeq_epi8(classes, bits[k]));
+            }
+        }
+        for (int k = 0; k < 5; ++k) {
+            counts[k] += sum_bytes_sse2(acc[k]);
+        }
+    }
+    
+    const std::size_t tail_invalid = dna_stats_scalar(data + i, size - i, counts);
+    if (first_invalid == size) {
+        first_invalid = i + tail_invalid;
+    }
+    return first_invalid;
+}
+
+// AVX2 versions: vpshufb looks up within each 128-bit lane, so the nibble
+// tables are broadcast to both lanes
+PYSTRINGPP_TARGET("avx2")
+__m256i classify_dna_avx2(__m256i bytes, __m256i low_table, __m256i high_table) {
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i low = _mm256_and_si256(bytes, nibble);
+    const __m256i high = _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibble);
+    return _mm256_and_si256(_mm256_shuffle_epi8(low_table, low), _mm256_shuffle_epi8(high_table, high));
+}
+
+PYSTRINGPP_TARGET("avx2")
+std::size_t dna_first_invalid_avx2(const char* data, std::size_t size) {
+    const __m256i low_table = _mm256_broadcastsi128_si256(dna_low_table());
+    const __m256i high_table = _mm256_broadcastsi128_si256(dna_high_table());
+    const __m256i valid = _mm256_set1_epi8(static_cast<char>(kDnaValid));
+    const __m256i zero = _mm256_setzero_si256();
+    std::size_t i = 0;
+    
+    for (; size - i >= 32; i += 32) {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const __m256i classes = classify_dna_avx2(bytes, low_table, high_table);
+        const auto invalid = static_cast<std::uint32_t>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(classes, valid), zero)));
+        if (invalid != 0) {
+            return i + trailing_zeros(invalid);
+        }
+    }
+    
+    return i + dna_first_invalid_scalar(data + i, size - i);
+}
+
+PYSTRINGPP_TARGET("avx2")
+std::size_t count_gc_avx2(const char* data, std::size_t size) {
+    const __m256i low_table = _mm256_broadcastsi128_si256(dna_low_table());
+    const __m256i high_table = _mm256_broadcastsi128_si256(dna_high_table());
+    const __m256i gc = _mm256_set1_epi8(static_cast<char>(kDnaGC));
+    const __m256i one = _mm256_set1_epi8(1);
+    std::size_t count = 0;
+    std::size_t i = 0;
+    
+    while (size - i >= 32) {
+        const std::size_t blocks = std::min((size - i) / 32, kMaxBlocksPerFlush);
+        __m256i acc = _mm256_setzero_si256();
+        for (std::size_t b = 0; b < blocks; ++b, i += 32) {
+            const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            const __m256i classes = classify_dna_avx2(bytes, low_table, high_table);
+            acc = _mm256_add_epi8(acc, _mm256_min_epu8(_mm256_and_si256(classes, gc), one));
+        }
+        count += sum_bytes_avx2(acc);
+    }
+    
+    return count + count_gc_scalar(data + i, size - i);
+}
+
+PYSTRINGPP_TARGET("avx2")
+std::size_t dna_stats_avx2(const char* data, std::size_t size, std::size_t counts[5]) {
+    const __m256i low_table = _mm256_broadcastsi128_si256(dna_low_table());
+    const __m256i high_table = _mm256_broadcastsi128_si256(dna_high_table());
+    const __m256i valid = _mm256_set1_epi8(static_cast<char>(kDnaValid));
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i bits[5];
+    for (int k = 0; k < 5; ++k) {
+        bits[k] = _mm256_set1_epi8(static_cast<char>(kDnaBits[k]));
+    }
+    std::size_t first_invalid = size;
+    std::size_t i = 0;
+    
+    while (size - i >= 32) {
+        const std::size_t blocks = std::min((size - i) / 32, kMaxBlocksPerFlush);
+        __m256i acc[5] = {zero, zero, zero, zero, zero};
+        for (std::size_t b = 0; b < blocks; ++b, i += 32) {
+            const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            const __m256i classes = classify_dna_avx2(bytes, low_table, high_table);
+            if (first_invalid == size) {
+                const auto invalid = static_cast<std::uint32_t>(
+                    _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(classes, valid), zero)));
+                if (invalid != 0) {
+                    first_invalid = i + trailing_zeros(invalid);
+                }
+            }
+            for (int k = 0; k < 5; ++k) {
+                acc[k] = _mm256_sub_epi8(acc[k], _mm256_cmpeq_epi8(classes, bits[k]));
+            }
+        }
+        for (int k = 0; k < 5; ++k) {
+            counts[k] += sum_bytes_avx2(acc[k]);
+        }
+    }
+    
+    const std::size_t tail_invalid = dna_stats_scalar(data + i, size - i, counts);
+    if (first_invalid == size) {
+        first_invalid = i + tail_invalid;
+    }
+    return first_invalid;
+}
+
+// Generic SIMD substring prefilter: compare two needle bytes at their
+// offsets for a whole vector of candidate starts at once
+PYSTRINGPP_TARGET("sse2")
+std::size_t find_byte_pair_sse2(const char* data, std::size_t count, std::size_t offset1, char byte1,
+                                std::size_t offset2, char byte2) {
+    const __m128i first = _mm_set1_epi8(byte1);
+    const __m128i second = _mm_set1_epi8(byte2);
+    std::size_t i = 0;
+    
+    for (; count - i >= 16; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + offset1));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + offset2));
+        const auto hits = static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, second))));
+        if (hits != 0) {
+            return i + trailing_zeros(hits);
+        }
+    }
+    
+    return i + find_byte_pair_scalar(data + i, count - i, offset1, byte1, offset2, byte2);
+}
+
+PYSTRINGPP_TARGET("avx2")
+std::size_t find_byte_pair_avx2(const char* data, std::size_t count, std::size_t offset1, char byte1,
+                                std::size_t offset2, char byte2) {
+    const __m256i first = _mm256_set1_epi8(byte1);
+    const __m256i second = _mm256_set1_epi8(byte2);
+    std::size_t i = 0;
+    
+    for (; count - i >= 32; i += 32) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + offset1));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + offset2));
+        const auto hits = static_cast<std::uint32_t>(
+            _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, second))));
+        if (hits != 0) {
+            return i + trailing_zeros(hits);
+        }
+    }
+    
+    return i + find_byte_pair_scalar(data + i, count - i, offset1, byte1, offset2, byte2);
+}
+
+// Case-insensitive prefilter: OR-ing 0x20 into a text byte maps exactly 'A'
+// and 'a' to 'a', so letters compare as (x | 0x20) and other bytes as x
+PYSTRINGPP_TARGET("sse2")
+std::size_t find_byte_pair_fold_sse2(const char* data, std::size_t count, std::size_t offset1, char byte1,
+                                     std::size_t offset2, char byte2) {
+    const __m128i first = _mm_set1_epi8(byte1);
+    const __m128i second = _mm_set1_epi8(byte2);
+    const __m128i fold1 = _mm_set1_epi8(static_cast<char>(ascii_case_bit(byte1)));
+    const __m128i fold2 = _mm_set1_epi8(static_cast<char>(ascii_case_bit(byte2)));
+    std::size_t i = 0;
+    
+    for (; count - i >= 16; i += 16) {
+        const __m128i a = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + offset1)), fold1);
+        const __m128i b = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + offset2)), fold2);
+        const auto hits = static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, second))));
+        if (hits != 0) {
+            return i + trailing_zeros(hits);
+        }
+    }
+    
+    return i + find_byte_pair_fold_scalar(data + i, count - i, offset1, byte1, offset2, byte2);
+}
+
+PYSTRINGPP_TARGET("avx2")
+std::size_t find_byte_pair_fold_avx2(const char* data, std::size_t count, std::size_t offset1, char byte1,
+                                     std::size_t offset2, char byte2) {
+    const __m256i first = _mm256_set1_epi8(byte1);
+    const __m256i second = _mm256_set1_epi8(byte2);
+    const __m256i fold1 = _mm256_set1_epi8(static_cast<char>(ascii_case_bit(byte1)));
+    const __m256i fold2 = _mm256_set1_epi8(static_cast<char>(ascii_case_bit(byte2)));
+    std::size_t i = 0;
+    
+    for (; count - i >= 32; i += 32) {
+        const __m256i a = _mm256_or_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + offset1)), fold1);
+        const __m256i b = _mm256_or_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + offset2)), fold2);
+        const auto hits = static_cast<std::uint32_t>(
+            _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, second))));
+        if (hits != 0) {
+            return i + trailing_zeros(hits);
+        }
+    }
+    
+    return i + find_byte_pair_fold_sse2(data + i, count - i, offset1, byte1, offset2, byte2);
+}
+
+// Byte reversal: pshufb reverses the bytes of each 128-bit lane; AVX2 also
+// swaps the two lanes. The in-place variants swap a block from each end per
+// step, so every byte is read and written exactly once.
+PYSTRINGPP_TARGET("ssse3")
+__m128i reverse_bytes_ssse3(__m128i v) {
+    return _mm_shuffle_epi8(v, _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+PYSTRINGPP_TARGET("ssse3")
+void reverse_copy_ssse3(const char* data, std::size_t size, char* out) {
+    std::size_t i = 0;
+    for (; size - i >= 16; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + size - i - 16), reverse_bytes_ssse3(v));
+    }
+    reverse_copy_scalar(data + i, size - i, out);
+}
+
+PYSTRINGPP_TARGET("ssse3")
+void reverse_inplace_ssse3(char* data, std::size_t size) {
+    std::size_t lo = 0;
+    std::size_t hi = size;
+    for (; hi - lo >= 32; lo += 16, hi -= 16) {
+        const __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + lo));
+        const __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + hi - 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + lo), reverse_bytes_ssse3(tail));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + hi - 16), reverse_bytes_ssse3(head));
+    }
+    reverse_inplace_scalar(data + lo, hi - lo);
+}
+
+PYSTRINGPP_TARGET("avx2")
+__m256i reverse_bytes_avx2(__m256i v) {
+    const __m256i mask = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                          15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, mask), 0x4e);
+}
+
+PYSTRINGPP_TARGET("avx2")
+void reverse_copy_avx2(const char* data, std::size_t size, char* out) {
+    std::size_t i = 0;
+    for (; size - i >= 32; i += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + size - i - 32), reverse_bytes_avx2(v));
+    }
+    reverse_copy_ssse3(data + i, size - i, out);
+}
+
+PYSTRINGPP_TARGET("avx2")
+void reverse_inplace_avx2(char* data, std::size_t size) {
+    std::size_t lo = 0;
+    std::size_t hi = size;
+    for (; hi - lo >= 64; lo += 32, hi -= 32) {
+        const __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + lo));
+        const __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + hi - 32));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + lo), reverse_bytes_avx2(tail));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + hi - 32), reverse_bytes_avx2(head));
+    }
+    reverse_inplace_ssse3(data + lo, hi - lo);
+}
+
+// ASCII run: movemask collects the high bit of every byte, which is set on
+// exactly the UTF-8 lead and continuation bytes
+PYSTRINGPP_TARGET("sse2")
+std::size_t ascii_prefix_sse2(const char* data, std::size_t size) {
+    std::size_t i = 0;
+    for (; size - i >= 16; i += 16) {
+        const auto high = static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i))));
+        if (high != 0) {
+            return i + trailing_zeros(high);
+        }
+    }
+    return i + ascii_prefix_scalar(data + i, size - i);
+}
+
+PYSTRINGPP_TARGET("avx2")
+std::size_t ascii_prefix_avx2(const char* data, std::size_t size) {
+    std::size_t i = 0;
+    for (; size - i >= 32; i += 32) {
+        const auto high = static_cast<std::uint32_t>(
+            _mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i))));
+        if (high != 0) {
+            return i + trailing_zeros(high);
+        }
+    }
+    return i + ascii_prefix_sse2(data + i, size - i);
+}
+
+#endif
+
+Kernels resolve_kernels() {
+    Kernels table{};
+    table.level = detect_simd_level();
+    table.count_byte = count_byte_scalar;
+    table.dna_first_invalid = dna_first_invalid_scalar;
+    table.count_gc = count_gc_scalar;
+    table.dna_stats = dna_stats_scalar;
+    table.find_byte_pair = find_byte_pair_scalar;
+    table.find_byte_pair_fold = find_byte_pair_fold_scalar;
+    table.reverse_copy = reverse_copy_scalar;
+    table.reverse_inplace = reverse_inplace_scalar;
+    table.ascii_prefix = ascii_prefix_scalar;
+
+#if PYSTRINGPP_X86
+    // Each level overrides the kernels it has a better variant for
+    if (table.level >= SimdLevel::SSE2) {
+        table.count_byte = count_byte_sse2;
+        table.find_byte_pair = find_byte_pair_sse2;
+        table.find_byte_pair_fold = find_byte_pair_fold_sse2;
+        table.ascii_prefix = ascii_prefix_sse2;
+    }
+    if (table.level >= SimdLevel::SSSE3) {
+        table.dna_first_invalid = dna_first_invalid_ssse3;
+        table.count_gc = count_gc_ssse3;
+        table.dna_stats = dna_stats_ssse3;
+        table.reverse_copy = reverse_copy_ssse3;
+        table.reverse_inplace = reverse_inplace_ssse3;
+    }
+    if (table.level >= SimdLevel::AVX2) {
+        table.count_byte = count_byte_avx2;
+        table.dna_first_invalid = dna_first_invalid_avx2;
+        table.count_gc = count_gc_avx2;
+        table.dna_stats = dna_stats_avx2;
+        table.find_byte_pair = find_byte_pair_avx2;
+        table.find_byte_pair_fold = find_byte_pair_fold_avx2;
+        table.reverse_copy = reverse_copy_avx2;
+        table.reverse_inplace = reverse_inplace_avx2;
+        table.ascii_prefix = ascii_prefix_avx2;
+    }
+    if (table.level >= SimdLevel::AVX512BW) {
+        table.count_byte = count_byte_avx512bw;
+    }
+#endif
+
+    return table;
+}
+
+} // namespace
+
+SimdLevel detect_simd_level() {
+    const SimdLevel hardware = query_cpu();
+    const char* forced = std::getenv("PYSTRINGPP_FORCE_SIMD");
+    if (forced == nullptr) {
+        return hardware;
+    }
+    // Only ever lower the level; requesting more than the CPU has is ignored
+    return std::min(parse_level(forced, hardware), hardware);
+}
+
+const char* simd_level_name(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SSE2:
+            return "sse2";
+        case SimdLevel::SSSE3:
+            return "ssse3";
+        case SimdLevel::AVX2:
+            return "avx2";
+        case SimdLevel::AVX512BW:
+            return "avx512bw";
+        case SimdLevel::Scalar:
+        default:
+            return "scalar";
+    }
+}
+
+const Kernels& kernels() {
+    static const Kernels table = resolve_kernels();
+    return table;
+}
+
+std::size_t count_byte_scalar(const char* data, std::size_t size, char c) {
+    return static_cast<std::size_t>(std::count(data, data + size, c));
+}
+
+std::size_t dna_first_invalid_scalar(const char* data, std::size_t size) {
+    for (std::size_t i = 0; i < size; ++i) {
+        if ((kDnaClasses.classes[static_cast<unsigned char>(data[i])] & kDnaValid) == 0) {
+            return i;
+        }
+    }
+    return size;
+}
+
+std::size_t count_gc_scalar(const char* data, std::size_t size) {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        count += (kDnaClasses.classes[static_cast<unsigned char>(data[i])] & kDnaGC) != 0 ? 1 : 0;
+    }
+    return count;
+}
+
+std::size_t dna_stats_scalar(const char* data, std::size_t size, std::size_t counts[5]) {
+    std::size_t first_invalid = size;
+    for (std::size_t i = 0; i < size; ++i) {
+        const std::uint8_t cls = kDnaClasses.classes[static_cast<unsigned char>(data[i])];
+        if ((cls & kDnaValid) == 0 && first_invalid == size) {
+            first_invalid = i;
+        }
+        for (int k = 0; k < 5; ++k) {
+            counts[k] += cls == kDnaBits[k] ? 1 : 0;
+        }
+    }
+    return first_invalid;
+}
+
+std::size_t find_byte_pair_scalar(const char* data, std::size_t count, std::size_t offset1, char byte1,
+                                  std::size_t offset2, char byte2) {
+    // memchr for the first byte, then check the second
+    const char* first = data + offset1;
+    std::size_t i = 0;
+    while (i < count) {
+        const void* hit = std::memchr(first + i, byte1, count - i);
+        if (hit == nullptr) {
+            return count;
+        }
+        i = static_cast<std::size_t>(static_cast<const char*>(hit) - first);
+        if (data[i + offset2] == byte2) {
+            return i;
+        }
+        ++i;
+    }
+    return count;
+}
+
+std::size_t find_byte_pair_fold_scalar(const char* data, std::size_t count, std::size_t offset1, char byte1,
+                                       std::size_t offset2, char byte2) {
+    const unsigned fold1 = ascii_case_bit(byte1);
+    const unsigned fold2 = ascii_case_bit(byte2);
+    const auto* first = reinterpret_cast<const unsigned char*>(data + offset1);
+    const auto* second = reinterpret_cast<const unsigned char*>(data + offset2);
+    for (std::size_t i = 0; i < count; ++i) {
+        if ((first[i] | fold1) == static_cast<unsigned char>(byte1) &&
+            (second[i] | fold2) == static_cast<unsigned char>(byte2)) {
+            return i;
+        }
+    }
+    return count;
+}
+
+namespace {
+
+std::uint64_t load_swapped(const char* data) {
+    std::uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+#if defined(_MSC_VER)
+    return _byteswap_uint64(word);
+#else
+    return __builtin_bswap64(word);
+#endif
+}
+
+void store_word(char* data, std::uint64_t word) {
+    std::memcpy(data, &word, sizeof(word));
+}
+
+} // namespace
+
+void reverse_copy_scalar(const char* data, std::size_t size, char* out) {
+    std::size_t i = 0;
+    for (; size - i >= 8; i += 8) {
+        store_word(out + size - i - 8, load_swapped(data + i));
+    }
+    for (; i < size; ++i) {
+        out[size - i - 1] = data[i];
+    }
+}
+
+void reverse_inplace_scalar(char* data, std::size_t size) {
+    std::size_t lo = 0;
+    std::size_t hi = size;
+    for (; hi - lo >= 16; lo += 8, hi -= 8) {
+        const std::uint64_t head = load_swapped(data + lo);
+        const std::uint64_t tail = load_swapped(data + hi - 8);
+        store_word(data + lo, tail);
+        store_word(data + hi - 8, head);
+    }
+    std::reverse(data + lo, data + hi);
+}
+
+std::size_t ascii_prefix_scalar(const char* data, std::size_t size) {
+    std::size_t i = 0;
+    for (; size - i >= 8; i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        if ((word & 0x8080808080808080ull) != 0) {
+            break;
+        }
+    }
+    while (i < size && static_cast<unsigned char>(data[i]) < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+} // namespace detail
+} // namespace pystringpp
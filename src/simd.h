@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @file simd.h
+ * @brief Internal SIMD kernels and runtime CPU dispatch
+ *
+ * Not part of the public API. Every vectorized kernel has a scalar
+ * reference implementation with the same signature; the best variant
+ * supported by the running CPU is selected once and cached in the
+ * kernel table returned by kernels().
+ */
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PYSTRINGPP_X86 1
+#else
+#define PYSTRINGPP_X86 0
+#endif
+
+// GCC/Clang need per-function target attributes to emit wider instructions
+// without raising the baseline of the whole translation unit. MSVC accepts
+// the intrinsics unconditionally.
+#if PYSTRINGPP_X86 && (defined(__GNUC__) || defined(__clang__))
+#define PYSTRINGPP_TARGET(isa) __attribute__((target(isa)))
+#else
+#define PYSTRINGPP_TARGET(isa)
+#endif
+
+// Opt-in function multiversioning (CMake option PYSTRINGPP_MULTIVERSION):
+// scalar hot loops marked with this are compiled once per listed ISA and the
+// best clone is picked through an ifunc when the library loads. Needs
+// GCC/Clang on an ELF target with ifunc support; a no-op everywhere else.
+#if defined(PYSTRINGPP_ENABLE_MULTIVERSION) && PYSTRINGPP_X86 && defined(__linux__) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define PYSTRINGPP_MULTIVERSION __attribute__((target_clones("default", "popcnt", "arch=haswell", "arch=skylake-avx512")))
+#else
+#define PYSTRINGPP_MULTIVERSION
+#endif
+
+namespace pystringpp {
+namespace detail {
+
+    /**
+     * @brief Instruction set levels understood by the dispatcher, ordered
+     * from least to most capable
+     */
+    enum class SimdLevel {
+        Scalar,
+        SSE2,
+        SSSE3,
+        AVX2,
+        AVX512BW
+    };
+
+    /**
+     * @brief Query the CPU (and OS register state support) for the best level
+     *
+     * The result can be capped with the PYSTRINGPP_FORCE_SIMD environment
+     * variable ("scalar", "sse2", "ssse3", "avx2", "avx512bw"), which is how
+     * the test suite exercises every path on a single machine.
+     */
+    SimdLevel detect_simd_level();
+
+    /// Human-readable name of a level, e.g. "avx2"
+    const char* simd_level_name(SimdLevel level);
+
+    /**
+     * @brief Function table filled in once with the best kernels for this CPU
+     */
+    struct Kernels {
+        SimdLevel level;
+        std::size_t (*count_byte)(const char* data, std::size_t size, char c);
+
+        // DNA kernels. Bytes are classified as A, C, G, T, N (either case) or
+        // invalid; "valid" means A, C, G or T only.
+        std::size_t (*dna_first_invalid)(const char* data, std::size_t size);
+        std::size_t (*count_gc)(const char* data, std::size_t size);
+        std::size_t (*dna_stats)(const char* data, std::size_t size, std::size_t counts[5]);
+
+        // Substring prefilter: first i < count with data[i + offset1] == byte1
+        // and data[i + offset2] == byte2, or count. The caller guarantees
+        // data[count - 1 + max(offset1, offset2)] is readable.
+        std::size_t (*find_byte_pair)(const char* data, std::size_t count, std::size_t offset1, char byte1,
+                                      std::size_t offset2, char byte2);
+
+        // As find_byte_pair, but an ASCII letter (given in lowercase) also
+        // matches its uppercase form; other bytes match exactly
+        std::size_t (*find_byte_pair_fold)(const char* data, std::size_t count, std::size_t offset1, char byte1,
+                                           std::size_t offset2, char byte2);
+
+        // Byte reversal: into a separate (non-overlapping) buffer, or in place
+        void (*reverse_copy)(const char* data, std::size_t size, char* out);
+        void (*reverse_inplace)(char* data, std::size_t size);
+
+        // Length of the leading run of ASCII bytes (below 0x80), i.e. the
+        // offset of the first UTF-8 lead or continuation byte, or size
+        std::size_t (*ascii_prefix)(const char* data, std::size_t size);
+    };
+
+    /// Resolve (on first use) and return the dispatch table
+    const Kernels& kernels();
+
+    // Scalar reference kernels, always available
+    std::size_t count_byte_scalar(const char* data, std::size_t size, char c);
+
+    /// Offset of the first byte that is not A/C/G/T (any case), or size
+    std::size_t dna_first_invalid_scalar(const char* data, std::size_t size);
+
+    /// Number of G/C bytes (any case)
+    std::size_t count_gc_scalar(const char* data, std::size_t size);
+
+    /// Adds A, C, G, T, N counts (any case) into counts[0..4] and returns the
+    /// offset of the first byte that is not A/C/G/T, or size
+    std::size_t dna_stats_scalar(const char* data, std::size_t size, std::size_t counts[5]);
+
+    /// First candidate start for the substring prefilter (see Kernels), or count
+    std::size_t find_byte_pair_scalar(const char* data, std::size_t count, std::size_t offset1, char byte1,
+                                      std::size_t offset2, char byte2);
+
+    /// ASCII case-insensitive find_byte_pair_scalar (see Kernels)
+    std::size_t find_byte_pair_fold_scalar(const char* data, std::size_t count, std::size_t offset1, char byte1,
+                                           std::size_t offset2, char byte2);
+
+    /// Writes data[0, size) reversed to out[0, size); the buffers must not overlap
+    void reverse_copy_scalar(const char* data, std::size_t size, char* out);
+
+    /// Reverses data[0, size) in place
+    void reverse_inplace_scalar(char* data, std::size_t size);
+
+    /// Offset of the first byte >= 0x80, or size
+    std::size_t ascii_prefix_scalar(const char* data, std::size_t size);
+
+} // namespace detail
+} // namespace pystringpp
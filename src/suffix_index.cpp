@@ -0,0 +1,388 @@
+#include "pystringpp.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+namespace pystringpp {
+
+namespace {
+
+constexpr std::uint32_t kEmpty = 0xFFFFFFFF;
+
+// Suffix arrays of very short sequences by direct comparison
+template <typename Sequence>
+std::vector<std::uint32_t> sort_suffixes_naive(const Sequence& s, std::uint32_t n) {
+    std::vector<std::uint32_t> sa(n);
+    for (std::uint32_t i = 0; i < n; ++i) {
+        sa[i] = i;
+    }
+    std::sort(sa.begin(), sa.end(), [&](std::uint32_t l, std::uint32_t r) {
+        if (l == r) {
+            return false;
+        }
+        while (l < n && r < n) {
+            if (s[l] != s[r]) {
+                return s[l] < s[r];
+            }
+            ++l;
+            ++r;
+        }
+        return l == n;
+    });
+    return sa;
+}
+
+// SA-IS over s[0, n) with symbols in [0, upper]. Suffixes are typed S
+// (smaller than the next suffix) or L; the leftmost S of each run (LMS) is
+// placed at the end of its bucket and induced sorting orders the L and then
+// the S suffixes from them. That orders the LMS substrings, which are named
+// and, unless all names are distinct, sorted by recursing on the reduced
+// string; a final induce from the sorted LMS suffixes gives the array.
+template <typename Sequence>
+std::vector<std::uint32_t> sa_is(const Sequence& s, std::uint32_t n, std::uint32_t upper) {
+    if (n < 10) {
+        return sort_suffixes_naive(s, n);
+    }
+
+    std::vector<bool> is_s(n, false);
+    for (std::uint32_t i = n - 1; i-- > 0;) {
+        is_s[i] = s[i] == s[i + 1] ? is_s[i + 1] : s[i] < s[i + 1];
+    }
+
+    // Bucket c holds the L suffixes starting with c followed by the S ones:
+    // sum_l[c] is where its L part starts and sum_s[c] where its S part does
+    std::vector<std::uint32_t> sum_l(upper + 1, 0);
+    std::vector<std::uint32_t> sum_s(upper + 1, 0);
+    for (std::uint32_t i = 0; i < n; ++i) {
+        if (!is_s[i]) {
+            ++sum_s[s[i]];
+        } else {
+            ++sum_l[s[i] + 1];
+        }
+    }
+    for (std::uint32_t c = 0; c <= upper; ++c) {
+        sum_s[c] += sum_l[c];
+        if (c < upper) {
+            sum_l[c + 1] += sum_s[c];
+        }
+    }
+
+    std::vector<std::uint32_t> sa(n);
+    std::vector<std::uint32_t> buf(upper + 1);
+    auto induce = [&](const std::vector<std::uint32_t>& lms) {
+        std::fill(sa.begin(), sa.end(), kEmpty);
+        std::copy(sum_s.begin(), sum_s.end(), buf.begin());
+        for (const std::uint32_t d : lms) {
+            sa[buf[s[d]]++] = d;
+        }
+        std::copy(sum_l.begin(), sum_l.end(), buf.begin());
+        sa[buf[s[n - 1]]++] = n - 1;
+        for (std::uint32_t i = 0; i < n; ++i) {
+            const std::uint32_t v = sa[i];
+            if (v != kEmpty && v >= 1 && !is_s[v - 1]) {
+                sa[buf[s[v - 1]]++] = v - 1;
+            }
+        }
+        std::copy(sum_l.begin(), sum_l.end(), buf.begin());
+        for (std::uint32_t i = n; i-- > 0;) {
+            const std::uint32_t v = sa[i];
+            if (v != kEmpty && v >= 1 && is_s[v - 1]) {
+                sa[--buf[s[v - 1] + 1]] = v - 1;
+            }
+        }
+    };
+
+    std::vector<std::uint32_t> lms_index(n, kEmpty);
+    std::vector<std::uint32_t> lms;
+    for (std::uint32_t i = 1; i < n; ++i) {
+        if (!is_s[i - 1] && is_s[i]) {
+            lms_index[i] = static_cast<std::uint32_t>(lms.size());
+            lms.push_back(i);
+        }
+    }
+    const auto m = static_cast<std::uint32_t>(lms.size());
+    induce(lms);
+    if (m == 0) {
+        return sa;
+    }
+
+    std::vector<std::uint32_t> sorted_lms;
+    sorted_lms.reserve(m);
+    for (const std::uint32_t v : sa) {
+        if (lms_index[v] != kEmpty) {
+            sorted_lms.push_back(v);
+        }
+    }
+
+    // Name each LMS substring (from one LMS position to the next) by its
+    // rank, giving equal substrings equal names
+    std::vector<std::uint32_t> reduced(m);
+    std::uint32_t reduced_upper = 0;
+    reduced[lms_index[sorted_lms[0]]] = 0;
+    for (std::uint32_t i = 1; i < m; ++i) {
+        std::uint32_t l = sorted_lms[i - 1];
+        std::uint32_t r = sorted_lms[i];
+        const std::uint32_t end_l = lms_index[l] + 1 < m ? lms[lms_index[l] + 1] : n;
+        const std::uint32_t end_r = lms_index[r] + 1 < m ? lms[lms_index[r] + 1] : n;
+        bool same = end_l - l == end_r - r;
+        if (same) {
+            while (l < end_l && s[l] == s[r]) {
+                ++l;
+                ++r;
+            }
+            if (l == n || r == n || s[l] != s[r]) {
+                same = false;
+            }
+        }
+        if (!same) {
+            ++reduced_upper;
+        }
+        reduced[lms_index[sorted_lms[i]]] = reduced_upper;
+    }
+
+    const std::vector<std::uint32_t> reduced_sa = sa_is(reduced, m, reduced_upper);
+    for (std::uint32_t i = 0; i < m; ++i) {
+        sorted_lms[i] = lms[reduced_sa[i]];
+    }
+    induce(sorted_lms);
+    return sa;
+}
+
+// LCP array from the suffix array through the permuted LCP (Karkkainen,
+// Manzini and Puglisi): plcp[i] = lcp of suffix i and the suffix before it
+// in sorted order satisfies plcp[i] >= plcp[i - 1] - 1, so a sweep over
+// text order does O(n) comparisons. Blocks of text order start from 0
+// instead of the previous value and run independently on the pool.
+std::vector<std::uint32_t> build_lcp(const std::string& text, const std::vector<std::uint32_t>& sa,
+                                     std::size_t threads) {
+    const std::size_t n = sa.size();
+    std::vector<std::uint32_t> lcp(n, 0);
+    if (n < 2) {
+        return lcp;
+    }
+
+    auto& pool = detail::ThreadPool::shared();
+    if (threads == 0) {
+        threads = pool.size() + 1;
+    }
+    constexpr std::size_t kMinBlock = std::size_t(1) << 16;
+    const std::size_t blocks = std::max<std::size_t>(1, std::min(threads * 4, n / kMinBlock));
+    const std::size_t block = (n + blocks - 1) / blocks;
+    auto for_blocks = [&](auto&& fn) {
+        pool.parallel_for(blocks, threads, [&](std::size_t k) {
+            const std::size_t begin = k * block;
+            fn(begin, std::min(n, begin + block));
+        });
+    };
+
+    // phi[sa[i]] = sa[i - 1], then overwritten in place by plcp
+    std::vector<std::uint32_t> phi(n);
+    for_blocks([&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = std::max<std::size_t>(begin, 1); i < end; ++i) {
+            phi[sa[i]] = sa[i - 1];
+        }
+    });
+    phi[sa[0]] = kEmpty;
+
+    const char* data = text.data();
+    for_blocks([&](std::size_t begin, std::size_t end) {
+        std::size_t h = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+            const std::uint32_t prev = phi[i];
+            if (prev == kEmpty) {
+                h = 0;
+                phi[i] = 0;
+                continue;
+            }
+            while (i + h < n && prev + h < n && data[i + h] == data[prev + h]) {
+                ++h;
+            }
+            phi[i] = static_cast<std::uint32_t>(h);
+            h = h > 0 ? h - 1 : 0;
+        }
+    });
+
+    for_blocks([&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = std::max<std::size_t>(begin, 1); i < end; ++i) {
+            lcp[i] = phi[sa[i]];
+        }
+    });
+    return lcp;
+}
+
+// On-disk layout, all in native byte order: magic, byte order mark, n,
+// then the n text bytes, n suffix array entries and n LCP entries
+constexpr char kMagic[8] = {'P', 'S', 'P', 'P', 'S', 'F', 'X', '1'};
+constexpr std::uint32_t kByteOrderMark = 0x01020304;
+constexpr std::uint64_t kHeaderSize = sizeof(kMagic) + sizeof(kByteOrderMark) + sizeof(std::uint64_t);
+
+class File {
+public:
+    File(const std::string& path, const char* mode) : path_(path), file_(std::fopen(path.c_str(), mode)) {
+        if (file_ == nullptr) {
+            throw std::runtime_error("cannot open " + path);
+        }
+    }
+
+    ~File() {
+        if (file_ != nullptr) {
+            std::fclose(file_);
+        }
+    }
+
+    File(const File&) = delete;
+    File& operator=(const File&) = delete;
+
+    void read(void* out, std::size_t size) {
+        if (std::fread(out, 1, size, file_) != size) {
+            throw std::runtime_error("truncated suffix index " + path_);
+        }
+    }
+
+    void write(const void* data, std::size_t size) {
+        if (std::fwrite(data, 1, size, file_) != size) {
+            throw std::runtime_error("error writing " + path_);
+        }
+    }
+
+    void close() {
+        const int status = std::fclose(file_);
+        file_ = nullptr;
+        if (status != 0) {
+            throw std::runtime_error("error writing " + path_);
+        }
+    }
+
+private:
+    std::string path_;
+    std::FILE* file_;
+};
+
+} // namespace
+
+SuffixIndex::SuffixIndex(std::string text, std::size_t threads) : text_(std::move(text)) {
+    if (text_.size() >= kEmpty) {
+        throw std::length_error("SuffixIndex: text must be shorter than 4 GiB");
+    }
+    const auto n = static_cast<std::uint32_t>(text_.size());
+    if (n > 0) {
+        suffix_array_ = sa_is(reinterpret_cast<const unsigned char*>(text_.data()), n, 255);
+    }
+    lcp_ = build_lcp(text_, suffix_array_, threads);
+}
+
+SuffixIndex SuffixIndex::load(const std::string& path) {
+    File file(path, "rb");
+    char magic[sizeof(kMagic)];
+    std::uint32_t byte_order = 0;
+    std::uint64_t n = 0;
+    file.read(magic, sizeof(magic));
+    if (std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error(path + " is not a suffix index");
+    }
+    file.read(&byte_order, sizeof(byte_order));
+    if (byte_order != kByteOrderMark) {
+        throw std::runtime_error(path + " was written with a different byte order");
+    }
+    file.read(&n, sizeof(n));
+
+    // Check n against the file size before allocating for it, so a corrupt
+    // header cannot ask for gigabytes
+    std::error_code error;
+    const std::uint64_t file_size = std::filesystem::file_size(path, error);
+    if (error || n >= kEmpty || file_size < kHeaderSize || file_size - kHeaderSize != n * 9) {
+        throw std::runtime_error("corrupt suffix index " + path);
+    }
+
+    SuffixIndex index;
+    index.text_.resize(n);
+    index.suffix_array_.resize(n);
+    index.lcp_.resize(n);
+    file.read(&index.text_[0], n);
+    file.read(index.suffix_array_.data(), n * sizeof(std::uint32_t));
+    file.read(index.lcp_.data(), n * sizeof(std::uint32_t));
+
+    // Queries index the text by suffix array entries, so the array must be
+    // a permutation of [0, n)
+    std::vector<bool> seen(n, false);
+    for (const std::uint32_t start : index.suffix_array_) {
+        if (start >= n || seen[start]) {
+            throw std::runtime_error("corrupt suffix index " + path);
+        }
+        seen[start] = true;
+    }
+    return index;
+}
+
+void SuffixIndex::save(const std::string& path) const {
+    File file(path, "wb");
+    const std::uint64_t n = text_.size();
+    file.write(kMagic, sizeof(kMagic));
+    file.write(&kByteOrderMark, sizeof(kByteOrderMark));
+    file.write(&n, sizeof(n));
+    file.write(text_.data(), text_.size());
+    file.write(suffix_array_.data(), suffix_array_.size() * sizeof(std::uint32_t));
+    file.write(lcp_.data(), lcp_.size() * sizeof(std::uint32_t));
+    file.close();
+}
+
+std::pair<std::size_t, std::size_t> SuffixIndex::range(std::string_view pattern) const {
+    const std::size_t n = text_.size();
+    const std::size_t m = pattern.size();
+    if (m == 0 || m > n) {
+        return {0, 0};
+    }
+
+    // Binary search for the first suffix that compares after pattern, or
+    // with include_matches also after any suffix starting with it. Every
+    // suffix between the bounds shares min(lcp_left, lcp_right) bytes with
+    // pattern, so comparisons resume there (Manber and Myers).
+    auto bound = [&](std::size_t left_end, bool include_matches) {
+        // lcp_left / lcp_right are shared with the suffixes at left - 1 and
+        // right; 0 while those lie outside the array
+        std::size_t left = left_end;
+        std::size_t right = n;
+        std::size_t lcp_left = 0;
+        std::size_t lcp_right = 0;
+        while (left < right) {
+            const std::size_t mid = left + (right - left) / 2;
+            const std::size_t start = suffix_array_[mid];
+            const std::size_t limit = std::min(m, n - start);
+            std::size_t j = std::min(lcp_left, lcp_right);
+            while (j < limit && text_[start + j] == pattern[j]) {
+                ++j;
+            }
+            const bool before = j == m ? include_matches
+                                       : j == limit || static_cast<unsigned char>(text_[start + j]) <
+                                                           static_cast<unsigned char>(pattern[j]);
+            if (before) {
+                left = mid + 1;
+                lcp_left = j;
+            } else {
+                right = mid;
+                lcp_right = j;
+            }
+        }
+        return left;
+    };
+
+    const std::size_t first = bound(0, false);
+    return {first, bound(first, true)};
+}
+
+std::vector<std::size_t> SuffixIndex::locate(std::string_view pattern) const {
+    const auto [first, last] = range(pattern);
+    std::vector<std::size_t> positions(suffix_array_.begin() + first, suffix_array_.begin() + last);
+    std::sort(positions.begin(), positions.end());
+    return positions;
+}
+
+std::size_t SuffixIndex::count(std::string_view pattern) const {
+    const auto [first, last] = range(pattern);
+    return last - first;
+}
+
+} // namespace pystringpp
@@ -0,0 +1,125 @@
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace pystringpp {
+namespace detail {
+
+namespace {
+
+// State shared between a parallel_for caller and the helpers it enlisted.
+// Helpers may still be dequeued after the caller returns, so it is reference
+// counted, and fn is only touched after successfully claiming a task.
+struct ForState {
+    std::atomic<std::size_t> next{0};
+    std::size_t tasks = 0;
+    const std::function<void(std::size_t)>* fn = nullptr;
+    
+    std::mutex mutex;
+    std::condition_variable done;
+    std::size_t finished = 0;
+    std::exception_ptr error;
+    
+    void drain() {
+        std::size_t ran = 0;
+        std::exception_ptr failure;
+        for (std::size_t i = next++; i < tasks; i = next++) {
+            try {
+                (*fn)(i);
+            } catch (...) {
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+            }
+            ++ran;
+        }
+        if (ran == 0) {
+            return;
+        }
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        if (failure && !error) {
+            error = failure;
+        }
+        finished += ran;
+        if (finished == tasks) {
+            done.notify_all();
+        }
+    }
+};
+
+} // namespace
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    return pool;
+}
+
+ThreadPool::ThreadPool(std::size_t workers) : stopping_(false) {
+    workers_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+        workers_.emplace_back([this] { worker_loop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::worker_loop() {
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                return;
+            }
+            job = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        job();
+    }
+}
+
+void ThreadPool::parallel_for(std::size_t tasks, std::size_t threads,
+                              const std::function<void(std::size_t)>& fn) {
+    if (tasks == 0) {
+        return;
+    }
+    
+    auto state = std::make_shared<ForState>();
+    state->tasks = tasks;
+    state->fn = &fn;
+    
+    const std::size_t helpers = std::min({threads > 0 ? threads - 1 : 0, workers_.size(), tasks - 1});
+    if (helpers > 0) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (std::size_t i = 0; i < helpers; ++i) {
+                queue_.emplace_back([state] { state->drain(); });
+            }
+        }
+        wake_.notify_all();
+    }
+    
+    state->drain();
+    
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&state] { return state->finished == state->tasks; });
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+} // namespace detail
+} // namespace pystringpp
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file thread_pool.h
+ * @brief Internal fixed-size worker pool shared by the parallel algorithms
+ *
+ * Not part of the public API. Workers are started once (on first use of
+ * shared()) and reused by every parallel call, so a parallel search does not
+ * pay thread creation costs.
+ */
+
+namespace pystringpp {
+namespace detail {
+
+    class ThreadPool {
+    public:
+        /// Process-wide pool with hardware_concurrency() - 1 workers
+        static ThreadPool& shared();
+
+        explicit ThreadPool(std::size_t workers);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Run fn(0) .. fn(tasks - 1), blocking until all have finished
+         *
+         * Uses at most `threads` threads including the caller, which always
+         * takes part, so nested calls cannot deadlock. The first exception
+         * thrown by fn is rethrown in the caller after all tasks complete.
+         */
+        void parallel_for(std::size_t tasks, std::size_t threads,
+                          const std::function<void(std::size_t)>& fn);
+
+        /// Number of worker threads (not counting callers)
+        std::size_t size() const { return workers_.size(); }
+
+    private:
+        void worker_loop();
+
+        std::vector<std::thread> workers_;
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::deque<std::function<void()>> queue_;
+        bool stopping_;
+    };
+
+} // namespace detail
+} // namespace pystringpp
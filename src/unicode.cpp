@@ -0,0 +1,1166 @@
+#include "unicode.h"
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+
+namespace pystringpp {
+namespace detail {
+
+namespace {
+
+// Simple case folding as ranges of uppercase code points. Offset ranges add
+// `delta`; alternating ranges hold upper/lower pairs where the uppercase
+// letter sits at the even (or odd) code point and folds to the next one.
+enum class FoldKind : std::uint8_t {
+    Offset,
+    EvenUpper,
+    OddUpper
+};
+
+struct FoldRange {
+    char32_t first;
+    char32_t last;
+    FoldKind kind;
+    std::int32_t delta;
+};
+
+// Every C and S (simple) mapping of CaseFolding.txt, sorted by first code
+// point and non-overlapping. Regenerate with scripts/generate_unicode_tables.py
+constexpr FoldRange kFoldRanges[] = {
+    // BEGIN GENERATED FOLDS (Unicode 14.0.0)
+    {0x0041, 0x005a, FoldKind::Offset, 32},         // Basic Latin
+    {0x00b5, 0x00b5, FoldKind::Offset, 775},        // Latin-1 Supplement
+    {0x00c0, 0x00d6, FoldKind::Offset, 32},
+    {0x00d8, 0x00de, FoldKind::Offset, 32},
+    {0x0100, 0x012e, FoldKind::EvenUpper, 1},       // Latin Extended-A
+    {0x0132, 0x0136, FoldKind::EvenUpper, 1},
+    {0x0139, 0x0147, FoldKind::OddUpper, 1},
+    {0x014a, 0x0176, FoldKind::EvenUpper, 1},
+    {0x0178, 0x0178, FoldKind::Offset, -121},
+    {0x0179, 0x017d, FoldKind::OddUpper, 1},
+    {0x017f, 0x017f, FoldKind::Offset, -268},
+    {0x0181, 0x0181, FoldKind::Offset, 210},        // Latin Extended-B
+    {0x0182, 0x0184, FoldKind::EvenUpper, 1},
+    {0x0186, 0x0186, FoldKind::Offset, 206},
+    {0x0187, 0x0187, FoldKind::Offset, 1},
+    {0x0189, 0x018a, FoldKind::Offset, 205},
+    {0x018b, 0x018b, FoldKind::Offset, 1},
+    {0x018e, 0x018e, FoldKind::Offset, 79},
+    {0x018f, 0x018f, FoldKind::Offset, 202},
+    {0x0190, 0x0190, FoldKind::Offset, 203},
+    {0x0191, 0x0191, FoldKind::Offset, 1},
+    {0x0193, 0x0193, FoldKind::Offset, 205},
+    {0x0194, 0x0194, FoldKind::Offset, 207},
+    {0x0196, 0x0196, FoldKind::Offset, 211},
+    {0x0197, 0x0197, FoldKind::Offset, 209},
+    {0x0198, 0x0198, FoldKind::Offset, 1},
+    {0x019c, 0x019c, FoldKind::Offset, 211},
+    {0x019d, 0x019d, FoldKind::Offset, 213},
+    {0x019f, 0x019f, FoldKind::Offset, 214},
+    {0x01a0, 0x01a4, FoldKind::EvenUpper, 1},
+    {0x01a6, 0x01a6, FoldKind::Offset, 218},
+    {0x01a7, 0x01a7, FoldKind::Offset, 1},
+    {0x01a9, 0x01a9, FoldKind::Offset, 218},
+    {0x01ac, 0x01ac, FoldKind::Offset, 1},
+    {0x01ae, 0x01ae, FoldKind::Offset, 218},
+    {0x01af, 0x01af, FoldKind::Offset, 1},
+    {0x01b1, 0x01b2, FoldKind::Offset, 217},
+    {0x01b3, 0x01b5, FoldKind::OddUpper, 1},
+    {0x01b7, 0x01b7, FoldKind::Offset, 219},
+    {0x01b8, 0x01b8, FoldKind::Offset, 1},
+    {0x01bc, 0x01bc, FoldKind::Offset, 1},
+    {0x01c4, 0x01c4, FoldKind::Offset, 2},
+    {0x01c5, 0x01c5, FoldKind::Offset, 1},
+    {0x01c7, 0x01c7, FoldKind::Offset, 2},
+    {0x01c8, 0x01c8, FoldKind::Offset, 1},
+    {0x01ca, 0x01ca, FoldKind::Offset, 2},
+    {0x01cb, 0x01db, FoldKind::OddUpper, 1},
+    {0x01de, 0x01ee, FoldKind::EvenUpper, 1},
+    {0x01f1, 0x01f1, FoldKind::Offset, 2},
+    {0x01f2, 0x01f4, FoldKind::EvenUpper, 1},
+    {0x01f6, 0x01f6, FoldKind::Offset, -97},
+    {0x01f7, 0x01f7, FoldKind::Offset, -56},
+    {0x01f8, 0x021e, FoldKind::EvenUpper, 1},
+    {0x0220, 0x0220, FoldKind::Offset, -130},
+    {0x0222, 0x0232, FoldKind::EvenUpper, 1},
+    {0x023a, 0x023a, FoldKind::Offset, 10795},
+    {0x023b, 0x023b, FoldKind::Offset, 1},
+    {0x023d, 0x023d, FoldKind::Offset, -163},
+    {0x023e, 0x023e, FoldKind::Offset, 10792},
+    {0x0241, 0x0241, FoldKind::Offset, 1},
+    {0x0243, 0x0243, FoldKind::Offset, -195},
+    {0x0244, 0x0244, FoldKind::Offset, 69},
+    {0x0245, 0x0245, FoldKind::Offset, 71},
+    {0x0246, 0x024e, FoldKind::EvenUpper, 1},
+    {0x0345, 0x0345, FoldKind::Offset, 116},        // Combining Diacritical Marks
+    {0x0370, 0x0372, FoldKind::EvenUpper, 1},       // Greek and Coptic
+    {0x0376, 0x0376, FoldKind::Offset, 1},
+    {0x037f, 0x037f, FoldKind::Offset, 116},
+    {0x0386, 0x0386, FoldKind::Offset, 38},
+    {0x0388, 0x038a, FoldKind::Offset, 37},
+    {0x038c, 0x038c, FoldKind::Offset, 64},
+    {0x038e, 0x038f, FoldKind::Offset, 63},
+    {0x0391, 0x03a1, FoldKind::Offset, 32},
+    {0x03a3, 0x03ab, FoldKind::Offset, 32},
+    {0x03c2, 0x03c2, FoldKind::Offset, 1},
+    {0x03cf, 0x03cf, FoldKind::Offset, 8},
+    {0x03d0, 0x03d0, FoldKind::Offset, -30},
+    {0x03d1, 0x03d1, FoldKind::Offset, -25},
+    {0x03d5, 0x03d5, FoldKind::Offset, -15},
+    {0x03d6, 0x03d6, FoldKind::Offset, -22},
+    {0x03d8, 0x03ee, FoldKind::EvenUpper, 1},
+    {0x03f0, 0x03f0, FoldKind::Offset, -54},
+    {0x03f1, 0x03f1, FoldKind::Offset, -48},
+    {0x03f4, 0x03f4, FoldKind::Offset, -60},
+    {0x03f5, 0x03f5, FoldKind::Offset, -64},
+    {0x03f7, 0x03f7, FoldKind::Offset, 1},
+    {0x03f9, 0x03f9, FoldKind::Offset, -7},
+    {0x03fa, 0x03fa, FoldKind::Offset, 1},
+    {0x03fd, 0x03ff, FoldKind::Offset, -130},
+    {0x0400, 0x040f, FoldKind::Offset, 80},         // Cyrillic
+    {0x0410, 0x042f, FoldKind::Offset, 32},
+    {0x0460, 0x0480, FoldKind::EvenUpper, 1},
+    {0x048a, 0x04be, FoldKind::EvenUpper, 1},
+    {0x04c0, 0x04c0, FoldKind::Offset, 15},
+    {0x04c1, 0x04cd, FoldKind::OddUpper, 1},
+    {0x04d0, 0x052e, FoldKind::EvenUpper, 1},
+    {0x0531, 0x0556, FoldKind::Offset, 48},         // Armenian
+    {0x10a0, 0x10c5, FoldKind::Offset, 7264},       // Georgian
+    {0x10c7, 0x10c7, FoldKind::Offset, 7264},
+    {0x10cd, 0x10cd, FoldKind::Offset, 7264},
+    {0x13f8, 0x13fd, FoldKind::Offset, -8},         // Cherokee
+    {0x1c80, 0x1c80, FoldKind::Offset, -6222},      // Cyrillic Extended-C
+    {0x1c81, 0x1c81, FoldKind::Offset, -6221},
+    {0x1c82, 0x1c82, FoldKind::Offset, -6212},
+    {0x1c83, 0x1c84, FoldKind::Offset, -6210},
+    {0x1c85, 0x1c85, FoldKind::Offset, -6211},
+    {0x1c86, 0x1c86, FoldKind::Offset, -6204},
+    {0x1c87, 0x1c87, FoldKind::Offset, -6180},
+    {0x1c88, 0x1c88, FoldKind::Offset, 35267},
+    {0x1c90, 0x1cba, FoldKind::Offset, -3008},      // Georgian Extended
+    {0x1cbd, 0x1cbf, FoldKind::Offset, -3008},
+    {0x1e00, 0x1e94, FoldKind::EvenUpper, 1},       // Latin Extended Additional
+    {0x1e9b, 0x1e9b, FoldKind::Offset, -58},
+    {0x1e9e, 0x1e9e, FoldKind::Offset, -7615},
+    {0x1ea0, 0x1efe, FoldKind::EvenUpper, 1},
+    {0x1f08, 0x1f0f, FoldKind::Offset, -8},         // Greek Extended
+    {0x1f18, 0x1f1d, FoldKind::Offset, -8},
+    {0x1f28, 0x1f2f, FoldKind::Offset, -8},
+    {0x1f38, 0x1f3f, FoldKind::Offset, -8},
+    {0x1f48, 0x1f4d, FoldKind::Offset, -8},
+    {0x1f59, 0x1f59, FoldKind::Offset, -8},
+    {0x1f5b, 0x1f5b, FoldKind::Offset, -8},
+    {0x1f5d, 0x1f5d, FoldKind::Offset, -8},
+    {0x1f5f, 0x1f5f, FoldKind::Offset, -8},
+    {0x1f68, 0x1f6f, FoldKind::Offset, -8},
+    {0x1f88, 0x1f8f, FoldKind::Offset, -8},
+    {0x1f98, 0x1f9f, FoldKind::Offset, -8},
+    {0x1fa8, 0x1faf, FoldKind::Offset, -8},
+    {0x1fb8, 0x1fb9, FoldKind::Offset, -8},
+    {0x1fba, 0x1fbb, FoldKind::Offset, -74},
+    {0x1fbc, 0x1fbc, FoldKind::Offset, -9},
+    {0x1fbe, 0x1fbe, FoldKind::Offset, -7173},
+    {0x1fc8, 0x1fcb, FoldKind::Offset, -86},
+    {0x1fcc, 0x1fcc, FoldKind::Offset, -9},
+    {0x1fd8, 0x1fd9, FoldKind::Offset, -8},
+    {0x1fda, 0x1fdb, FoldKind::Offset, -100},
+    {0x1fe8, 0x1fe9, FoldKind::Offset, -8},
+    {0x1fea, 0x1feb, FoldKind::Offset, -112},
+    {0x1fec, 0x1fec, FoldKind::Offset, -7},
+    {0x1ff8, 0x1ff9, FoldKind::Offset, -128},
+    {0x1ffa, 0x1ffb, FoldKind::Offset, -126},
+    {0x1ffc, 0x1ffc, FoldKind::Offset, -9},
+    {0x2126, 0x2126, FoldKind::Offset, -7517},      // Letterlike Symbols
+    {0x212a, 0x212a, FoldKind::Offset, -8383},
+    {0x212b, 0x212b, FoldKind::Offset, -8262},
+    {0x2132, 0x2132, FoldKind::Offset, 28},
+    {0x2160, 0x216f, FoldKind::Offset, 16},         // Number Forms
+    {0x2183, 0x2183, FoldKind::Offset, 1},
+    {0x24b6, 0x24cf, FoldKind::Offset, 26},         // Enclosed Alphanumerics
+    {0x2c00, 0x2c2f, FoldKind::Offset, 48},         // Glagolitic
+    {0x2c60, 0x2c60, FoldKind::Offset, 1},          // Latin Extended-C
+    {0x2c62, 0x2c62, FoldKind::Offset, -10743},
+    {0x2c63, 0x2c63, FoldKind::Offset, -3814},
+    {0x2c64, 0x2c64, FoldKind::Offset, -10727},
+    {0x2c67, 0x2c6b, FoldKind::OddUpper, 1},
+    {0x2c6d, 0x2c6d, FoldKind::Offset, -10780},
+    {0x2c6e, 0x2c6e, FoldKind::Offset, -10749},
+    {0x2c6f, 0x2c6f, FoldKind::Offset, -10783},
+    {0x2c70, 0x2c70, FoldKind::Offset, -10782},
+    {0x2c72, 0x2c72, FoldKind::Offset, 1},
+    {0x2c75, 0x2c75, FoldKind::Offset, 1},
+    {0x2c7e, 0x2c7f, FoldKind::Offset, -10815},
+    {0x2c80, 0x2ce2, FoldKind::EvenUpper, 1},       // Coptic
+    {0x2ceb, 0x2ced, FoldKind::OddUpper, 1},
+    {0x2cf2, 0x2cf2, FoldKind::Offset, 1},
+    {0xa640, 0xa66c, FoldKind::EvenUpper, 1},       // Cyrillic Extended-B
+    {0xa680, 0xa69a, FoldKind::EvenUpper, 1},
+    {0xa722, 0xa72e, FoldKind::EvenUpper, 1},       // Latin Extended-D
+    {0xa732, 0xa76e, FoldKind::EvenUpper, 1},
+    {0xa779, 0xa77b, FoldKind::OddUpper, 1},
+    {0xa77d, 0xa77d, FoldKind::Offset, -35332},
+    {0xa77e, 0xa786, FoldKind::EvenUpper, 1},
+    {0xa78b, 0xa78b, FoldKind::Offset, 1},
+    {0xa78d, 0xa78d, FoldKind::Offset, -42280},
+    {0xa790, 0xa792, FoldKind::EvenUpper, 1},
+    {0xa796, 0xa7a8, FoldKind::EvenUpper, 1},
+    {0xa7aa, 0xa7aa, FoldKind::Offset, -42308},
+    {0xa7ab, 0xa7ab, FoldKind::Offset, -42319},
+    {0xa7ac, 0xa7ac, FoldKind::Offset, -42315},
+    {0xa7ad, 0xa7ad, FoldKind::Offset, -42305},
+    {0xa7ae, 0xa7ae, FoldKind::Offset, -42308},
+    {0xa7b0, 0xa7b0, FoldKind::Offset, -42258},
+    {0xa7b1, 0xa7b1, FoldKind::Offset, -42282},
+    {0xa7b2, 0xa7b2, FoldKind::Offset, -42261},
+    {0xa7b3, 0xa7b3, FoldKind::Offset, 928},
+    {0xa7b4, 0xa7c2, FoldKind::EvenUpper, 1},
+    {0xa7c4, 0xa7c4, FoldKind::Offset, -48},
+    {0xa7c5, 0xa7c5, FoldKind::Offset, -42307},
+    {0xa7c6, 0xa7c6, FoldKind::Offset, -35384},
+    {0xa7c7, 0xa7c9, FoldKind::OddUpper, 1},
+    {0xa7d0, 0xa7d0, FoldKind::Offset, 1},
+    {0xa7d6, 0xa7d8, FoldKind::EvenUpper, 1},
+    {0xa7f5, 0xa7f5, FoldKind::Offset, 1},
+    {0xab70, 0xabbf, FoldKind::Offset, -38864},     // Cherokee Supplement
+    {0xff21, 0xff3a, FoldKind::Offset, 32},         // Halfwidth and Fullwidth Forms
+    {0x10400, 0x10427, FoldKind::Offset, 40},       // Deseret
+    {0x104b0, 0x104d3, FoldKind::Offset, 40},       // Osage
+    {0x10570, 0x1057a, FoldKind::Offset, 39},       // Vithkuqi
+    {0x1057c, 0x1058a, FoldKind::Offset, 39},
+    {0x1058c, 0x10592, FoldKind::Offset, 39},
+    {0x10594, 0x10595, FoldKind::Offset, 39},
+    {0x10c80, 0x10cb2, FoldKind::Offset, 64},       // Old Hungarian
+    {0x118a0, 0x118bf, FoldKind::Offset, 32},       // Warang Citi
+    {0x16e40, 0x16e5f, FoldKind::Offset, 32},       // Medefaidrin
+    {0x1e900, 0x1e921, FoldKind::Offset, 34},       // Adlam
+    // END GENERATED FOLDS
+};
+
+struct Range {
+    char32_t first;
+    char32_t last;
+};
+
+// Code points that are not letters or digits (see is_alnum), sorted
+constexpr Range kNonAlnumRanges[] = {
+    {0x0080, 0x00a9},   // C1 controls, Latin-1 punctuation and symbols
+    {0x00ab, 0x00b1},
+    {0x00b4, 0x00b4},
+    {0x00b6, 0x00b8},
+    {0x00bb, 0x00bb},
+    {0x00bf, 0x00bf},
+    {0x00d7, 0x00d7},
+    {0x00f7, 0x00f7},
+    {0x02c2, 0x02c5},   // modifier symbols
+    {0x02d2, 0x02df},
+    {0x0300, 0x036f},   // combining diacritical marks
+    {0x037e, 0x037e},
+    {0x0387, 0x0387},
+    {0x0483, 0x0489},
+    {0x055a, 0x055f},
+    {0x0589, 0x058a},
+    {0x0591, 0x05c7},   // Hebrew points and punctuation
+    {0x05f3, 0x05f4},
+    {0x0600, 0x061f},   // Arabic punctuation and marks
+    {0x064b, 0x065f},
+    {0x066a, 0x066d},
+    {0x06d4, 0x06d4},
+    {0x06d6, 0x06ed},
+    {0x0964, 0x0965},   // Devanagari danda
+    {0x0e3f, 0x0e3f},
+    {0x0e4f, 0x0e4f},
+    {0x0e5a, 0x0e5b},
+    {0x1680, 0x1680},
+    {0x1ab0, 0x1aff},   // combining marks extended
+    {0x1dc0, 0x1dff},   // combining marks supplement
+    {0x2000, 0x206f},   // general punctuation and spaces
+    {0x207a, 0x207e},
+    {0x208a, 0x208e},
+    {0x20a0, 0x20ff},   // currency, combining marks for symbols
+    {0x2100, 0x2101},
+    {0x2103, 0x2106},
+    {0x2108, 0x2109},
+    {0x2114, 0x2114},
+    {0x2116, 0x2118},
+    {0x211e, 0x2123},
+    {0x2125, 0x2125},
+    {0x2127, 0x2127},
+    {0x2129, 0x2129},
+    {0x212e, 0x212e},
+    {0x213a, 0x213b},
+    {0x2140, 0x2144},
+    {0x214a, 0x214d},
+    {0x214f, 0x214f},
+    {0x2190, 0x245f},   // arrows, math, technical, control pictures
+    {0x2500, 0x2775},   // box drawing, shapes, misc symbols, dingbats
+    {0x2794, 0x2bff},   // arrows, math symbols, braille, misc symbols
+    {0x2e00, 0x2e7f},   // supplemental punctuation
+    {0x3000, 0x3004},   // CJK symbols and punctuation
+    {0x3008, 0x3020},
+    {0x3030, 0x3030},
+    {0x303d, 0x303f},
+    {0x3099, 0x309c},
+    {0x30a0, 0x30a0},
+    {0x30fb, 0x30fb},
+    {0xd800, 0xf8ff},   // surrogates, private use
+    {0xfd3e, 0xfd3f},
+    {0xfe00, 0xfe6f},   // variation selectors, vertical and small forms
+    {0xfeff, 0xfeff},
+    {0xff01, 0xff0f},   // fullwidth punctuation
+    {0xff1a, 0xff20},
+    {0xff3b, 0xff40},
+    {0xff5b, 0xff65},
+    {0xffe0, 0xffff},
+    {0x1d173, 0x1d17a},
+    {0x1f000, 0x1faff}, // mahjong, cards, emoji and pictographs
+    {0xe0000, 0xe007f}, // tags
+    {0xe0100, 0xe01ef}, // variation selectors supplement
+    {0xf0000, 0x10ffff},
+};
+
+// Combining marks: general categories Mn, Mc and Me from
+// DerivedGeneralCategory.txt. Regenerate with scripts/generate_unicode_tables.py
+constexpr Range kCombiningRanges[] = {
+    // BEGIN GENERATED MARKS (Unicode 14.0.0)
+    {0x0300, 0x036f},                               // Combining Diacritical Marks
+    {0x0483, 0x0489},                               // Cyrillic
+    {0x0591, 0x05bd},                               // Hebrew
+    {0x05bf, 0x05bf},
+    {0x05c1, 0x05c2},
+    {0x05c4, 0x05c5},
+    {0x05c7, 0x05c7},
+    {0x0610, 0x061a},                               // Arabic
+    {0x064b, 0x065f},
+    {0x0670, 0x0670},
+    {0x06d6, 0x06dc},
+    {0x06df, 0x06e4},
+    {0x06e7, 0x06e8},
+    {0x06ea, 0x06ed},
+    {0x0711, 0x0711},                               // Syriac
+    {0x0730, 0x074a},
+    {0x07a6, 0x07b0},                               // Thaana
+    {0x07eb, 0x07f3},                               // NKo
+    {0x07fd, 0x07fd},
+    {0x0816, 0x0819},                               // Samaritan
+    {0x081b, 0x0823},
+    {0x0825, 0x0827},
+    {0x0829, 0x082d},
+    {0x0859, 0x085b},                               // Mandaic
+    {0x0898, 0x089f},                               // Arabic Extended-B
+    {0x08ca, 0x08e1},                               // Arabic Extended-A
+    {0x08e3, 0x0903},
+    {0x093a, 0x093c},                               // Devanagari
+    {0x093e, 0x094f},
+    {0x0951, 0x0957},
+    {0x0962, 0x0963},
+    {0x0981, 0x0983},                               // Bengali
+    {0x09bc, 0x09bc},
+    {0x09be, 0x09c4},
+    {0x09c7, 0x09c8},
+    {0x09cb, 0x09cd},
+    {0x09d7, 0x09d7},
+    {0x09e2, 0x09e3},
+    {0x09fe, 0x09fe},
+    {0x0a01, 0x0a03},                               // Gurmukhi
+    {0x0a3c, 0x0a3c},
+    {0x0a3e, 0x0a42},
+    {0x0a47, 0x0a48},
+    {0x0a4b, 0x0a4d},
+    {0x0a51, 0x0a51},
+    {0x0a70, 0x0a71},
+    {0x0a75, 0x0a75},
+    {0x0a81, 0x0a83},                               // Gujarati
+    {0x0abc, 0x0abc},
+    {0x0abe, 0x0ac5},
+    {0x0ac7, 0x0ac9},
+    {0x0acb, 0x0acd},
+    {0x0ae2, 0x0ae3},
+    {0x0afa, 0x0aff},
+    {0x0b01, 0x0b03},                               // Oriya
+    {0x0b3c, 0x0b3c},
+    {0x0b3e, 0x0b44},
+    {0x0b47, 0x0b48},
+    {0x0b4b, 0x0b4d},
+    {0x0b55, 0x0b57},
+    {0x0b62, 0x0b63},
+    {0x0b82, 0x0b82},                               // Tamil
+    {0x0bbe, 0x0bc2},
+    {0x0bc6, 0x0bc8},
+    {0x0bca, 0x0bcd},
+    {0x0bd7, 0x0bd7},
+    {0x0c00, 0x0c04},                               // Telugu
+    {0x0c3c, 0x0c3c},
+    {0x0c3e, 0x0c44},
+    {0x0c46, 0x0c48},
+    {0x0c4a, 0x0c4d},
+    {0x0c55, 0x0c56},
+    {0x0c62, 0x0c63},
+    {0x0c81, 0x0c83},                               // Kannada
+    {0x0cbc, 0x0cbc},
+    {0x0cbe, 0x0cc4},
+    {0x0cc6, 0x0cc8},
+    {0x0cca, 0x0ccd},
+    {0x0cd5, 0x0cd6},
+    {0x0ce2, 0x0ce3},
+    {0x0d00, 0x0d03},                               // Malayalam
+    {0x0d3b, 0x0d3c},
+    {0x0d3e, 0x0d44},
+    {0x0d46, 0x0d48},
+    {0x0d4a, 0x0d4d},
+    {0x0d57, 0x0d57},
+    {0x0d62, 0x0d63},
+    {0x0d81, 0x0d83},                               // Sinhala
+    {0x0dca, 0x0dca},
+    {0x0dcf, 0x0dd4},
+    {0x0dd6, 0x0dd6},
+    {0x0dd8, 0x0ddf},
+    {0x0df2, 0x0df3},
+    {0x0e31, 0x0e31},                               // Thai
+    {0x0e34, 0x0e3a},
+    {0x0e47, 0x0e4e},
+    {0x0eb1, 0x0eb1},                               // Lao
+    {0x0eb4, 0x0ebc},
+    {0x0ec8, 0x0ecd},
+    {0x0f18, 0x0f19},                               // Tibetan
+    {0x0f35, 0x0f35},
+    {0x0f37, 0x0f37},
+    {0x0f39, 0x0f39},
+    {0x0f3e, 0x0f3f},
+    {0x0f71, 0x0f84},
+    {0x0f86, 0x0f87},
+    {0x0f8d, 0x0f97},
+    {0x0f99, 0x0fbc},
+    {0x0fc6, 0x0fc6},
+    {0x102b, 0x103e},                               // Myanmar
+    {0x1056, 0x1059},
+    {0x105e, 0x1060},
+    {0x1062, 0x1064},
+    {0x1067, 0x106d},
+    {0x1071, 0x1074},
+    {0x1082, 0x108d},
+    {0x108f, 0x108f},
+    {0x109a, 0x109d},
+    {0x135d, 0x135f},                               // Ethiopic
+    {0x1712, 0x1715},                               // Tagalog
+    {0x1732, 0x1734},                               // Hanunoo
+    {0x1752, 0x1753},                               // Buhid
+    {0x1772, 0x1773},                               // Tagbanwa
+    {0x17b4, 0x17d3},                               // Khmer
+    {0x17dd, 0x17dd},
+    {0x180b, 0x180d},                               // Mongolian
+    {0x180f, 0x180f},
+    {0x1885, 0x1886},
+    {0x18a9, 0x18a9},
+    {0x1920, 0x192b},                               // Limbu
+    {0x1930, 0x193b},
+    {0x1a17, 0x1a1b},                               // Buginese
+    {0x1a55, 0x1a5e},                               // Tai Tham
+    {0x1a60, 0x1a7c},
+    {0x1a7f, 0x1a7f},
+    {0x1ab0, 0x1ace},                               // Combining Diacritical Marks Extended
+    {0x1b00, 0x1b04},                               // Balinese
+    {0x1b34, 0x1b44},
+    {0x1b6b, 0x1b73},
+    {0x1b80, 0x1b82},                               // Sundanese
+    {0x1ba1, 0x1bad},
+    {0x1be6, 0x1bf3},                               // Batak
+    {0x1c24, 0x1c37},                               // Lepcha
+    {0x1cd0, 0x1cd2},                               // Vedic Extensions
+    {0x1cd4, 0x1ce8},
+    {0x1ced, 0x1ced},
+    {0x1cf4, 0x1cf4},
+    {0x1cf7, 0x1cf9},
+    {0x1dc0, 0x1dff},                               // Combining Diacritical Marks Supplement
+    {0x20d0, 0x20f0},                               // Combining Diacritical Marks for Symbols
+    {0x2cef, 0x2cf1},                               // Coptic
+    {0x2d7f, 0x2d7f},                               // Tifinagh
+    {0x2de0, 0x2dff},                               // Cyrillic Extended-A
+    {0x302a, 0x302f},                               // CJK Symbols and Punctuation
+    {0x3099, 0x309a},                               // Hiragana
+    {0xa66f, 0xa672},                               // Cyrillic Extended-B
+    {0xa674, 0xa67d},
+    {0xa69e, 0xa69f},
+    {0xa6f0, 0xa6f1},                               // Bamum
+    {0xa802, 0xa802},                               // Syloti Nagri
+    {0xa806, 0xa806},
+    {0xa80b, 0xa80b},
+    {0xa823, 0xa827},
+    {0xa82c, 0xa82c},
+    {0xa880, 0xa881},                               // Saurashtra
+    {0xa8b4, 0xa8c5},
+    {0xa8e0, 0xa8f1},                               // Devanagari Extended
+    {0xa8ff, 0xa8ff},
+    {0xa926, 0xa92d},                               // Kayah Li
+    {0xa947, 0xa953},                               // Rejang
+    {0xa980, 0xa983},                               // Javanese
+    {0xa9b3, 0xa9c0},
+    {0xa9e5, 0xa9e5},                               // Myanmar Extended-B
+    {0xaa29, 0xaa36},                               // Cham
+    {0xaa43, 0xaa43},
+    {0xaa4c, 0xaa4d},
+    {0xaa7b, 0xaa7d},                               // Myanmar Extended-A
+    {0xaab0, 0xaab0},                               // Tai Viet
+    {0xaab2, 0xaab4},
+    {0xaab7, 0xaab8},
+    {0xaabe, 0xaabf},
+    {0xaac1, 0xaac1},
+    {0xaaeb, 0xaaef},                               // Meetei Mayek Extensions
+    {0xaaf5, 0xaaf6},
+    {0xabe3, 0xabea},                               // Meetei Mayek
+    {0xabec, 0xabed},
+    {0xfb1e, 0xfb1e},                               // Alphabetic Presentation Forms
+    {0xfe00, 0xfe0f},                               // Variation Selectors
+    {0xfe20, 0xfe2f},                               // Combining Half Marks
+    {0x101fd, 0x101fd},                             // Phaistos Disc
+    {0x102e0, 0x102e0},                             // Coptic Epact Numbers
+    {0x10376, 0x1037a},                             // Old Permic
+    {0x10a01, 0x10a03},                             // Kharoshthi
+    {0x10a05, 0x10a06},
+    {0x10a0c, 0x10a0f},
+    {0x10a38, 0x10a3a},
+    {0x10a3f, 0x10a3f},
+    {0x10ae5, 0x10ae6},                             // Manichaean
+    {0x10d24, 0x10d27},                             // Hanifi Rohingya
+    {0x10eab, 0x10eac},                             // Yezidi
+    {0x10f46, 0x10f50},                             // Sogdian
+    {0x10f82, 0x10f85},                             // Old Uyghur
+    {0x11000, 0x11002},                             // Brahmi
+    {0x11038, 0x11046},
+    {0x11070, 0x11070},
+    {0x11073, 0x11074},
+    {0x1107f, 0x11082},
+    {0x110b0, 0x110ba},                             // Kaithi
+    {0x110c2, 0x110c2},
+    {0x11100, 0x11102},                             // Chakma
+    {0x11127, 0x11134},
+    {0x11145, 0x11146},
+    {0x11173, 0x11173},                             // Mahajani
+    {0x11180, 0x11182},                             // Sharada
+    {0x111b3, 0x111c0},
+    {0x111c9, 0x111cc},
+    {0x111ce, 0x111cf},
+    {0x1122c, 0x11237},                             // Khojki
+    {0x1123e, 0x1123e},
+    {0x112df, 0x112ea},                             // Khudawadi
+    {0x11300, 0x11303},                             // Grantha
+    {0x1133b, 0x1133c},
+    {0x1133e, 0x11344},
+    {0x11347, 0x11348},
+    {0x1134b, 0x1134d},
+    {0x11357, 0x11357},
+    {0x11362, 0x11363},
+    {0x11366, 0x1136c},
+    {0x11370, 0x11374},
+    {0x11435, 0x11446},                             // Newa
+    {0x1145e, 0x1145e},
+    {0x114b0, 0x114c3},                             // Tirhuta
+    {0x115af, 0x115b5},                             // Siddham
+    {0x115b8, 0x115c0},
+    {0x115dc, 0x115dd},
+    {0x11630, 0x11640},                             // Modi
+    {0x116ab, 0x116b7},                             // Takri
+    {0x1171d, 0x1172b},                             // Ahom
+    {0x1182c, 0x1183a},                             // Dogra
+    {0x11930, 0x11935},                             // Dives Akuru
+    {0x11937, 0x11938},
+    {0x1193b, 0x1193e},
+    {0x11940, 0x11940},
+    {0x11942, 0x11943},
+    {0x119d1, 0x119d7},                             // Nandinagari
+    {0x119da, 0x119e0},
+    {0x119e4, 0x119e4},
+    {0x11a01, 0x11a0a},                             // Zanabazar Square
+    {0x11a33, 0x11a39},
+    {0x11a3b, 0x11a3e},
+    {0x11a47, 0x11a47},
+    {0x11a51, 0x11a5b},                             // Soyombo
+    {0x11a8a, 0x11a99},
+    {0x11c2f, 0x11c36},                             // Bhaiksuki
+    {0x11c38, 0x11c3f},
+    {0x11c92, 0x11ca7},                             // Marchen
+    {0x11ca9, 0x11cb6},
+    {0x11d31, 0x11d36},                             // Masaram Gondi
+    {0x11d3a, 0x11d3a},
+    {0x11d3c, 0x11d3d},
+    {0x11d3f, 0x11d45},
+    {0x11d47, 0x11d47},
+    {0x11d8a, 0x11d8e},                             // Gunjala Gondi
+    {0x11d90, 0x11d91},
+    {0x11d93, 0x11d97},
+    {0x11ef3, 0x11ef6},                             // Makasar
+    {0x16af0, 0x16af4},                             // Bassa Vah
+    {0x16b30, 0x16b36},                             // Pahawh Hmong
+    {0x16f4f, 0x16f4f},                             // Miao
+    {0x16f51, 0x16f87},
+    {0x16f8f, 0x16f92},
+    {0x16fe4, 0x16fe4},                             // Ideographic Symbols and Punctuation
+    {0x16ff0, 0x16ff1},
+    {0x1bc9d, 0x1bc9e},                             // Duployan
+    {0x1cf00, 0x1cf2d},                             // Znamenny Musical Notation
+    {0x1cf30, 0x1cf46},
+    {0x1d165, 0x1d169},                             // Musical Symbols
+    {0x1d16d, 0x1d172},
+    {0x1d17b, 0x1d182},
+    {0x1d185, 0x1d18b},
+    {0x1d1aa, 0x1d1ad},
+    {0x1d242, 0x1d244},                             // Ancient Greek Musical Notation
+    {0x1da00, 0x1da36},                             // Sutton SignWriting
+    {0x1da3b, 0x1da6c},
+    {0x1da75, 0x1da75},
+    {0x1da84, 0x1da84},
+    {0x1da9b, 0x1da9f},
+    {0x1daa1, 0x1daaf},
+    {0x1e000, 0x1e006},                             // Glagolitic Supplement
+    {0x1e008, 0x1e018},
+    {0x1e01b, 0x1e021},
+    {0x1e023, 0x1e024},
+    {0x1e026, 0x1e02a},
+    {0x1e130, 0x1e136},                             // Nyiakeng Puachue Hmong
+    {0x1e2ae, 0x1e2ae},                             // Toto
+    {0x1e2ec, 0x1e2ef},                             // Wancho
+    {0x1e8d0, 0x1e8d6},                             // Mende Kikakui
+    {0x1e944, 0x1e94a},                             // Adlam
+    {0xe0100, 0xe01ef},                             // Variation Selectors Supplement
+    // END GENERATED MARKS
+};
+
+// Extended_Pictographic, with the symbol and emoji blocks taken whole
+constexpr Range kPictographicRanges[] = {
+    {0x00a9, 0x00a9},
+    {0x00ae, 0x00ae},
+    {0x203c, 0x203c},
+    {0x2049, 0x2049},
+    {0x2122, 0x2122},
+    {0x2139, 0x2139},
+    {0x2194, 0x21aa},
+    {0x231a, 0x23ff},
+    {0x24c2, 0x24c2},
+    {0x25aa, 0x25fe},
+    {0x2600, 0x27bf},   // misc symbols, dingbats
+    {0x2934, 0x2935},
+    {0x2b05, 0x2b55},
+    {0x3030, 0x3030},
+    {0x303d, 0x303d},
+    {0x3297, 0x3299},
+    {0x1f000, 0x1faff}, // emoji and pictographs
+};
+
+// Grapheme_Cluster_Break Extend and SpacingMark (GB9, GB9a), and Control
+// (GB4, GB5), from GraphemeBreakProperty.txt. Regenerate with
+// scripts/generate_unicode_tables.py
+constexpr Range kGraphemeExtendRanges[] = {
+    // BEGIN GENERATED GRAPHEME_EXTEND (Unicode 14.0.0)
+    {0x0300, 0x036f},                               // Combining Diacritical Marks
+    {0x0483, 0x0489},                               // Cyrillic
+    {0x0591, 0x05bd},                               // Hebrew
+    {0x05bf, 0x05bf},
+    {0x05c1, 0x05c2},
+    {0x05c4, 0x05c5},
+    {0x05c7, 0x05c7},
+    {0x0610, 0x061a},                               // Arabic
+    {0x064b, 0x065f},
+    {0x0670, 0x0670},
+    {0x06d6, 0x06dc},
+    {0x06df, 0x06e4},
+    {0x06e7, 0x06e8},
+    {0x06ea, 0x06ed},
+    {0x0711, 0x0711},                               // Syriac
+    {0x0730, 0x074a},
+    {0x07a6, 0x07b0},                               // Thaana
+    {0x07eb, 0x07f3},                               // NKo
+    {0x07fd, 0x07fd},
+    {0x0816, 0x0819},                               // Samaritan
+    {0x081b, 0x0823},
+    {0x0825, 0x0827},
+    {0x0829, 0x082d},
+    {0x0859, 0x085b},                               // Mandaic
+    {0x0898, 0x089f},                               // Arabic Extended-B
+    {0x08ca, 0x08e1},                               // Arabic Extended-A
+    {0x08e3, 0x0903},
+    {0x093a, 0x093c},                               // Devanagari
+    {0x093e, 0x094f},
+    {0x0951, 0x0957},
+    {0x0962, 0x0963},
+    {0x0981, 0x0983},                               // Bengali
+    {0x09bc, 0x09bc},
+    {0x09be, 0x09c4},
+    {0x09c7, 0x09c8},
+    {0x09cb, 0x09cd},
+    {0x09d7, 0x09d7},
+    {0x09e2, 0x09e3},
+    {0x09fe, 0x09fe},
+    {0x0a01, 0x0a03},                               // Gurmukhi
+    {0x0a3c, 0x0a3c},
+    {0x0a3e, 0x0a42},
+    {0x0a47, 0x0a48},
+    {0x0a4b, 0x0a4d},
+    {0x0a51, 0x0a51},
+    {0x0a70, 0x0a71},
+    {0x0a75, 0x0a75},
+    {0x0a81, 0x0a83},                               // Gujarati
+    {0x0abc, 0x0abc},
+    {0x0abe, 0x0ac5},
+    {0x0ac7, 0x0ac9},
+    {0x0acb, 0x0acd},
+    {0x0ae2, 0x0ae3},
+    {0x0afa, 0x0aff},
+    {0x0b01, 0x0b03},                               // Oriya
+    {0x0b3c, 0x0b3c},
+    {0x0b3e, 0x0b44},
+    {0x0b47, 0x0b48},
+    {0x0b4b, 0x0b4d},
+    {0x0b55, 0x0b57},
+    {0x0b62, 0x0b63},
+    {0x0b82, 0x0b82},                               // Tamil
+    {0x0bbe, 0x0bc2},
+    {0x0bc6, 0x0bc8},
+    {0x0bca, 0x0bcd},
+    {0x0bd7, 0x0bd7},
+    {0x0c00, 0x0c04},                               // Telugu
+    {0x0c3c, 0x0c3c},
+    {0x0c3e, 0x0c44},
+    {0x0c46, 0x0c48},
+    {0x0c4a, 0x0c4d},
+    {0x0c55, 0x0c56},
+    {0x0c62, 0x0c63},
+    {0x0c81, 0x0c83},                               // Kannada
+    {0x0cbc, 0x0cbc},
+    {0x0cbe, 0x0cc4},
+    {0x0cc6, 0x0cc8},
+    {0x0cca, 0x0ccd},
+    {0x0cd5, 0x0cd6},
+    {0x0ce2, 0x0ce3},
+    {0x0d00, 0x0d03},                               // Malayalam
+    {0x0d3b, 0x0d3c},
+    {0x0d3e, 0x0d44},
+    {0x0d46, 0x0d48},
+    {0x0d4a, 0x0d4d},
+    {0x0d57, 0x0d57},
+    {0x0d62, 0x0d63},
+    {0x0d81, 0x0d83},                               // Sinhala
+    {0x0dca, 0x0dca},
+    {0x0dcf, 0x0dd4},
+    {0x0dd6, 0x0dd6},
+    {0x0dd8, 0x0ddf},
+    {0x0df2, 0x0df3},
+    {0x0e31, 0x0e31},                               // Thai
+    {0x0e33, 0x0e3a},
+    {0x0e47, 0x0e4e},
+    {0x0eb1, 0x0eb1},                               // Lao
+    {0x0eb3, 0x0ebc},
+    {0x0ec8, 0x0ecd},
+    {0x0f18, 0x0f19},                               // Tibetan
+    {0x0f35, 0x0f35},
+    {0x0f37, 0x0f37},
+    {0x0f39, 0x0f39},
+    {0x0f3e, 0x0f3f},
+    {0x0f71, 0x0f84},
+    {0x0f86, 0x0f87},
+    {0x0f8d, 0x0f97},
+    {0x0f99, 0x0fbc},
+    {0x0fc6, 0x0fc6},
+    {0x102d, 0x1037},                               // Myanmar
+    {0x1039, 0x103e},
+    {0x1056, 0x1059},
+    {0x105e, 0x1060},
+    {0x1071, 0x1074},
+    {0x1082, 0x1082},
+    {0x1084, 0x1086},
+    {0x108d, 0x108d},
+    {0x109d, 0x109d},
+    {0x135d, 0x135f},                               // Ethiopic
+    {0x1712, 0x1715},                               // Tagalog
+    {0x1732, 0x1734},                               // Hanunoo
+    {0x1752, 0x1753},                               // Buhid
+    {0x1772, 0x1773},                               // Tagbanwa
+    {0x17b4, 0x17d3},                               // Khmer
+    {0x17dd, 0x17dd},
+    {0x180b, 0x180d},                               // Mongolian
+    {0x180f, 0x180f},
+    {0x1885, 0x1886},
+    {0x18a9, 0x18a9},
+    {0x1920, 0x192b},                               // Limbu
+    {0x1930, 0x193b},
+    {0x1a17, 0x1a1b},                               // Buginese
+    {0x1a55, 0x1a5e},                               // Tai Tham
+    {0x1a60, 0x1a60},
+    {0x1a62, 0x1a62},
+    {0x1a65, 0x1a7c},
+    {0x1a7f, 0x1a7f},
+    {0x1ab0, 0x1ace},                               // Combining Diacritical Marks Extended
+    {0x1b00, 0x1b04},                               // Balinese
+    {0x1b34, 0x1b44},
+    {0x1b6b, 0x1b73},
+    {0x1b80, 0x1b82},                               // Sundanese
+    {0x1ba1, 0x1bad},
+    {0x1be6, 0x1bf3},                               // Batak
+    {0x1c24, 0x1c37},                               // Lepcha
+    {0x1cd0, 0x1cd2},                               // Vedic Extensions
+    {0x1cd4, 0x1ce8},
+    {0x1ced, 0x1ced},
+    {0x1cf4, 0x1cf4},
+    {0x1cf7, 0x1cf9},
+    {0x1dc0, 0x1dff},                               // Combining Diacritical Marks Supplement
+    {0x200c, 0x200c},                               // General Punctuation
+    {0x20d0, 0x20f0},                               // Combining Diacritical Marks for Symbols
+    {0x2cef, 0x2cf1},                               // Coptic
+    {0x2d7f, 0x2d7f},                               // Tifinagh
+    {0x2de0, 0x2dff},                               // Cyrillic Extended-A
+    {0x302a, 0x302f},                               // CJK Symbols and Punctuation
+    {0x3099, 0x309a},                               // Hiragana
+    {0xa66f, 0xa672},                               // Cyrillic Extended-B
+    {0xa674, 0xa67d},
+    {0xa69e, 0xa69f},
+    {0xa6f0, 0xa6f1},                               // Bamum
+    {0xa802, 0xa802},                               // Syloti Nagri
+    {0xa806, 0xa806},
+    {0xa80b, 0xa80b},
+    {0xa823, 0xa827},
+    {0xa82c, 0xa82c},
+    {0xa880, 0xa881},                               // Saurashtra
+    {0xa8b4, 0xa8c5},
+    {0xa8e0, 0xa8f1},                               // Devanagari Extended
+    {0xa8ff, 0xa8ff},
+    {0xa926, 0xa92d},                               // Kayah Li
+    {0xa947, 0xa953},                               // Rejang
+    {0xa980, 0xa983},                               // Javanese
+    {0xa9b3, 0xa9c0},
+    {0xa9e5, 0xa9e5},                               // Myanmar Extended-B
+    {0xaa29, 0xaa36},                               // Cham
+    {0xaa43, 0xaa43},
+    {0xaa4c, 0xaa4d},
+    {0xaa7c, 0xaa7c},                               // Myanmar Extended-A
+    {0xaab0, 0xaab0},                               // Tai Viet
+    {0xaab2, 0xaab4},
+    {0xaab7, 0xaab8},
+    {0xaabe, 0xaabf},
+    {0xaac1, 0xaac1},
+    {0xaaeb, 0xaaef},                               // Meetei Mayek Extensions
+    {0xaaf5, 0xaaf6},
+    {0xabe3, 0xabea},                               // Meetei Mayek
+    {0xabec, 0xabed},
+    {0xfb1e, 0xfb1e},                               // Alphabetic Presentation Forms
+    {0xfe00, 0xfe0f},                               // Variation Selectors
+    {0xfe20, 0xfe2f},                               // Combining Half Marks
+    {0xff9e, 0xff9f},                               // Halfwidth and Fullwidth Forms
+    {0x101fd, 0x101fd},                             // Phaistos Disc
+    {0x102e0, 0x102e0},                             // Coptic Epact Numbers
+    {0x10376, 0x1037a},                             // Old Permic
+    {0x10a01, 0x10a03},                             // Kharoshthi
+    {0x10a05, 0x10a06},
+    {0x10a0c, 0x10a0f},
+    {0x10a38, 0x10a3a},
+    {0x10a3f, 0x10a3f},
+    {0x10ae5, 0x10ae6},                             // Manichaean
+    {0x10d24, 0x10d27},                             // Hanifi Rohingya
+    {0x10eab, 0x10eac},                             // Yezidi
+    {0x10f46, 0x10f50},                             // Sogdian
+    {0x10f82, 0x10f85},                             // Old Uyghur
+    {0x11000, 0x11002},                             // Brahmi
+    {0x11038, 0x11046},
+    {0x11070, 0x11070},
+    {0x11073, 0x11074},
+    {0x1107f, 0x11082},
+    {0x110b0, 0x110ba},                             // Kaithi
+    {0x110c2, 0x110c2},
+    {0x11100, 0x11102},                             // Chakma
+    {0x11127, 0x11134},
+    {0x11145, 0x11146},
+    {0x11173, 0x11173},                             // Mahajani
+    {0x11180, 0x11182},                             // Sharada
+    {0x111b3, 0x111c0},
+    {0x111c9, 0x111cc},
+    {0x111ce, 0x111cf},
+    {0x1122c, 0x11237},                             // Khojki
+    {0x1123e, 0x1123e},
+    {0x112df, 0x112ea},                             // Khudawadi
+    {0x11300, 0x11303},                             // Grantha
+    {0x1133b, 0x1133c},
+    {0x1133e, 0x11344},
+    {0x11347, 0x11348},
+    {0x1134b, 0x1134d},
+    {0x11357, 0x11357},
+    {0x11362, 0x11363},
+    {0x11366, 0x1136c},
+    {0x11370, 0x11374},
+    {0x11435, 0x11446},                             // Newa
+    {0x1145e, 0x1145e},
+    {0x114b0, 0x114c3},                             // Tirhuta
+    {0x115af, 0x115b5},                             // Siddham
+    {0x115b8, 0x115c0},
+    {0x115dc, 0x115dd},
+    {0x11630, 0x11640},                             // Modi
+    {0x116ab, 0x116b7},                             // Takri
+    {0x1171d, 0x1171f},                             // Ahom
+    {0x11722, 0x1172b},
+    {0x1182c, 0x1183a},                             // Dogra
+    {0x11930, 0x11935},                             // Dives Akuru
+    {0x11937, 0x11938},
+    {0x1193b, 0x1193e},
+    {0x11940, 0x11940},
+    {0x11942, 0x11943},
+    {0x119d1, 0x119d7},                             // Nandinagari
+    {0x119da, 0x119e0},
+    {0x119e4, 0x119e4},
+    {0x11a01, 0x11a0a},                             // Zanabazar Square
+    {0x11a33, 0x11a39},
+    {0x11a3b, 0x11a3e},
+    {0x11a47, 0x11a47},
+    {0x11a51, 0x11a5b},                             // Soyombo
+    {0x11a8a, 0x11a99},
+    {0x11c2f, 0x11c36},                             // Bhaiksuki
+    {0x11c38, 0x11c3f},
+    {0x11c92, 0x11ca7},                             // Marchen
+    {0x11ca9, 0x11cb6},
+    {0x11d31, 0x11d36},                             // Masaram Gondi
+    {0x11d3a, 0x11d3a},
+    {0x11d3c, 0x11d3d},
+    {0x11d3f, 0x11d45},
+    {0x11d47, 0x11d47},
+    {0x11d8a, 0x11d8e},                             // Gunjala Gondi
+    {0x11d90, 0x11d91},
+    {0x11d93, 0x11d97},
+    {0x11ef3, 0x11ef6},                             // Makasar
+    {0x16af0, 0x16af4},                             // Bassa Vah
+    {0x16b30, 0x16b36},                             // Pahawh Hmong
+    {0x16f4f, 0x16f4f},                             // Miao
+    {0x16f51, 0x16f87},
+    {0x16f8f, 0x16f92},
+    {0x16fe4, 0x16fe4},                             // Ideographic Symbols and Punctuation
+    {0x16ff0, 0x16ff1},
+    {0x1bc9d, 0x1bc9e},                             // Duployan
+    {0x1cf00, 0x1cf2d},                             // Znamenny Musical Notation
+    {0x1cf30, 0x1cf46},
+    {0x1d165, 0x1d169},                             // Musical Symbols
+    {0x1d16d, 0x1d172},
+    {0x1d17b, 0x1d182},
+    {0x1d185, 0x1d18b},
+    {0x1d1aa, 0x1d1ad},
+    {0x1d242, 0x1d244},                             // Ancient Greek Musical Notation
+    {0x1da00, 0x1da36},                             // Sutton SignWriting
+    {0x1da3b, 0x1da6c},
+    {0x1da75, 0x1da75},
+    {0x1da84, 0x1da84},
+    {0x1da9b, 0x1da9f},
+    {0x1daa1, 0x1daaf},
+    {0x1e000, 0x1e006},                             // Glagolitic Supplement
+    {0x1e008, 0x1e018},
+    {0x1e01b, 0x1e021},
+    {0x1e023, 0x1e024},
+    {0x1e026, 0x1e02a},
+    {0x1e130, 0x1e136},                             // Nyiakeng Puachue Hmong
+    {0x1e2ae, 0x1e2ae},                             // Toto
+    {0x1e2ec, 0x1e2ef},                             // Wancho
+    {0x1e8d0, 0x1e8d6},                             // Mende Kikakui
+    {0x1e944, 0x1e94a},                             // Adlam
+    {0x1f3fb, 0x1f3ff},                             // Miscellaneous Symbols and Pictographs
+    {0xe0020, 0xe007f},                             // Tags
+    {0xe0100, 0xe01ef},                             // Variation Selectors Supplement
+    // END GENERATED GRAPHEME_EXTEND
+};
+
+constexpr Range kGraphemeControlRanges[] = {
+    // BEGIN GENERATED GRAPHEME_CONTROL (Unicode 14.0.0)
+    {0x0000, 0x0009},                               // Basic Latin
+    {0x000b, 0x000c},
+    {0x000e, 0x001f},
+    {0x007f, 0x009f},
+    {0x00ad, 0x00ad},                               // Latin-1 Supplement
+    {0x061c, 0x061c},                               // Arabic
+    {0x180e, 0x180e},                               // Mongolian
+    {0x200b, 0x200b},                               // General Punctuation
+    {0x200e, 0x200f},
+    {0x2028, 0x202e},
+    {0x2060, 0x206f},
+    {0xfeff, 0xfeff},                               // Arabic Presentation Forms-B
+    {0xfff0, 0xfffb},                               // Specials
+    {0x13430, 0x13438},                             // Egyptian Hieroglyph Format Controls
+    {0x1bca0, 0x1bca3},                             // Shorthand Format Controls
+    {0x1d173, 0x1d17a},                             // Musical Symbols
+    {0xe0000, 0xe001f},                             // Tags
+    {0xe0080, 0xe00ff},
+    {0xe01f0, 0xe0fff},
+    // END GENERATED GRAPHEME_CONTROL
+};
+
+template <std::size_t N>
+bool in_ranges(const Range (&ranges)[N], char32_t codepoint) {
+    const Range* it = std::upper_bound(std::begin(ranges), std::end(ranges), codepoint,
+                                       [](char32_t value, const Range& range) { return value < range.first; });
+    return it != std::begin(ranges) && codepoint <= std::prev(it)->last;
+}
+
+// Grapheme_Cluster_Break values the rules distinguish; SpacingMark is
+// folded into Extend since both only ever attach to what precedes them
+enum class GraphemeBreak : std::uint8_t {
+    Other,
+    CR,
+    LF,
+    Control,
+    Extend,
+    ZWJ,
+    RegionalIndicator,
+    L,
+    V,
+    T,
+    LV,
+    LVT,
+    Pictographic
+};
+
+GraphemeBreak grapheme_break(char32_t codepoint) {
+    if (codepoint < 0x80) {
+        return codepoint == '\r' ? GraphemeBreak::CR
+             : codepoint == '\n' ? GraphemeBreak::LF
+             : codepoint < 0x20 || codepoint == 0x7f ? GraphemeBreak::Control
+             : GraphemeBreak::Other;
+    }
+    if (codepoint == 0x200d) {
+        return GraphemeBreak::ZWJ;
+    }
+    if (in_ranges(kGraphemeControlRanges, codepoint)) {
+        return GraphemeBreak::Control;
+    }
+    if (in_ranges(kGraphemeExtendRanges, codepoint)) {
+        return GraphemeBreak::Extend;
+    }
+    if (codepoint >= 0x1f1e6 && codepoint <= 0x1f1ff) {
+        return GraphemeBreak::RegionalIndicator;
+    }
+    if ((codepoint >= 0x1100 && codepoint <= 0x115f) || (codepoint >= 0xa960 && codepoint <= 0xa97c)) {
+        return GraphemeBreak::L;
+    }
+    if ((codepoint >= 0x1160 && codepoint <= 0x11a7) || (codepoint >= 0xd7b0 && codepoint <= 0xd7c6)) {
+        return GraphemeBreak::V;
+    }
+    if ((codepoint >= 0x11a8 && codepoint <= 0x11ff) || (codepoint >= 0xd7cb && codepoint <= 0xd7fb)) {
+        return GraphemeBreak::T;
+    }
+    if (codepoint >= 0xac00 && codepoint <= 0xd7a3) {
+        return (codepoint - 0xac00) % 28 == 0 ? GraphemeBreak::LV : GraphemeBreak::LVT;
+    }
+    return in_ranges(kPictographicRanges, codepoint) ? GraphemeBreak::Pictographic : GraphemeBreak::Other;
+}
+
+// GB6-GB8: L (L | V | LV | LVT), (LV | V) (V | T), (LVT | T) T
+bool hangul_continues(GraphemeBreak previous, GraphemeBreak next) {
+    switch (previous) {
+        case GraphemeBreak::L:
+            return next == GraphemeBreak::L || next == GraphemeBreak::V || next == GraphemeBreak::LV ||
+                   next == GraphemeBreak::LVT;
+        case GraphemeBreak::LV:
+        case GraphemeBreak::V:
+            return next == GraphemeBreak::V || next == GraphemeBreak::T;
+        case GraphemeBreak::LVT:
+        case GraphemeBreak::T:
+            return next == GraphemeBreak::T;
+        default:
+            return false;
+    }
+}
+
+} // namespace
+
+char32_t simple_casefold(char32_t codepoint) {
+    if (codepoint < 0x80) {
+        return codepoint >= 'A' && codepoint <= 'Z' ? codepoint + 32 : codepoint;
+    }
+    const FoldRange* it = std::upper_bound(std::begin(kFoldRanges), std::end(kFoldRanges), codepoint,
+                                           [](char32_t value, const FoldRange& range) { return value < range.first; });
+    if (it == std::begin(kFoldRanges)) {
+        return codepoint;
+    }
+    const FoldRange& range = *std::prev(it);
+    if (codepoint > range.last) {
+        return codepoint;
+    }
+    switch (range.kind) {
+        case FoldKind::Offset:
+            return static_cast<char32_t>(static_cast<std::int32_t>(codepoint) + range.delta);
+        case FoldKind::EvenUpper:
+            return codepoint % 2 == 0 ? codepoint + 1 : codepoint;
+        case FoldKind::OddUpper:
+            return codepoint % 2 == 1 ? codepoint + 1 : codepoint;
+    }
+    return codepoint;
+}
+
+bool is_alnum(char32_t codepoint) {
+    if (codepoint < 0x80) {
+        return (codepoint >= '0' && codepoint <= '9') || (codepoint >= 'A' && codepoint <= 'Z') ||
+               (codepoint >= 'a' && codepoint <= 'z');
+    }
+    return !in_ranges(kNonAlnumRanges, codepoint);
+}
+
+bool is_combining_mark(char32_t codepoint) {
+    return codepoint >= 0x300 && in_ranges(kCombiningRanges, codepoint);
+}
+
+std::size_t grapheme_cluster_length(const char* data, std::size_t size) {
+    char32_t codepoint;
+    std::size_t pos = decode_utf8(data, size, codepoint);
+    if (pos == 0) {
+        return 0;
+    }
+    GraphemeBreak previous = grapheme_break(codepoint);
+    if (previous == GraphemeBreak::CR) {
+        return size > 1 && data[1] == '\n' ? 2 : 1;   // GB3, GB4
+    }
+    if (previous == GraphemeBreak::LF || previous == GraphemeBreak::Control) {
+        return pos;
+    }
+
+    // GB11 needs to know whether a ZWJ follows Extended_Pictographic Extend*,
+    // GB12/GB13 how many regional indicators the cluster holds
+    bool pictographic = previous == GraphemeBreak::Pictographic;
+    bool zwj_after_pictographic = false;
+    std::size_t regional_indicators = previous == GraphemeBreak::RegionalIndicator ? 1 : 0;
+    while (pos < size) {
+        const std::size_t length = decode_utf8(data + pos, size - pos, codepoint);
+        if (length == 0) {
+            break;
+        }
+        const GraphemeBreak next = grapheme_break(codepoint);
+        bool joins;
+        switch (next) {
+            case GraphemeBreak::Extend:
+            case GraphemeBreak::ZWJ:
+                joins = true;   // GB9, GB9a
+                break;
+            case GraphemeBreak::CR:
+            case GraphemeBreak::LF:
+            case GraphemeBreak::Control:
+                joins = false;  // GB5
+                break;
+            case GraphemeBreak::Pictographic:
+                joins = previous == GraphemeBreak::ZWJ && zwj_after_pictographic;
+                break;
+            case GraphemeBreak::RegionalIndicator:
+                joins = previous == GraphemeBreak::RegionalIndicator && regional_indicators % 2 == 1;
+                break;
+            default:
+                joins = hangul_continues(previous, next);
+                break;
+        }
+        if (!joins) {
+            break;
+        }
+
+        if (next == GraphemeBreak::ZWJ) {
+            zwj_after_pictographic = pictographic;
+            pictographic = false;
+        } else if (next == GraphemeBreak::Pictographic) {
+            pictographic = true;
+        } else if (next != GraphemeBreak::Extend) {
+            pictographic = false;
+        }
+        regional_indicators += next == GraphemeBreak::RegionalIndicator ? 1 : 0;
+        previous = next;
+        pos += length;
+    }
+    return pos;
+}
+
+} // namespace detail
+} // namespace pystringpp
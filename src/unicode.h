@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @file unicode.h
+ * @brief Internal UTF-8 decoding and compact Unicode character properties
+ *
+ * Not part of the public API. Case folding, combining marks and the
+ * grapheme break classes Extend, SpacingMark and Control are generated from
+ * the Unicode Character Database (scripts/generate_unicode_tables.py). The
+ * other property functions are small range tables rather than the full UCD:
+ * they cover the scripts and blocks that matter for text processing (Latin,
+ * Greek, Cyrillic, Armenian, fullwidth forms, common punctuation and symbol
+ * blocks) and are documented as approximations where the UCD would differ.
+ */
+
+namespace pystringpp {
+namespace detail {
+
+    /**
+     * Decode the UTF-8 sequence starting at data[0] (size > 0). Returns its
+     * length (1-4) and stores the code point, or returns 0 if the bytes are
+     * not well-formed UTF-8: truncated sequences, overlong forms, surrogates
+     * and values above U+10FFFF are all rejected.
+     */
+    inline std::size_t decode_utf8(const char* data, std::size_t size, char32_t& codepoint) {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+        const unsigned char lead = bytes[0];
+        if (lead < 0x80) {
+            codepoint = lead;
+            return 1;
+        }
+
+        std::size_t length;
+        char32_t smallest;
+        if ((lead & 0xe0) == 0xc0) {
+            length = 2;
+            smallest = 0x80;
+            codepoint = lead & 0x1f;
+        } else if ((lead & 0xf0) == 0xe0) {
+            length = 3;
+            smallest = 0x800;
+            codepoint = lead & 0x0f;
+        } else if ((lead & 0xf8) == 0xf0) {
+            length = 4;
+            smallest = 0x10000;
+            codepoint = lead & 0x07;
+        } else {
+            return 0;
+        }
+        if (size < length) {
+            return 0;
+        }
+        for (std::size_t i = 1; i < length; ++i) {
+            if ((bytes[i] & 0xc0) != 0x80) {
+                return 0;
+            }
+            codepoint = (codepoint << 6) | (bytes[i] & 0x3f);
+        }
+        if (codepoint < smallest || codepoint > 0x10ffff || (codepoint >= 0xd800 && codepoint <= 0xdfff)) {
+            return 0;
+        }
+        return length;
+    }
+
+    /**
+     * Decode the UTF-8 sequence that ends just before data[end] (end > 0).
+     * Returns its length and stores the code point, or returns 0 if the bytes
+     * before `end` do not end with a well-formed sequence.
+     */
+    inline std::size_t decode_utf8_before(const char* data, std::size_t end, char32_t& codepoint) {
+        std::size_t start = end - 1;
+        // A sequence has at most three continuation bytes
+        while (start > 0 && end - start < 4 && (static_cast<unsigned char>(data[start]) & 0xc0) == 0x80) {
+            --start;
+        }
+        const std::size_t length = decode_utf8(data + start, end - start, codepoint);
+        return length == end - start ? length : 0;
+    }
+
+    /// Append the UTF-8 encoding of a code point (at most U+10FFFF, not a surrogate) to out
+    inline void append_utf8(char32_t codepoint, std::string& out) {
+        if (codepoint < 0x80) {
+            out.push_back(static_cast<char>(codepoint));
+        } else if (codepoint < 0x800) {
+            out.push_back(static_cast<char>(0xc0 | (codepoint >> 6)));
+            out.push_back(static_cast<char>(0x80 | (codepoint & 0x3f)));
+        } else if (codepoint < 0x10000) {
+            out.push_back(static_cast<char>(0xe0 | (codepoint >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3f)));
+            out.push_back(static_cast<char>(0x80 | (codepoint & 0x3f)));
+        } else {
+            out.push_back(static_cast<char>(0xf0 | (codepoint >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((codepoint >> 12) & 0x3f)));
+            out.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3f)));
+            out.push_back(static_cast<char>(0x80 | (codepoint & 0x3f)));
+        }
+    }
+
+    /// Simple (one-to-one) Unicode case folding, CaseFolding.txt statuses C and S;
+    /// code points without a fold map to themselves
+    char32_t simple_casefold(char32_t codepoint);
+
+    /**
+     * True for letters and digits. ASCII is exact; elsewhere controls,
+     * separators, punctuation, symbol blocks (arrows, math, box drawing,
+     * dingbats, emoji), combining marks, variation selectors and private use
+     * are excluded and everything else is treated as a letter.
+     */
+    bool is_alnum(char32_t codepoint);
+
+    /// True for combining marks (general category Mn, Mc or Me), which attach
+    /// to the preceding base character
+    bool is_combining_mark(char32_t codepoint);
+
+    /**
+     * Length of the extended grapheme cluster (UAX #29) starting at data[0]
+     * (size > 0), or 0 if its first code point is not well-formed UTF-8; a
+     * malformed sequence further on ends the cluster in front of it. Covers
+     * CR LF, Hangul syllable sequences, Extend and SpacingMark characters
+     * (combining marks, Indic vowel signs, variation selectors, emoji
+     * modifiers and tags), ZWJ emoji sequences and regional-indicator flag
+     * pairs. Prepend characters and Indic conjunct rules are not applied.
+     */
+    std::size_t grapheme_cluster_length(const char* data, std::size_t size);
+
+} // namespace detail
+} // namespace pystringpp
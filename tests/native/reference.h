@@ -0,0 +1,268 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "unicode.h"
+
+/**
+ * @file reference.h
+ * @brief Naive reference implementations the fast paths are checked against
+ *
+ * Each is the most direct transcription of the function's definition,
+ * written for obviousness rather than speed.
+ */
+
+namespace pystringpp_test {
+namespace reference {
+
+    inline std::vector<std::size_t> find_all(std::string_view text, std::string_view pattern) {
+        std::vector<std::size_t> positions;
+        if (pattern.empty()) {
+            return positions;
+        }
+        for (std::size_t i = 0; i + pattern.size() <= text.size(); ++i) {
+            if (text.substr(i, pattern.size()) == pattern) {
+                positions.push_back(i);
+            }
+        }
+        return positions;
+    }
+
+    /// find_all on lowered copies of text and pattern (ASCII letters only)
+    inline std::vector<std::size_t> find_all_ascii_fold(std::string_view text, std::string_view pattern) {
+        auto lower = [](std::string_view s) {
+            std::string result(s);
+            for (char& c : result) {
+                if (c >= 'A' && c <= 'Z') {
+                    c = static_cast<char>(c - 'A' + 'a');
+                }
+            }
+            return result;
+        };
+        return find_all(lower(text), lower(pattern));
+    }
+
+    /// Byte offsets where the simple case folded code points of a (valid
+    /// UTF-8) pattern occur in text; malformed text bytes match nothing
+    inline std::vector<std::size_t> find_all_unicode_fold(std::string_view text, std::string_view pattern) {
+        auto fold = [](std::string_view s, std::vector<std::size_t>* offsets) {
+            std::vector<char32_t> codepoints;
+            for (std::size_t i = 0; i < s.size();) {
+                char32_t codepoint;
+                std::size_t length = pystringpp::detail::decode_utf8(s.data() + i, s.size() - i, codepoint);
+                if (length == 0) {
+                    codepoint = 0xffffffff;
+                    length = 1;
+                }
+                codepoints.push_back(pystringpp::detail::simple_casefold(codepoint));
+                if (offsets != nullptr) {
+                    offsets->push_back(i);
+                }
+                i += length;
+            }
+            return codepoints;
+        };
+        std::vector<std::size_t> offsets;
+        const std::vector<char32_t> haystack = fold(text, &offsets);
+        const std::vector<char32_t> needle = fold(pattern, nullptr);
+        std::vector<std::size_t> positions;
+        if (needle.empty()) {
+            return positions;
+        }
+        for (std::size_t k = 0; k + needle.size() <= haystack.size(); ++k) {
+            if (std::equal(needle.begin(), needle.end(), haystack.begin() + k)) {
+                positions.push_back(offsets[k]);
+            }
+        }
+        return positions;
+    }
+
+    /// (end, errors) for every end e in [1, n] where pattern occurs with at
+    /// most k errors: Hamming distance of text[e - m, e), or Sellers' edit
+    /// distance DP with a free start
+    inline std::vector<std::pair<std::size_t, std::size_t>> find_approximate(
+            std::string_view text, std::string_view pattern, std::size_t k, bool edits) {
+        std::vector<std::pair<std::size_t, std::size_t>> matches;
+        const std::size_t m = pattern.size();
+        if (m == 0) {
+            return matches;
+        }
+        if (!edits) {
+            for (std::size_t e = m; e <= text.size(); ++e) {
+                std::size_t errors = 0;
+                for (std::size_t i = 0; i < m; ++i) {
+                    errors += text[e - m + i] != pattern[i] ? 1 : 0;
+                }
+                if (errors <= k) {
+                    matches.emplace_back(e, errors);
+                }
+            }
+            return matches;
+        }
+        // column[i]: fewest edits turning pattern[0, i) into a suffix of text[0, e)
+        std::vector<std::size_t> column(m + 1);
+        for (std::size_t i = 0; i <= m; ++i) {
+            column[i] = i;
+        }
+        for (std::size_t e = 1; e <= text.size(); ++e) {
+            std::size_t diagonal = column[0];
+            for (std::size_t i = 1; i <= m; ++i) {
+                const std::size_t above = column[i];
+                column[i] = std::min({above + 1, column[i - 1] + 1,
+                                      diagonal + (pattern[i - 1] == text[e - 1] ? 0 : 1)});
+                diagonal = above;
+            }
+            if (column[m] <= k) {
+                matches.emplace_back(e, column[m]);
+            }
+        }
+        return matches;
+    }
+
+    /// Suffix start offsets in order of their bytes compared as unsigned
+    inline std::vector<std::uint32_t> suffix_array(std::string_view text) {
+        std::vector<std::uint32_t> sa(text.size());
+        for (std::size_t i = 0; i < sa.size(); ++i) {
+            sa[i] = static_cast<std::uint32_t>(i);
+        }
+        std::sort(sa.begin(), sa.end(), [&](std::uint32_t a, std::uint32_t b) {
+            return text.substr(a) < text.substr(b);
+        });
+        return sa;
+    }
+
+    /// Common prefix length of each suffix with the one before it in sa
+    inline std::vector<std::uint32_t> lcp(std::string_view text, const std::vector<std::uint32_t>& sa) {
+        std::vector<std::uint32_t> lcp(sa.size(), 0);
+        for (std::size_t i = 1; i < sa.size(); ++i) {
+            while (sa[i - 1] + lcp[i] < text.size() && sa[i] + lcp[i] < text.size() &&
+                   text[sa[i - 1] + lcp[i]] == text[sa[i] + lcp[i]]) {
+                ++lcp[i];
+            }
+        }
+        return lcp;
+    }
+
+    inline std::size_t count_char(std::string_view input, char c) {
+        std::size_t count = 0;
+        for (char x : input) {
+            count += x == c ? 1 : 0;
+        }
+        return count;
+    }
+
+    /// Full (m + 1) x (n + 1) Wagner-Fischer table
+    inline std::size_t levenshtein(std::string_view a, std::string_view b) {
+        std::vector<std::vector<std::size_t>> d(a.size() + 1, std::vector<std::size_t>(b.size() + 1));
+        for (std::size_t i = 0; i <= a.size(); ++i) {
+            d[i][0] = i;
+        }
+        for (std::size_t j = 0; j <= b.size(); ++j) {
+            d[0][j] = j;
+        }
+        for (std::size_t i = 1; i <= a.size(); ++i) {
+            for (std::size_t j = 1; j <= b.size(); ++j) {
+                d[i][j] = std::min({d[i-1][j] + 1, d[i][j-1] + 1,
+                                    d[i-1][j-1] + (a[i-1] == b[j-1] ? 0 : 1)});
+            }
+        }
+        return d[a.size()][b.size()];
+    }
+
+    inline std::size_t lcs_length(std::string_view a, std::string_view b) {
+        std::vector<std::vector<std::size_t>> l(a.size() + 1, std::vector<std::size_t>(b.size() + 1, 0));
+        for (std::size_t i = 1; i <= a.size(); ++i) {
+            for (std::size_t j = 1; j <= b.size(); ++j) {
+                l[i][j] = a[i-1] == b[j-1] ? l[i-1][j-1] + 1 : std::max(l[i-1][j], l[i][j-1]);
+            }
+        }
+        return l[a.size()][b.size()];
+    }
+
+    inline bool is_subsequence(std::string_view sub, std::string_view of) {
+        std::size_t j = 0;
+        for (char c : of) {
+            if (j < sub.size() && sub[j] == c) {
+                ++j;
+            }
+        }
+        return j == sub.size();
+    }
+
+    /// A, C, G, T, N counts (either case) and the first byte that is not A/C/G/T
+    struct Dna {
+        std::size_t counts[5] = {0, 0, 0, 0, 0};
+        std::size_t first_invalid;
+    };
+
+    inline Dna dna(std::string_view sequence) {
+        Dna result;
+        result.first_invalid = sequence.size();
+        for (std::size_t i = 0; i < sequence.size(); ++i) {
+            const std::size_t index = std::string_view("ACGTN").find(
+                static_cast<char>(std::toupper(static_cast<unsigned char>(sequence[i]))));
+            if (index != std::string_view::npos) {
+                ++result.counts[index];
+            }
+            if ((index == std::string_view::npos || index == 4) && result.first_invalid == sequence.size()) {
+                result.first_invalid = i;
+            }
+        }
+        return result;
+    }
+
+    /// Reverses well-formed UTF-8 by code point: a character starts at every non-continuation byte
+    inline std::string reverse_utf8(std::string_view input) {
+        std::vector<std::string_view> characters;
+        for (std::size_t i = 0; i < input.size();) {
+            std::size_t j = i + 1;
+            while (j < input.size() && (static_cast<unsigned char>(input[j]) & 0xc0) == 0x80) {
+                ++j;
+            }
+            characters.push_back(input.substr(i, j - i));
+            i = j;
+        }
+        std::string result;
+        for (auto it = characters.rbegin(); it != characters.rend(); ++it) {
+            result += *it;
+        }
+        return result;
+    }
+
+    inline std::map<char, int> count_chars(std::string_view input) {
+        std::map<char, int> counts;
+        for (char c : input) {
+            ++counts[c];
+        }
+        return counts;
+    }
+
+    inline std::string remove_duplicates(std::string_view input) {
+        std::string result;
+        for (char c : input) {
+            if (result.find(c) == std::string::npos) {
+                result += c;
+            }
+        }
+        return result;
+    }
+
+    inline bool is_palindrome(std::string_view input) {
+        std::string cleaned;
+        for (char c : input) {
+            if (std::isalnum(static_cast<unsigned char>(c))) {
+                cleaned += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            }
+        }
+        return std::equal(cleaned.begin(), cleaned.end(), cleaned.rbegin());
+    }
+
+} // namespace reference
+} // namespace pystringpp_test
@@ -0,0 +1,116 @@
+#include "test_harness.h"
+#include "reference.h"
+#include "pystringpp.h"
+#include "internal.h"
+#include <string>
+
+using namespace pystringpp;
+using namespace pystringpp_test;
+
+namespace {
+
+    /// A pair of strings that share most of their content, as real inputs do
+    std::pair<std::string, std::string> similar_pair(std::size_t length, std::string_view alphabet) {
+        const std::string a = random_string(length, alphabet);
+        std::string b = a;
+        const std::size_t edits = uniform(0, length / 4 + 1);
+        for (std::size_t e = 0; e < edits; ++e) {
+            const std::size_t at = b.empty() ? 0 : uniform(0, b.size() - 1);
+            switch (uniform(0, 2)) {
+                case 0:
+                    b.insert(b.begin() + at, alphabet[uniform(0, alphabet.size() - 1)]);
+                    break;
+                case 1:
+                    if (!b.empty()) {
+                        b.erase(b.begin() + at);
+                    }
+                    break;
+                default:
+                    if (!b.empty()) {
+                        b[at] = alphabet[uniform(0, alphabet.size() - 1)];
+                    }
+                    break;
+            }
+        }
+        return {a, b};
+    }
+
+    /// Length up to 200, so both the single-word and blocked paths are hit
+    std::pair<std::string, std::string> random_pair() {
+        const std::string_view alphabet = uniform(0, 1) ? "ab" : "abcdefghij";
+        if (uniform(0, 1)) {
+            return similar_pair(uniform(0, 200), alphabet);
+        }
+        return {random_string(uniform(0, 150), alphabet), random_string(uniform(0, 150), alphabet)};
+    }
+
+} // namespace
+
+PYSTRINGPP_TEST(levenshtein_known_distances) {
+    CHECK_EQ(levenshtein_distance("kitten", "sitting"), std::size_t(3));
+    CHECK_EQ(levenshtein_distance("", ""), std::size_t(0));
+    CHECK_EQ(levenshtein_distance("", "abc"), std::size_t(3));
+    CHECK_EQ(levenshtein_distance("flaw", "lawn"), std::size_t(2));
+    CHECK_EQ(levenshtein_distance("same", "same"), std::size_t(0));
+}
+
+PYSTRINGPP_TEST(levenshtein_random_against_reference) {
+    for (int iteration = 0; iteration < 600; ++iteration) {
+        const auto [a, b] = random_pair();
+        const std::size_t expected = reference::levenshtein(a, b);
+        CHECK_EQ(levenshtein_distance(a, b), expected);
+        CHECK_EQ(levenshtein_distance(b, a), expected);
+        CHECK_EQ(detail::levenshtein_two_row(a, b), expected);
+    }
+}
+
+PYSTRINGPP_TEST(levenshtein_myers_variants_at_word_boundaries) {
+    // Pattern lengths around multiples of 64 exercise the carries between words
+    for (std::size_t m : {1u, 63u, 64u, 65u, 127u, 128u, 129u, 191u}) {
+        for (int iteration = 0; iteration < 5; ++iteration) {
+            const std::string pattern = random_string(m, "acgt");
+            const std::string text = random_string(uniform(m, m + 80), "acgt");
+            const std::size_t expected = reference::levenshtein(pattern, text);
+            if (m <= 64) {
+                CHECK_EQ(detail::levenshtein_myers64(pattern, text), expected);
+            }
+            CHECK_EQ(detail::levenshtein_myers_blocked(pattern, text), expected);
+        }
+    }
+}
+
+PYSTRINGPP_TEST(levenshtein_within_agrees_with_distance) {
+    CHECK(levenshtein_within("kitten", "sitting", 3));
+    CHECK(!levenshtein_within("kitten", "sitting", 2));
+    CHECK(!levenshtein_within("a", "abcdef", 4));
+    for (int iteration = 0; iteration < 600; ++iteration) {
+        const auto [a, b] = random_pair();
+        const std::size_t distance = reference::levenshtein(a, b);
+        const std::size_t k = uniform(0, 1) ? uniform(0, 10) : uniform(0, distance + 2);
+        CHECK_EQ(levenshtein_within(a, b, k), distance <= k);
+        CHECK_EQ(levenshtein_within(b, a, k), distance <= k);
+    }
+}
+
+PYSTRINGPP_TEST(lcs_known_examples) {
+    CHECK_EQ(lcs_length("ABCBDAB", "BDCABA"), std::size_t(4));
+    CHECK_EQ(longest_common_subsequence("ABCBDAB", "BDCABA").size(), std::size_t(4));
+    CHECK_EQ(longest_common_subsequence("", "abc"), std::string());
+    CHECK_EQ(longest_common_subsequence("abc", "abc"), std::string("abc"));
+    CHECK_EQ(longest_common_subsequence("abc", "xyz"), std::string());
+}
+
+PYSTRINGPP_TEST(lcs_random_against_reference) {
+    for (int iteration = 0; iteration < 500; ++iteration) {
+        const auto [a, b] = random_pair();
+        const std::size_t expected = reference::lcs_length(a, b);
+        CHECK_EQ(lcs_length(a, b), expected);
+        CHECK_EQ(lcs_length(b, a), expected);
+
+        // Any LCS may be returned, so check it is one rather than compare text
+        const std::string lcs = longest_common_subsequence(a, b);
+        CHECK_EQ(lcs.size(), expected);
+        CHECK(reference::is_subsequence(lcs, a));
+        CHECK(reference::is_subsequence(lcs, b));
+    }
+}
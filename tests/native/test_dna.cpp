@@ -0,0 +1,255 @@
+#include "test_harness.h"
+#include "reference.h"
+#include "pystringpp.h"
+#include "simd.h"
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if PYSTRINGPP_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+using namespace pystringpp;
+using namespace pystringpp_test;
+
+namespace {
+
+    /// Mostly-valid DNA, arbitrary DNA-like bytes, or raw bytes
+    std::string random_sequence(std::size_t length) {
+        switch (uniform(0, 2)) {
+            case 0: {
+                std::string s = random_string(length, "ACGTacgt");
+                if (length > 0 && uniform(0, 1)) {
+                    s[uniform(0, length - 1)] = static_cast<char>(uniform(0, 255));
+                }
+                return s;
+            }
+            case 1:
+                return random_string(length, std::string_view("ACGTNacgtnXx\x80\xc1\x41\x00", 16));
+            default:
+                return random_bytes(length);
+        }
+    }
+
+    /// Temporary file removed when the test ends
+    class TempFile {
+    public:
+        explicit TempFile(const std::string& suffix)
+            : path_(std::filesystem::temp_directory_path() /
+                    ("pystringpp_test_" + std::to_string(engine()()) + suffix)) {}
+        ~TempFile() {
+            std::error_code ignored;
+            std::filesystem::remove(path_, ignored);
+        }
+
+        std::string path() const { return path_.string(); }
+
+        void write(const std::string& contents) const {
+            std::ofstream out(path_, std::ios::binary);
+            out << contents;
+        }
+
+    private:
+        std::filesystem::path path_;
+    };
+
+    struct Record {
+        std::string name;
+        std::string sequence;
+        std::string quality;
+    };
+
+    std::vector<Record> read_all(SequenceReader& reader) {
+        std::vector<Record> records;
+        SequenceRecord record;
+        while (reader.next(record)) {
+            records.push_back({std::string(record.name), std::string(record.sequence), std::string(record.quality)});
+            CHECK_EQ(record.stats.length, record.sequence.size());
+            CHECK_EQ(record.stats.first_invalid, dna_stats(record.sequence).first_invalid);
+        }
+        return records;
+    }
+
+    /// Random records and their serialization, with wrapped lines, blank lines and CRLF
+    std::string random_file(bool fastq, std::vector<Record>& records) {
+        const char* newline = uniform(0, 3) == 0 ? "\r\n" : "\n";
+        std::string file = uniform(0, 2) == 0 ? newline : "";
+        const std::size_t count = uniform(0, 30);
+        for (std::size_t r = 0; r < count; ++r) {
+            Record record;
+            record.name = "r" + std::to_string(r) + " description";
+            record.sequence = random_string(uniform(0, 2) == 0 ? uniform(0, 20000) : uniform(0, 200), "ACGTNacgt");
+            const bool last = r + 1 == count;
+            if (fastq) {
+                record.quality = random_string(record.sequence.size(), "!#5?IJ");
+                file += "@" + record.name + newline + record.sequence + newline + "+" + newline + record.quality;
+                if (!last || uniform(0, 1)) {
+                    file += newline;
+                }
+            } else {
+                file += ">" + record.name + newline;
+                const std::size_t width = uniform(1, 100);
+                for (std::size_t i = 0; i < record.sequence.size(); i += width) {
+                    file += record.sequence.substr(i, width);
+                    if (i + width < record.sequence.size() || !last || uniform(0, 1)) {
+                        file += newline;
+                    }
+                    if (uniform(0, 9) == 0) {
+                        file += newline;
+                    }
+                }
+            }
+            records.push_back(record);
+        }
+        return file;
+    }
+
+    void check_records(const std::vector<Record>& got, const std::vector<Record>& expected) {
+        CHECK_EQ(got.size(), expected.size());
+        for (std::size_t i = 0; i < got.size(); ++i) {
+            CHECK_EQ(got[i].name, expected[i].name);
+            CHECK_EQ(got[i].sequence, expected[i].sequence);
+            CHECK_EQ(got[i].quality, expected[i].quality);
+        }
+    }
+
+} // namespace
+
+PYSTRINGPP_TEST(dna_kernels_against_reference) {
+    const detail::Kernels& kernels = detail::kernels();
+    for (int iteration = 0; iteration < 4000; ++iteration) {
+        const std::string s = random_sequence(uniform(0, iteration < 1000 ? 100 : 5000));
+        const reference::Dna expected = reference::dna(s);
+        const std::size_t gc = expected.counts[1] + expected.counts[2];
+
+        CHECK_EQ(kernels.dna_first_invalid(s.data(), s.size()), expected.first_invalid);
+        CHECK_EQ(detail::dna_first_invalid_scalar(s.data(), s.size()), expected.first_invalid);
+        CHECK_EQ(kernels.count_gc(s.data(), s.size()), gc);
+        CHECK_EQ(detail::count_gc_scalar(s.data(), s.size()), gc);
+
+        std::size_t counts[5] = {0, 0, 0, 0, 0};
+        CHECK_EQ(kernels.dna_stats(s.data(), s.size(), counts), expected.first_invalid);
+        const std::vector<std::size_t> got(counts, counts + 5);
+        CHECK_EQ(got, std::vector<std::size_t>(expected.counts, expected.counts + 5));
+    }
+}
+
+PYSTRINGPP_TEST(dna_kernels_long_runs_flush_counters) {
+    const detail::Kernels& kernels = detail::kernels();
+    const std::string run(300000, 'G');
+    std::size_t counts[5] = {0, 0, 0, 0, 0};
+    CHECK_EQ(kernels.dna_stats(run.data(), run.size(), counts), run.size());
+    CHECK_EQ(counts[2], run.size());
+    CHECK_EQ(kernels.count_gc(run.data(), run.size()), run.size());
+}
+
+PYSTRINGPP_TEST(validate_dna_and_gc_content) {
+    CHECK(validate_dna("ATGC"));
+    CHECK(validate_dna("atgc"));
+    CHECK(validate_dna(""));
+    CHECK(!validate_dna("ATGX"));
+    CHECK(!validate_dna("ATGN"));
+    CHECK_EQ(calculate_gc_content("ATGC"), 50.0);
+    CHECK_EQ(calculate_gc_content("GCGC"), 100.0);
+    CHECK_EQ(calculate_gc_content(""), 0.0);
+
+    for (int iteration = 0; iteration < 500; ++iteration) {
+        const std::string s = random_sequence(uniform(0, 1000));
+        const reference::Dna expected = reference::dna(s);
+        CHECK_EQ(validate_dna(s), expected.first_invalid == s.size());
+        const double gc = s.empty() ? 0.0 : 100.0 * (expected.counts[1] + expected.counts[2]) / s.size();
+        CHECK(std::fabs(calculate_gc_content(s) - gc) < 1e-9);
+    }
+}
+
+PYSTRINGPP_TEST(dna_stats_matches_single_functions) {
+    const DnaStats empty = dna_stats("");
+    CHECK(empty.valid);
+    CHECK_EQ(empty.first_invalid, DnaStats::npos);
+    CHECK_EQ(empty.gc_content(), 0.0);
+
+    for (int iteration = 0; iteration < 500; ++iteration) {
+        const std::string s = random_sequence(uniform(0, 1000));
+        const reference::Dna expected = reference::dna(s);
+        const DnaStats stats = dna_stats(s);
+        CHECK_EQ(stats.valid, validate_dna(s));
+        CHECK_EQ(stats.first_invalid, stats.valid ? DnaStats::npos : expected.first_invalid);
+        CHECK_EQ(stats.length, s.size());
+        CHECK_EQ(stats.a, expected.counts[0]);
+        CHECK_EQ(stats.c, expected.counts[1]);
+        CHECK_EQ(stats.g, expected.counts[2]);
+        CHECK_EQ(stats.t, expected.counts[3]);
+        CHECK_EQ(stats.n, expected.counts[4]);
+        CHECK(std::fabs(stats.gc_content() - calculate_gc_content(s)) < 1e-9);
+    }
+}
+
+PYSTRINGPP_TEST(gc_content_batch_matches_single_calls) {
+    std::vector<std::string> storage;
+    for (int i = 0; i < 50; ++i) {
+        storage.push_back(random_sequence(uniform(0, 200)));
+    }
+    const std::vector<std::string_view> sequences(storage.begin(), storage.end());
+    const std::vector<double> gc = gc_content_batch(sequences);
+    CHECK_EQ(gc.size(), sequences.size());
+    for (std::size_t i = 0; i < sequences.size(); ++i) {
+        CHECK_EQ(gc[i], calculate_gc_content(sequences[i]));
+    }
+}
+
+PYSTRINGPP_TEST(sequence_reader_random_files) {
+    for (int iteration = 0; iteration < 60; ++iteration) {
+        const bool fastq = uniform(0, 1);
+        std::vector<Record> expected;
+        const std::string contents = random_file(fastq, expected);
+        TempFile file(fastq ? ".fastq" : ".fasta");
+        file.write(contents);
+
+        // A small buffer forces refills and growth in the middle of records
+        SequenceReader reader(file.path(), SequenceReader::Format::Auto, uniform(0, 1) ? 4096 : 1 << 20);
+        check_records(read_all(reader), expected);
+        CHECK_EQ(reader.records(), expected.size());
+
+        std::string all;
+        for (const Record& record : expected) {
+            all += record.sequence;
+        }
+        const DnaStats totals = dna_stats(all);
+        CHECK_EQ(reader.totals().length, totals.length);
+        CHECK_EQ(reader.totals().first_invalid, totals.first_invalid);
+        CHECK_EQ(reader.totals().g + reader.totals().c, totals.g + totals.c);
+        CHECK_EQ(reader.totals().n, totals.n);
+        if (!expected.empty()) {
+            CHECK(reader.format() == (fastq ? SequenceReader::Format::Fastq : SequenceReader::Format::Fasta));
+        }
+    }
+}
+
+#if PYSTRINGPP_HAVE_ZLIB
+PYSTRINGPP_TEST(sequence_reader_gzip_input) {
+    std::vector<Record> expected;
+    const std::string contents = random_file(true, expected);
+    TempFile file(".fastq.gz");
+    gzFile out = gzopen(file.path().c_str(), "wb");
+    CHECK(out != nullptr);
+    gzwrite(out, contents.data(), static_cast<unsigned>(contents.size()));
+    gzclose(out);
+
+    SequenceReader reader(file.path(), SequenceReader::Format::Auto, 4096);
+    check_records(read_all(reader), expected);
+}
+#endif
+
+PYSTRINGPP_TEST(sequence_reader_malformed_input) {
+    TempFile file(".fastq");
+    file.write("@a\nAC\n+\nA\n");
+    SequenceReader reader(file.path());
+    SequenceRecord record;
+    CHECK_THROWS(reader.next(record), std::runtime_error);
+    CHECK_THROWS(SequenceReader("/nonexistent/pystringpp/input.fa"), std::runtime_error);
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @file test_harness.h
+ * @brief Minimal self-contained test harness for the native test suite
+ *
+ * Tests are free functions registered with PYSTRINGPP_TEST(name) and run by
+ * test_main.cpp. A failed CHECK throws, which ends the current test and marks
+ * it failed; the remaining tests still run. Randomized tests draw from
+ * engine(), which is reseeded per test from the run seed (printed at start,
+ * overridable with PYSTRINGPP_TEST_SEED) and the test name, so any failure
+ * can be replayed on its own.
+ */
+
+namespace pystringpp_test {
+
+    struct TestCase {
+        const char* name;
+        void (*body)();
+    };
+
+    /// Registered tests, in definition order per translation unit
+    inline std::vector<TestCase>& registry() {
+        static std::vector<TestCase> tests;
+        return tests;
+    }
+
+    struct Registrar {
+        Registrar(const char* name, void (*body)()) { registry().push_back({name, body}); }
+    };
+
+    /// Thrown by a failed check
+    class Failure : public std::runtime_error {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    /// Random engine of the running test
+    inline std::mt19937_64& engine() {
+        static std::mt19937_64 engine;
+        return engine;
+    }
+
+    /// Uniform integer in [lo, hi]
+    inline std::size_t uniform(std::size_t lo, std::size_t hi) {
+        return std::uniform_int_distribution<std::size_t>(lo, hi)(engine());
+    }
+
+    /// Random string of the given length over the given alphabet
+    inline std::string random_string(std::size_t length, std::string_view alphabet) {
+        std::string s(length, '\0');
+        for (char& c : s) {
+            c = alphabet[uniform(0, alphabet.size() - 1)];
+        }
+        return s;
+    }
+
+    /// Random string over all 256 byte values
+    inline std::string random_bytes(std::size_t length) {
+        std::string s(length, '\0');
+        for (char& c : s) {
+            c = static_cast<char>(uniform(0, 255));
+        }
+        return s;
+    }
+
+    template <typename A, typename B>
+    std::string describe(const std::pair<A, B>& value);
+
+    /// Printable form of a value for failure messages
+    template <typename T>
+    std::string describe(const T& value) {
+        std::ostringstream out;
+        if constexpr (std::is_same_v<T, char>) {
+            out << "byte " << static_cast<int>(static_cast<unsigned char>(value));
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            const std::string_view view(value);
+            out << '"' << view.substr(0, 64) << (view.size() > 64 ? "...\"" : "\"")
+                << " (length " << view.size() << ")";
+        } else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+            if constexpr (std::is_enum_v<T>) {
+                out << static_cast<long long>(value);
+            } else {
+                out << value;
+            }
+        } else {
+            // Containers: size and the first few elements
+            out << "[size " << value.size() << ":";
+            std::size_t shown = 0;
+            for (const auto& element : value) {
+                if (shown++ == 8) {
+                    out << " ...";
+                    break;
+                }
+                out << ' ' << describe(element);
+            }
+            out << ']';
+        }
+        return out.str();
+    }
+
+    template <typename A, typename B>
+    std::string describe(const std::pair<A, B>& value) {
+        return "(" + describe(value.first) + ", " + describe(value.second) + ")";
+    }
+
+    [[noreturn]] inline void fail(const char* file, int line, const std::string& message) {
+        throw Failure(std::string(file) + ":" + std::to_string(line) + ": " + message);
+    }
+
+} // namespace pystringpp_test
+
+#define PYSTRINGPP_TEST(name)                                                          \
+    static void name();                                                                \
+    static const ::pystringpp_test::Registrar name##_registrar(#name, &name);          \
+    static void name()
+
+#define CHECK(condition)                                                               \
+    do {                                                                               \
+        if (!(condition)) {                                                            \
+            ::pystringpp_test::fail(__FILE__, __LINE__, "CHECK(" #condition ") failed"); \
+        }                                                                              \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                                     \
+    do {                                                                               \
+        const auto check_actual_ = (actual);                                           \
+        const auto check_expected_ = (expected);                                       \
+        if (!(check_actual_ == check_expected_)) {                                     \
+            ::pystringpp_test::fail(__FILE__, __LINE__,                                \
+                                    "CHECK_EQ(" #actual ", " #expected ") failed: " +  \
+                                        ::pystringpp_test::describe(check_actual_) + " != " + \
+                                        ::pystringpp_test::describe(check_expected_)); \
+        }                                                                              \
+    } while (0)
+
+#define CHECK_THROWS(statement, exception_type)                                        \
+    do {                                                                               \
+        bool check_thrown_ = false;                                                    \
+        try {                                                                          \
+            statement;                                                                 \
+        } catch (const exception_type&) {                                              \
+            check_thrown_ = true;                                                      \
+        }                                                                              \
+        if (!check_thrown_) {                                                          \
+            ::pystringpp_test::fail(__FILE__, __LINE__,                                \
+                                    #statement " did not throw " #exception_type);     \
+        }                                                                              \
+    } while (0)
@@ -0,0 +1,70 @@
+#include "test_harness.h"
+#include "pystringpp.h"
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <string>
+
+/**
+ * Runs the native test suite.
+ *
+ * Usage: pystringpp_tests [--list] [filter]
+ *   filter   Run only tests whose name contains this substring
+ *
+ * Environment:
+ *   PYSTRINGPP_TEST_SEED   Seed for the randomized tests (default: fixed)
+ *   PYSTRINGPP_FORCE_SIMD  Cap the SIMD kernels, as for the library itself
+ */
+
+int main(int argc, char** argv) {
+    using namespace pystringpp_test;
+
+    std::string filter;
+    bool list = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--list") {
+            list = true;
+        } else {
+            filter = arg;
+        }
+    }
+
+    if (list) {
+        for (const TestCase& test : registry()) {
+            std::printf("%s\n", test.name);
+        }
+        return 0;
+    }
+
+    std::uint64_t seed = 0x5eed;
+    if (const char* value = std::getenv("PYSTRINGPP_TEST_SEED")) {
+        seed = std::strtoull(value, nullptr, 0);
+    }
+    std::printf("seed %llu, simd %s\n", static_cast<unsigned long long>(seed), pystringpp::simd_level());
+
+    std::size_t run = 0;
+    std::size_t failed = 0;
+    for (const TestCase& test : registry()) {
+        if (std::string(test.name).find(filter) == std::string::npos) {
+            continue;
+        }
+        ++run;
+        engine().seed(seed ^ std::hash<std::string>{}(test.name));
+        try {
+            test.body();
+            std::printf("[ OK   ] %s\n", test.name);
+        } catch (const Failure& failure) {
+            ++failed;
+            std::printf("[ FAIL ] %s\n         %s\n", test.name, failure.what());
+        } catch (const std::exception& error) {
+            ++failed;
+            std::printf("[ FAIL ] %s\n         unexpected exception: %s\n", test.name, error.what());
+        }
+        std::fflush(stdout);
+    }
+
+    std::printf("%zu test(s), %zu failed\n", run, failed);
+    return failed == 0 && run > 0 ? 0 : 1;
+}
@@ -0,0 +1,489 @@
+#include "test_harness.h"
+#include "reference.h"
+#include "pystringpp.h"
+#include "simd.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace pystringpp;
+using namespace pystringpp_test;
+
+namespace {
+
+    /// A random needle over `alphabet` letters starting at 'a', periodic half of the time
+    std::string random_needle(std::size_t length, std::size_t alphabet) {
+        const std::string letters = std::string("abcdefgh").substr(0, alphabet);
+        if (length == 0 || uniform(0, 1) == 0) {
+            return random_string(length, letters);
+        }
+        const std::string unit = random_string(uniform(1, 5), letters);
+        std::string needle;
+        while (needle.size() < length) {
+            needle += unit;
+        }
+        needle.resize(length);
+        if (uniform(0, 2) == 0) {
+            needle[uniform(0, length - 1)] = letters[uniform(0, alphabet - 1)];
+        }
+        return needle;
+    }
+
+    /// A random text seeded with whole and partial copies of the needle
+    std::string random_haystack(std::size_t length, std::string_view needle, std::size_t alphabet) {
+        const std::string letters = std::string("abcdefgh").substr(0, alphabet);
+        std::string text;
+        while (text.size() < length) {
+            if (uniform(0, 3) == 0) {
+                text += needle.substr(0, uniform(0, needle.size()));
+            } else {
+                text += letters[uniform(0, alphabet - 1)];
+            }
+        }
+        return text;
+    }
+
+    std::vector<std::pair<std::size_t, std::size_t>> naive_multi(std::string_view text,
+                                                                 const std::vector<std::string>& patterns) {
+        std::vector<std::pair<std::size_t, std::size_t>> matches;
+        for (std::size_t id = 0; id < patterns.size(); ++id) {
+            for (std::size_t offset : reference::find_all(text, patterns[id])) {
+                matches.emplace_back(id, offset);
+            }
+        }
+        std::sort(matches.begin(), matches.end(), [](const auto& a, const auto& b) {
+            return a.second != b.second ? a.second < b.second : a.first < b.first;
+        });
+        return matches;
+    }
+
+} // namespace
+
+PYSTRINGPP_TEST(find_pattern_known_examples) {
+    using positions = std::vector<std::size_t>;
+    CHECK_EQ(find_pattern("abcabcabc", "abc"), (positions{0, 3, 6}));
+    CHECK_EQ(find_pattern("aaaa", "aa"), (positions{0, 1, 2}));
+    CHECK_EQ(find_pattern("hello", ""), positions{});
+    CHECK_EQ(find_pattern("", "a"), positions{});
+    CHECK_EQ(find_pattern("ab", "abc"), positions{});
+    CHECK_EQ(find_pattern("Hello hello", "hello"), positions{6});
+}
+
+PYSTRINGPP_TEST(pattern_algorithm_selection) {
+    CHECK(Pattern("").algorithm() == Pattern::Algorithm::Empty);
+    CHECK(Pattern("x").algorithm() == Pattern::Algorithm::Memchr);
+    CHECK(Pattern("needle").algorithm() == Pattern::Algorithm::Prefilter);
+    CHECK(Pattern(std::string(64, 'a') + "b").algorithm() == Pattern::Algorithm::TwoWay);
+}
+
+PYSTRINGPP_TEST(pattern_random_against_reference) {
+    std::size_t seen[4] = {0, 0, 0, 0};
+    for (int iteration = 0; iteration < 6000; ++iteration) {
+        const std::size_t alphabet = uniform(1, 4);
+        const std::size_t length = uniform(1, uniform(0, 2) ? 40 : 100);
+        const std::string needle = random_needle(length, alphabet);
+        const std::string text = random_haystack(uniform(0, 2000), needle, alphabet);
+        const std::vector<std::size_t> expected = reference::find_all(text, needle);
+
+        const Pattern pattern(needle);
+        ++seen[static_cast<int>(pattern.algorithm())];
+        CHECK_EQ(pattern.find_all(text), expected);
+        CHECK_EQ(pattern.count(text), expected.size());
+        CHECK_EQ(pattern.contains(text), !expected.empty());
+        CHECK_EQ(pattern.find_first(text), expected.empty() ? Pattern::npos : expected.front());
+        CHECK_EQ(find_pattern(text, needle), expected);
+    }
+    // Every non-empty algorithm must actually have been exercised
+    CHECK(seen[1] > 0 && seen[2] > 0 && seen[3] > 0);
+}
+
+PYSTRINGPP_TEST(pattern_binary_needles) {
+    for (int iteration = 0; iteration < 500; ++iteration) {
+        const std::string text = random_bytes(uniform(0, 3000));
+        std::string needle = random_bytes(uniform(1, 80));
+        if (!text.empty() && uniform(0, 1) == 0) {
+            const std::size_t start = uniform(0, text.size() - 1);
+            needle = text.substr(start, uniform(1, 80));
+        }
+        CHECK_EQ(Pattern(needle).find_all(text), reference::find_all(text, needle));
+    }
+}
+
+PYSTRINGPP_TEST(pattern_prefilter_adversarial_fallback) {
+    // Every window passes the byte-pair prefilter; the KMP fallback must
+    // still return exactly the true matches
+    std::string text(1 << 16, 'a');
+    text[5000] = 'b';
+    std::string needle(20, 'a');
+    needle[10] = 'b';
+    CHECK_EQ(Pattern(needle).find_all(text), reference::find_all(text, needle));
+    CHECK_EQ(Pattern(std::string(20, 'a')).count(text), reference::find_all(text, std::string(20, 'a')).size());
+}
+
+PYSTRINGPP_TEST(find_pattern_case_folding_known_examples) {
+    using positions = std::vector<std::size_t>;
+    const auto ascii = Pattern::CaseMode::AsciiFold;
+    const auto unicode = Pattern::CaseMode::UnicodeFold;
+    CHECK_EQ(find_pattern("Error, ERROR, error", "eRRor", ascii), (positions{0, 7, 14}));
+    CHECK_EQ(find_pattern("Hello hello", "hello", ascii), (positions{0, 6}));
+    // '@' and '`' differ from each other only in the case bit, but are not letters
+    CHECK_EQ(find_pattern("@`", "`", ascii), positions{1});
+    CHECK_EQ(find_pattern("a@b", "A`B", ascii), positions{});
+    CHECK_EQ(find_pattern("\xc3\x89T\xc3\xa9", "\xc3\xa9t", ascii), positions{});
+    CHECK_EQ(find_pattern("\xc3\x89T\xc3\xa9", "\xc3\xa9t", unicode), positions{0});
+    // Long s folds to s, final sigma to sigma, capital sharp s to sharp s
+    CHECK_EQ(find_pattern("Mi\xc5\xbfsiSSippi", "SS", unicode), (positions{2, 6}));
+    CHECK_EQ(find_pattern("\xce\xa3\xcf\x83\xcf\x82", "\xcf\x83", unicode), (positions{0, 2, 4}));
+    CHECK_EQ(find_pattern("Stra\xe1\xba\x9e" "e", "\xc3\x9f" "E", unicode), positions{4});
+    CHECK_EQ(find_pattern("STRASSE", "stra\xc3\x9f" "e", unicode), positions{});
+    // Folds outside Latin-1: Latin Extended-B, Greek Extended, Georgian, Cherokee
+    CHECK_EQ(find_pattern("\xc6\xa1 \xc6\xa0", "\xc6\xa0", unicode), (positions{0, 3}));
+    CHECK_EQ(find_pattern("TR\xc6\xaf\xe1\xbb\x9cNG", "tr\xc6\xb0\xe1\xbb\x9dng", unicode), positions{0});
+    CHECK_EQ(find_pattern("\xe1\xbc\x80\xe1\xbc\x88", "\xe1\xbc\x88", unicode), (positions{0, 3}));
+    CHECK_EQ(find_pattern("\xe1\x82\xa0\xe2\xb4\x80", "\xe2\xb4\x80", unicode), (positions{0, 3}));
+    CHECK_EQ(find_pattern("\xea\xad\xb0", "\xe1\x8e\xa0", unicode), positions{0});
+    CHECK_EQ(detail::simple_casefold(0x01a0), char32_t(0x01a1));
+    CHECK_EQ(detail::simple_casefold(0x1f88), char32_t(0x1f80));
+    CHECK_EQ(detail::simple_casefold(0x10c5), char32_t(0x2d25));
+    CHECK_EQ(detail::simple_casefold(0x13f8), char32_t(0x13f0));
+    CHECK_EQ(detail::simple_casefold(0x1e900), char32_t(0x1e922));
+    CHECK_EQ(detail::simple_casefold(0x01a1), char32_t(0x01a1));
+    // Kelvin and Angstrom signs fold to k and a with ring above
+    CHECK_EQ(find_pattern("\xe2\x84\xaa" "elvin kELVIN", "Kelvin", unicode), (positions{0, 9}));
+    CHECK_EQ(find_pattern("5 \xe2\x84\xab, 5 \xc3\x85", "\xc3\xa5", unicode), (positions{2, 9}));
+    // Malformed text bytes never match; a malformed needle is rejected
+    CHECK_EQ(find_pattern("\xff" "ab\xc3" "AB", "ab", unicode), (positions{1, 4}));
+    CHECK_THROWS(find_pattern("abc", "a\xff", unicode), std::invalid_argument);
+    
+    CHECK(Pattern("Needle", ascii).pattern() == "needle");
+    CHECK(Pattern("Needle", unicode).algorithm() == Pattern::Algorithm::Prefilter);
+    CHECK(Pattern("Ask", unicode).algorithm() == Pattern::Algorithm::CodePoints);
+    CHECK(Pattern("\xc3\x89t\xc3\xa9", unicode).algorithm() == Pattern::Algorithm::CodePoints);
+    CHECK(Pattern("\xc3\x89t\xc3\xa9", unicode).pattern() == "\xc3\xa9t\xc3\xa9");
+}
+
+PYSTRINGPP_TEST(pattern_ascii_fold_random_against_reference) {
+    // Mixed case text and needles over few letters, plus the non-letters
+    // next to them in the case bit, across every byte algorithm
+    const std::string letters = "abAB@`[{";
+    std::size_t seen[5] = {0, 0, 0, 0, 0};
+    for (int iteration = 0; iteration < 4000; ++iteration) {
+        const std::string needle = random_string(uniform(1, uniform(0, 2) ? 12 : 80), letters.substr(0, uniform(2, 8)));
+        std::string text = random_haystack(uniform(0, 1500), needle, 2);
+        for (char& c : text) {
+            if (uniform(0, 3) == 0) {
+                c = letters[uniform(0, letters.size() - 1)];
+            } else if (c >= 'a' && c <= 'z' && uniform(0, 1) == 0) {
+                c = static_cast<char>(c - 'a' + 'A');
+            }
+        }
+        const std::vector<std::size_t> expected = reference::find_all_ascii_fold(text, needle);
+        
+        const Pattern pattern(needle, Pattern::CaseMode::AsciiFold);
+        ++seen[static_cast<int>(pattern.algorithm())];
+        CHECK_EQ(pattern.find_all(text), expected);
+        CHECK_EQ(pattern.count(text), expected.size());
+        CHECK_EQ(pattern.find_first(text), expected.empty() ? Pattern::npos : expected.front());
+    }
+    CHECK(seen[1] > 0 && seen[2] > 0 && seen[3] > 0);
+}
+
+PYSTRINGPP_TEST(pattern_unicode_fold_random_against_reference) {
+    // Units that fold together across different encoded lengths, ASCII runs
+    // for the skip paths, and a malformed byte
+    const std::vector<std::string> units = {
+        "a", "A", "s", "S", "k", "K", "\xe2\x84\xaa", "xyzzy", "\xc5\xbf", "\xc3\x9f", "\xe1\xba\x9e",
+        "\xc3\xa5", "\xe2\x84\xab",
+        "\xcf\x83", "\xce\xa3", "\xcf\x82", "\xc3\xa9", "\xc3\x89", "\xe6\x97\xa5", "\xff",
+    };
+    for (int iteration = 0; iteration < 3000; ++iteration) {
+        std::string needle;
+        for (std::size_t i = uniform(1, 6); i > 0; --i) {
+            needle += units[uniform(0, units.size() - 2)];
+        }
+        std::string text;
+        for (std::size_t i = uniform(0, 200); i > 0; --i) {
+            text += uniform(0, 5) == 0 ? needle : units[uniform(0, units.size() - 1)];
+        }
+        const Pattern pattern(needle, Pattern::CaseMode::UnicodeFold);
+        const std::vector<std::size_t> expected = reference::find_all_unicode_fold(text, needle);
+        CHECK_EQ(pattern.find_all(text), expected);
+        CHECK_EQ(find_pattern(text, needle, Pattern::CaseMode::UnicodeFold), expected);
+    }
+}
+
+PYSTRINGPP_TEST(find_byte_pair_fold_kernel_against_scalar) {
+    const detail::Kernels& kernels = detail::kernels();
+    for (int iteration = 0; iteration < 3000; ++iteration) {
+        const std::string data = random_string(uniform(1, 300), "aAbB@`");
+        const std::size_t offset1 = uniform(0, std::min<std::size_t>(data.size() - 1, 20));
+        const std::size_t offset2 = uniform(0, std::min<std::size_t>(data.size() - 1, 20));
+        const std::size_t count = data.size() - std::max(offset1, offset2);
+        const char byte1 = "ab`"[uniform(0, 2)];
+        const char byte2 = "ab`"[uniform(0, 2)];
+        const std::size_t expected = detail::find_byte_pair_fold_scalar(data.data(), count, offset1, byte1, offset2, byte2);
+        CHECK_EQ(kernels.find_byte_pair_fold(data.data(), count, offset1, byte1, offset2, byte2), expected);
+        std::size_t naive = 0;
+        auto lower = [](char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; };
+        while (naive < count && !(lower(data[naive + offset1]) == byte1 && lower(data[naive + offset2]) == byte2)) {
+            ++naive;
+        }
+        CHECK_EQ(expected, naive);
+    }
+}
+
+namespace {
+
+    std::vector<std::pair<std::size_t, std::size_t>> as_pairs(const std::vector<ApproximateMatch>& matches) {
+        std::vector<std::pair<std::size_t, std::size_t>> pairs;
+        for (const ApproximateMatch& match : matches) {
+            pairs.emplace_back(match.end, match.errors);
+        }
+        return pairs;
+    }
+
+} // namespace
+
+PYSTRINGPP_TEST(find_approximate_known_examples) {
+    using matches = std::vector<ApproximateMatch>;
+    CHECK(find_approximate("ACGTTGCA", "ACGA", 1) == (matches{{4, 1}}));
+    CHECK(find_approximate("ACGTTGCA", "ACGA", 0).empty());
+    CHECK(find_approximate("abc", "", 2).empty());
+    CHECK(find_approximate("", "abc", 2, ErrorModel::Edits).empty());
+    // "ACG" (last byte deleted) and "ACGx" (substituted) end at different offsets
+    CHECK(find_approximate("xxACGxx", "ACGA", 1, ErrorModel::Edits) == (matches{{5, 1}, {6, 1}}));
+    CHECK(find_approximate("xxACGxx", "ACGA", 1) == (matches{{6, 1}}));
+    CHECK(find_approximate("xxACGTAxx", "ACGA", 1, ErrorModel::Edits) == (matches{{5, 1}, {6, 1}, {7, 1}}));
+    // k at least m accepts every end, with the true distance
+    CHECK(find_approximate("zz", "ab", 5, ErrorModel::Edits) == (matches{{1, 2}, {2, 2}}));
+    CHECK(find_approximate("azb", "ab", 99) == (matches{{2, 1}, {3, 1}}));
+}
+
+PYSTRINGPP_TEST(find_approximate_random_against_reference) {
+    // Short patterns take the single-word path, longer ones the blocked one,
+    // including lengths at the 64-bit word boundaries
+    const std::size_t lengths[] = {1, 2, 5, 17, 63, 64, 65, 100, 128, 129, 200};
+    for (int iteration = 0; iteration < 600; ++iteration) {
+        const std::size_t m = lengths[uniform(0, sizeof(lengths) / sizeof(lengths[0]) - 1)];
+        const std::string pattern = random_string(m, "ACGT");
+        std::string text;
+        while (text.size() < uniform(0, 600)) {
+            if (uniform(0, 2) == 0) {
+                // A copy of the pattern with a few random edits
+                std::string copy = pattern;
+                for (std::size_t e = uniform(0, 3); e > 0 && !copy.empty(); --e) {
+                    const std::size_t at = uniform(0, copy.size() - 1);
+                    switch (uniform(0, 2)) {
+                        case 0: copy[at] = "ACGT"[uniform(0, 3)]; break;
+                        case 1: copy.erase(at, 1); break;
+                        default: copy.insert(at, 1, "ACGT"[uniform(0, 3)]); break;
+                    }
+                }
+                text += copy;
+            } else {
+                text += random_string(uniform(1, 30), "ACGT");
+            }
+        }
+        const std::size_t k = uniform(0, std::min<std::size_t>(m, 6));
+        for (bool edits : {false, true}) {
+            const auto model = edits ? ErrorModel::Edits : ErrorModel::Substitutions;
+            CHECK_EQ(as_pairs(find_approximate(text, pattern, k, model)),
+                     reference::find_approximate(text, pattern, k, edits));
+        }
+    }
+}
+
+PYSTRINGPP_TEST(find_byte_pair_kernel_against_scalar) {
+    const detail::Kernels& kernels = detail::kernels();
+    for (int iteration = 0; iteration < 3000; ++iteration) {
+        const std::string data = random_string(uniform(1, 300), "abc");
+        const std::size_t offset1 = uniform(0, std::min<std::size_t>(data.size() - 1, 20));
+        const std::size_t offset2 = uniform(0, std::min<std::size_t>(data.size() - 1, 20));
+        const std::size_t count = data.size() - std::max(offset1, offset2);
+        const char byte1 = "abc"[uniform(0, 2)];
+        const char byte2 = "abc"[uniform(0, 2)];
+        CHECK_EQ(kernels.find_byte_pair(data.data(), count, offset1, byte1, offset2, byte2),
+                 detail::find_byte_pair_scalar(data.data(), count, offset1, byte1, offset2, byte2));
+    }
+}
+
+PYSTRINGPP_TEST(find_pattern_parallel_matches_sequential) {
+    for (int iteration = 0; iteration < 40; ++iteration) {
+        const std::string needle = random_needle(uniform(1, 12), 2);
+        const std::string text = random_haystack(uniform(0, 200000), needle, 2);
+        const std::size_t threads = uniform(0, 6);
+        // A tiny threshold forces chunking even on short texts
+        CHECK_EQ(find_pattern_parallel(text, needle, threads, uniform(1, 5000)), reference::find_all(text, needle));
+    }
+    CHECK(find_pattern_parallel("", "a", 4, 1).empty());
+    CHECK(find_pattern_parallel("abc", "", 4, 1).empty());
+}
+
+PYSTRINGPP_TEST(find_pattern_batch_matches_single_calls) {
+    std::vector<std::string> storage;
+    for (int i = 0; i < 60; ++i) {
+        storage.push_back(random_haystack(uniform(0, 300), "aba", 2));
+    }
+    const std::vector<std::string_view> texts(storage.begin(), storage.end());
+    const BatchMatches batch = find_pattern_batch(texts, "aba");
+    CHECK_EQ(batch.offsets.size(), texts.size() + 1);
+    CHECK_EQ(batch.offsets.front(), std::size_t(0));
+    CHECK_EQ(batch.offsets.back(), batch.positions.size());
+    for (std::size_t i = 0; i < texts.size(); ++i) {
+        const std::vector<std::size_t> got(batch.positions.begin() + batch.offsets[i],
+                                           batch.positions.begin() + batch.offsets[i + 1]);
+        CHECK_EQ(got, reference::find_all(texts[i], "aba"));
+    }
+}
+
+PYSTRINGPP_TEST(streaming_matcher_any_split_matches_whole_text) {
+    for (int iteration = 0; iteration < 1000; ++iteration) {
+        const std::string needle = random_needle(uniform(0, 10), 2);
+        const std::string text = random_haystack(uniform(0, 400), needle, 2);
+        StreamingMatcher matcher(needle);
+        std::vector<std::size_t> positions;
+        std::size_t offset = 0;
+        while (offset < text.size()) {
+            const std::size_t length = uniform(0, 2) ? uniform(0, 4) : uniform(0, 64);
+            const std::string_view chunk = std::string_view(text).substr(offset, length);
+            matcher.feed(chunk, positions);
+            offset += chunk.size();
+        }
+        CHECK_EQ(positions, reference::find_all(text, needle));
+        CHECK_EQ(matcher.consumed(), text.size());
+
+        matcher.reset();
+        CHECK_EQ(matcher.consumed(), std::size_t(0));
+        CHECK_EQ(matcher.feed(text), reference::find_all(text, needle));
+    }
+}
+
+PYSTRINGPP_TEST(aho_corasick_classic_example) {
+    using Match = AhoCorasick::Match;
+    for (AhoCorasick::Mode mode : {AhoCorasick::Mode::Dense, AhoCorasick::Mode::Compact}) {
+        const AhoCorasick automaton({"he", "she", "hers"}, mode);
+        CHECK(automaton.mode() == mode);
+        CHECK_EQ(automaton.find_all("ushers"), (std::vector<Match>{{1, 1}, {0, 2}, {2, 2}}));
+        CHECK_EQ(automaton.count("ushers"), std::size_t(3));
+        CHECK(automaton.contains("ushers"));
+        CHECK(!automaton.contains("xyz"));
+    }
+}
+
+PYSTRINGPP_TEST(aho_corasick_random_against_reference) {
+    for (int iteration = 0; iteration < 400; ++iteration) {
+        const std::size_t alphabet = uniform(1, 4);
+        std::vector<std::string> patterns(uniform(0, 12));
+        for (std::string& pattern : patterns) {
+            pattern = uniform(0, 9) == 0 ? std::string() : random_needle(uniform(1, 6), alphabet);
+        }
+        const std::string text = random_string(uniform(0, 500), std::string("abcd").substr(0, alphabet));
+        const auto expected = naive_multi(text, patterns);
+        for (AhoCorasick::Mode mode : {AhoCorasick::Mode::Auto, AhoCorasick::Mode::Dense, AhoCorasick::Mode::Compact}) {
+            const AhoCorasick automaton(patterns, mode);
+            CHECK_EQ(automaton.pattern_count(), patterns.size());
+            CHECK_EQ(automaton.find_all(text), expected);
+            CHECK_EQ(automaton.count(text), expected.size());
+            CHECK_EQ(automaton.contains(text), !expected.empty());
+        }
+    }
+}
+
+PYSTRINGPP_TEST(suffix_index_known_examples) {
+    const SuffixIndex index("abracadabra");
+    CHECK_EQ(index.suffix_array(), (std::vector<std::uint32_t>{10, 7, 0, 3, 5, 8, 1, 4, 6, 9, 2}));
+    CHECK_EQ(index.lcp(), (std::vector<std::uint32_t>{0, 1, 4, 1, 1, 0, 3, 0, 0, 0, 2}));
+    CHECK_EQ(index.locate("abra"), (std::vector<std::size_t>{0, 7}));
+    CHECK_EQ(index.count("a"), std::size_t(5));
+    CHECK(index.contains("cad"));
+    CHECK(!index.contains("abracx"));
+    // Empty or longer-than-text patterns never match, like find_pattern()
+    CHECK(index.locate("").empty());
+    CHECK_EQ(index.count("abracadabraa"), std::size_t(0));
+
+    const SuffixIndex empty("");
+    CHECK_EQ(empty.size(), std::size_t(0));
+    CHECK(empty.locate("a").empty());
+}
+
+PYSTRINGPP_TEST(suffix_index_random_against_reference) {
+    for (int iteration = 0; iteration < 300; ++iteration) {
+        // Small alphabets give deep LMS recursion; random bytes cover the
+        // unsigned ordering of bytes >= 0x80
+        const std::size_t alphabet = uniform(1, 4);
+        const std::string text = uniform(0, 4) == 0 ? random_bytes(uniform(0, 300))
+                                                    : random_haystack(uniform(0, 600), random_needle(uniform(1, 8), alphabet), alphabet);
+        const SuffixIndex index(text, uniform(0, 4));
+        const auto expected_sa = reference::suffix_array(text);
+        CHECK_EQ(index.suffix_array(), expected_sa);
+        CHECK_EQ(index.lcp(), reference::lcp(text, expected_sa));
+        for (int query = 0; query < 10; ++query) {
+            const std::string needle = uniform(0, 1) == 0 && !text.empty()
+                ? text.substr(uniform(0, text.size() - 1), uniform(1, 10))
+                : random_needle(uniform(1, 6), alphabet);
+            CHECK_EQ(index.locate(needle), reference::find_all(text, needle));
+            CHECK_EQ(index.count(needle), reference::find_all(text, needle).size());
+        }
+    }
+}
+
+PYSTRINGPP_TEST(suffix_index_parallel_lcp_matches_sequential) {
+    // Long enough for several LCP blocks, with long repeats crossing them
+    const std::string unit = random_string(5000, "ACGT");
+    std::string text;
+    while (text.size() < 400000) {
+        text += uniform(0, 1) == 0 ? unit : random_string(uniform(1, 3000), "ACGT");
+    }
+    const SuffixIndex sequential(text, 1);
+    const SuffixIndex parallel(text, 4);
+    CHECK(parallel.suffix_array() == sequential.suffix_array());
+    CHECK(parallel.lcp() == sequential.lcp());
+    CHECK_EQ(parallel.locate("ACGTACGT"), reference::find_all(text, "ACGTACGT"));
+    CHECK_EQ(parallel.locate(unit), find_pattern(text, unit));
+}
+
+PYSTRINGPP_TEST(suffix_index_save_load_round_trip) {
+    const std::string text = random_bytes(5000);
+    const SuffixIndex index(text);
+    const auto path = std::filesystem::temp_directory_path() /
+                      ("pystringpp_test_" + std::to_string(engine()()) + ".sfx");
+    index.save(path.string());
+    const SuffixIndex loaded = SuffixIndex::load(path.string());
+    CHECK(loaded.text() == text);
+    CHECK(loaded.suffix_array() == index.suffix_array());
+    CHECK(loaded.lcp() == index.lcp());
+    CHECK_EQ(loaded.locate(text.substr(100, 3)), reference::find_all(text, text.substr(100, 3)));
+
+    // A suffix array that is not a permutation is rejected
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(20 + 5000 + 4);
+        const std::uint32_t duplicate = index.suffix_array()[0];
+        file.write(reinterpret_cast<const char*>(&duplicate), sizeof(duplicate));
+    }
+    CHECK_THROWS(SuffixIndex::load(path.string()), std::runtime_error);
+
+    // Truncated files, headers claiming more data than the file holds and
+    // files of another kind are rejected
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    CHECK_THROWS(SuffixIndex::load(path.string()), std::runtime_error);
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(12);
+        const std::uint64_t huge = 0xFFFFFFF0;
+        file.write(reinterpret_cast<const char*>(&huge), sizeof(huge));
+    }
+    CHECK_THROWS(SuffixIndex::load(path.string()), std::runtime_error);
+    std::filesystem::resize_file(path, 20);
+    CHECK_THROWS(SuffixIndex::load(path.string()), std::runtime_error);
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << ">read1\nACGT\n";
+    }
+    CHECK_THROWS(SuffixIndex::load(path.string()), std::runtime_error);
+    std::filesystem::remove(path);
+    CHECK_THROWS(SuffixIndex::load(path.string()), std::runtime_error);
+}
@@ -0,0 +1,386 @@
+#include "test_harness.h"
+#include "reference.h"
+#include "pystringpp.h"
+#include "simd.h"
+#include <algorithm>
+#include <array>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace pystringpp;
+using namespace pystringpp_test;
+
+PYSTRINGPP_TEST(reverse_string_known_examples) {
+    CHECK_EQ(reverse_string("hello"), std::string("olleh"));
+    CHECK_EQ(reverse_string(""), std::string());
+    CHECK_EQ(reverse_string("a"), std::string("a"));
+    CHECK_EQ(reverse_string(std::string("a\0b", 3)), std::string("b\0a", 3));
+}
+
+PYSTRINGPP_TEST(reverse_string_random_against_reference) {
+    for (int iteration = 0; iteration < 500; ++iteration) {
+        const std::string s = random_bytes(uniform(0, 300));
+        CHECK_EQ(reverse_string(s), std::string(s.rbegin(), s.rend()));
+        CHECK_EQ(reverse_string(reverse_string(s)), s);
+    }
+}
+
+PYSTRINGPP_TEST(reverse_kernels_against_scalar) {
+    // Both ends meet at every offset within the 16/32-byte blocks
+    const detail::Kernels& kernels = detail::kernels();
+    for (int iteration = 0; iteration < 2000; ++iteration) {
+        const std::string s = random_bytes(iteration < 1000 ? uniform(0, 300) : uniform(0, 5000));
+        const std::string expected(s.rbegin(), s.rend());
+        std::string copied(s.size(), '\0');
+        kernels.reverse_copy(s.data(), s.size(), copied.data());
+        CHECK_EQ(copied, expected);
+        detail::reverse_copy_scalar(s.data(), s.size(), copied.data());
+        CHECK_EQ(copied, expected);
+        std::string inplace = s;
+        kernels.reverse_inplace(inplace.data(), inplace.size());
+        CHECK_EQ(inplace, expected);
+        inplace = s;
+        detail::reverse_inplace_scalar(inplace.data(), inplace.size());
+        CHECK_EQ(inplace, expected);
+    }
+}
+
+PYSTRINGPP_TEST(reverse_inplace_overloads) {
+    std::string text = "hello";
+    reverse_inplace(text);
+    CHECK_EQ(text, std::string("olleh"));
+    text.clear();
+    reverse_inplace(text);
+    CHECK_EQ(text, std::string());
+    // A sub-range leaves its surroundings untouched
+    std::string framed = "[abcdefghijklmnopqrstuvwxyz0123456789]";
+    reverse_inplace(framed.data() + 1, framed.size() - 2);
+    CHECK_EQ(framed, std::string("[9876543210zyxwvutsrqponmlkjihgfedcba]"));
+}
+
+PYSTRINGPP_TEST(ascii_prefix_kernel_against_scalar) {
+    const detail::Kernels& kernels = detail::kernels();
+    for (int iteration = 0; iteration < 2000; ++iteration) {
+        std::string s = random_string(uniform(0, 300), "abc");
+        if (!s.empty() && iteration % 4 != 0) {
+            s[uniform(0, s.size() - 1)] = static_cast<char>(uniform(0x80, 0xff));
+        }
+        CHECK_EQ(kernels.ascii_prefix(s.data(), s.size()), detail::ascii_prefix_scalar(s.data(), s.size()));
+        CHECK_EQ(detail::ascii_prefix_scalar(s.data(), s.size()),
+                 std::min(s.size(), static_cast<std::size_t>(std::find_if(s.begin(), s.end(), [](char c) {
+                     return static_cast<unsigned char>(c) >= 0x80;
+                 }) - s.begin())));
+    }
+}
+
+PYSTRINGPP_TEST(reverse_utf8_known_examples) {
+    CHECK_EQ(reverse_utf8(""), std::string());
+    CHECK_EQ(reverse_utf8("hello"), std::string("olleh"));
+    CHECK_EQ(reverse_utf8("a\xc3\xb1" "b"), std::string("b\xc3\xb1" "a"));
+    CHECK_EQ(reverse_utf8("\xf0\x9f\x8e\xaf\xf0\x9f\x9a\x80"), std::string("\xf0\x9f\x9a\x80\xf0\x9f\x8e\xaf"));
+    // Code point order splits a base from its combining mark; clusters do not
+    CHECK_EQ(reverse_utf8("e\xcc\x81" "a"), std::string("a\xcc\x81" "e"));
+    CHECK_EQ(reverse_graphemes("e\xcc\x81" "a"), std::string("ae\xcc\x81"));
+}
+
+PYSTRINGPP_TEST(reverse_utf8_random_against_reference) {
+    // Long ASCII runs between characters of every encoded length
+    const std::vector<std::string> characters = {"a", "bcdefghijklmnopqrstuvwxyz0123456789", "\xc3\xa9",
+                                                 "\xe6\x97\xa5", "\xf0\x9f\x8e\xaf", "\xcc\x81"};
+    for (int iteration = 0; iteration < 1000; ++iteration) {
+        std::string text;
+        for (std::size_t i = uniform(0, 80); i > 0; --i) {
+            text += characters[uniform(0, characters.size() - 1)];
+        }
+        const std::string reversed = reverse_utf8(text);
+        CHECK_EQ(reversed, reference::reverse_utf8(text));
+        CHECK_EQ(reverse_utf8(reversed), text);
+    }
+}
+
+PYSTRINGPP_TEST(reverse_graphemes_known_clusters) {
+    const std::string flag_fr = "\xf0\x9f\x87\xab\xf0\x9f\x87\xb7";
+    const std::string flag_de = "\xf0\x9f\x87\xa9\xf0\x9f\x87\xaa";
+    CHECK_EQ(reverse_graphemes(flag_fr + flag_de), flag_de + flag_fr);
+    // An unpaired third regional indicator is a cluster of its own
+    CHECK_EQ(reverse_graphemes(flag_fr + "\xf0\x9f\x87\xa9"), "\xf0\x9f\x87\xa9" + flag_fr);
+    CHECK_EQ(reverse_graphemes("a\r\nb\n\r"), std::string("\r\nb\r\na"));
+    // ZWJ only joins pictographs; after a letter it is a plain extender
+    const std::string family = "\xf0\x9f\x91\xa8\xe2\x80\x8d\xf0\x9f\x91\xa9\xe2\x80\x8d\xf0\x9f\x91\xa7";
+    CHECK_EQ(reverse_graphemes("x" + family + "y"), "y" + family + "x");
+    CHECK_EQ(reverse_graphemes("a\xe2\x80\x8d\xf0\x9f\x91\xa8"), "\xf0\x9f\x91\xa8" "a\xe2\x80\x8d");
+    // Conjoining jamo L V T form one syllable; two LVT syllables do not join
+    CHECK_EQ(reverse_graphemes("\xe1\x84\x80\xe1\x85\xa1\xe1\x86\xa8" "z"), "z\xe1\x84\x80\xe1\x85\xa1\xe1\x86\xa8");
+    CHECK_EQ(reverse_graphemes("\xed\x95\x9c\xea\xb8\x80"), std::string("\xea\xb8\x80\xed\x95\x9c"));
+    // Indic vowel signs and viramas (Extend and SpacingMark) stay on their consonant
+    // Tamil: "த" "மீ" "ழ்"
+    CHECK_EQ(reverse_graphemes("\xe0\xae\xa4\xe0\xae\xae\xe0\xaf\x80\xe0\xae\xb4\xe0\xaf\x8d"),
+             std::string("\xe0\xae\xb4\xe0\xaf\x8d\xe0\xae\xae\xe0\xaf\x80\xe0\xae\xa4"));
+    // Bengali: "কি" "তা"
+    CHECK_EQ(reverse_graphemes("\xe0\xa6\x95\xe0\xa6\xbf\xe0\xa6\xa4\xe0\xa6\xbe"),
+             std::string("\xe0\xa6\xa4\xe0\xa6\xbe\xe0\xa6\x95\xe0\xa6\xbf"));
+    // Devanagari: "हिं" "दी"
+    CHECK_EQ(reverse_graphemes("\xe0\xa4\xb9\xe0\xa4\xbf\xe0\xa4\x82\xe0\xa4\xa6\xe0\xa5\x80"),
+             std::string("\xe0\xa4\xa6\xe0\xa5\x80\xe0\xa4\xb9\xe0\xa4\xbf\xe0\xa4\x82"));
+}
+
+PYSTRINGPP_TEST(reverse_graphemes_random_against_reference) {
+    // Units are whole clusters that never merge with their neighbours, so the
+    // expected result is the unit sequence reversed
+    const std::vector<std::string> clusters = {
+        "a",
+        "racecar",                                                               // ASCII run, reads the same reversed
+        "\r\n",
+        "\n",
+        "e\xcc\x81",                                                             // e + combining acute
+        "\xe6\x97\xa5",                                                          // CJK
+        "\xf0\x9f\x91\x8d\xf0\x9f\x8f\xbd",                                      // thumbs up + skin tone
+        "\xf0\x9f\x91\xa8\xe2\x80\x8d\xf0\x9f\x91\xa9\xe2\x80\x8d\xf0\x9f\x91\xa7", // ZWJ family
+        "\xf0\x9f\x87\xab\xf0\x9f\x87\xb7",                                      // flag pair
+        "\xe2\x9d\xa4\xef\xb8\x8f",                                              // heart + VS16
+        "\xed\x95\x9c",                                                          // Hangul LVT syllable
+        "\xe1\x84\x80\xe1\x85\xa1\xe1\x86\xa8",                                  // jamo L V T
+        "\xe0\xae\xa4\xe0\xaf\x8a",                                              // Tamil consonant + vowel sign
+        "\xe0\xa6\x95\xe0\xa6\xbf",                                              // Bengali consonant + vowel sign
+    };
+    for (int iteration = 0; iteration < 1000; ++iteration) {
+        std::vector<std::size_t> units;
+        std::string text;
+        for (std::size_t i = uniform(0, 60); i > 0; --i) {
+            units.push_back(uniform(0, clusters.size() - 1));
+            text += clusters[units.back()];
+        }
+        std::string expected;
+        for (auto it = units.rbegin(); it != units.rend(); ++it) {
+            expected += clusters[*it];
+        }
+        CHECK_EQ(reverse_graphemes(text), expected);
+    }
+}
+
+PYSTRINGPP_TEST(reverse_utf8_rejects_malformed_input) {
+    for (const char* bad : {"\x80", "a\xc3", "\xe6\x97", "\xc0\x80", "\xed\xa0\x80", "\xf4\x90\x80\x80", "\xff"}) {
+        CHECK_THROWS(reverse_utf8(bad), std::invalid_argument);
+        CHECK_THROWS(reverse_graphemes(bad), std::invalid_argument);
+    }
+    // The message names the offset of the bad sequence, also mid-cluster
+    for (auto* reverse : {&reverse_utf8, &reverse_graphemes}) {
+        std::string message;
+        try {
+            reverse("abc\xcc\x81\xff");
+        } catch (const std::invalid_argument& error) {
+            message = error.what();
+        }
+        CHECK(message.find("offset 5") != std::string::npos);
+    }
+}
+
+PYSTRINGPP_TEST(count_char_known_examples) {
+    CHECK_EQ(count_char("hello world", 'l'), std::size_t(3));
+    CHECK_EQ(count_char("", 'a'), std::size_t(0));
+    CHECK_EQ(count_char("Hello", 'h'), std::size_t(0));
+    CHECK_EQ(count_char(std::string("\0a\0", 3), '\0'), std::size_t(2));
+}
+
+PYSTRINGPP_TEST(count_char_random_against_reference) {
+    // Lengths straddle every vector width and unroll factor
+    for (int iteration = 0; iteration < 2000; ++iteration) {
+        const std::string s = iteration % 2 ? random_bytes(uniform(0, 600)) : random_string(uniform(0, 600), "ab");
+        const char c = iteration % 2 ? static_cast<char>(uniform(0, 255)) : 'a';
+        CHECK_EQ(count_char(s, c), reference::count_char(s, c));
+        CHECK_EQ(detail::count_byte_scalar(s.data(), s.size(), c), reference::count_char(s, c));
+    }
+}
+
+PYSTRINGPP_TEST(count_char_long_runs_flush_counters) {
+    // Long runs of one byte overflow any 8-bit lane accumulator that is not
+    // flushed in time
+    for (std::size_t size : {255u, 256u, 4095u, 65536u, 300001u}) {
+        const std::string s(size, '\xff');
+        CHECK_EQ(count_char(s, '\xff'), size);
+        CHECK_EQ(count_char(s.substr(1), '\xff'), size - 1);
+    }
+}
+
+PYSTRINGPP_TEST(count_char_batch_matches_single_calls) {
+    std::vector<std::string> storage;
+    for (int i = 0; i < 50; ++i) {
+        storage.push_back(random_string(uniform(0, 100), "xyz"));
+    }
+    const std::vector<std::string_view> inputs(storage.begin(), storage.end());
+    const std::vector<std::size_t> counts = count_char_batch(inputs, 'x');
+    CHECK_EQ(counts.size(), inputs.size());
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        CHECK_EQ(counts[i], reference::count_char(inputs[i], 'x'));
+    }
+    CHECK(count_char_batch({}, 'x').empty());
+}
+
+PYSTRINGPP_TEST(byte_histogram_random_against_reference) {
+    // Lengths on both sides of the table threshold, and low-entropy inputs
+    for (int iteration = 0; iteration < 500; ++iteration) {
+        const std::size_t length = iteration % 2 ? uniform(0, 300) : uniform(0, 20000);
+        const std::string s = iteration % 3 ? random_bytes(length) : random_string(length, "ACGT");
+        const std::array<std::uint64_t, 256> histogram = byte_histogram(s);
+        std::array<std::uint64_t, 256> expected{};
+        for (char c : s) {
+            ++expected[static_cast<unsigned char>(c)];
+        }
+        CHECK_EQ(histogram, expected);
+    }
+    CHECK_EQ(byte_histogram(std::string(100000, '\xff'))[255], std::uint64_t(100000));
+}
+
+PYSTRINGPP_TEST(count_chars_random_against_reference) {
+    CHECK(count_chars("").empty());
+    for (int iteration = 0; iteration < 300; ++iteration) {
+        const std::string s = iteration % 2 ? random_bytes(uniform(0, 500)) : random_string(uniform(0, 500), "abc");
+        const auto counts = count_chars(s);
+        const std::map<char, int> ordered(counts.begin(), counts.end());
+        CHECK_EQ(ordered, reference::count_chars(s));
+    }
+}
+
+PYSTRINGPP_TEST(remove_duplicates_random_against_reference) {
+    CHECK_EQ(remove_duplicates("programming"), std::string("progamin"));
+    CHECK_EQ(remove_duplicates(""), std::string());
+    for (int iteration = 0; iteration < 300; ++iteration) {
+        const std::string s = iteration % 2 ? random_bytes(uniform(0, 700)) : random_string(uniform(0, 50), "abcdef");
+        CHECK_EQ(remove_duplicates(s), reference::remove_duplicates(s));
+    }
+}
+
+PYSTRINGPP_TEST(remove_duplicates_all_byte_values) {
+    std::string all;
+    for (int b = 255; b >= 0; --b) {
+        all += static_cast<char>(b);
+    }
+    CHECK_EQ(remove_duplicates(all + all + "tail"), all);
+}
+
+PYSTRINGPP_TEST(remove_duplicates_utf8_random_against_reference) {
+    CHECK_EQ(remove_duplicates_utf8("\xce\xb1\xce\xb2\xce\xb1"), std::string("\xce\xb1\xce\xb2"));
+    // Characters of every encoded length, deduplicated as whole units
+    const std::vector<std::string> characters = {"a", "b", "\xc3\xa9", "\xc3\xa8", "\xe6\x97\xa5",
+                                                 "\xe6\x97\xa6", "\xf0\x9f\x8e\xaf", "\xf0\x9f\x9a\x80"};
+    for (int iteration = 0; iteration < 500; ++iteration) {
+        std::string text;
+        std::vector<std::string> distinct;
+        for (std::size_t i = uniform(0, 60); i > 0; --i) {
+            const std::string& c = characters[uniform(0, characters.size() - 1)];
+            text += c;
+            if (std::find(distinct.begin(), distinct.end(), c) == distinct.end()) {
+                distinct.push_back(c);
+            }
+        }
+        std::string expected;
+        for (const std::string& c : distinct) {
+            expected += c;
+        }
+        CHECK_EQ(remove_duplicates_utf8(text), expected);
+    }
+}
+
+PYSTRINGPP_TEST(remove_duplicates_utf8_rejects_malformed_input) {
+    // Stray continuation, truncated, overlong, surrogate, above U+10FFFF
+    for (const char* bad : {"\x80", "a\xc3", "\xe6\x97", "\xc0\x80", "\xed\xa0\x80", "\xf4\x90\x80\x80", "\xff"}) {
+        CHECK_THROWS(remove_duplicates_utf8(bad), std::invalid_argument);
+    }
+}
+
+PYSTRINGPP_TEST(is_palindrome_known_examples) {
+    CHECK(is_palindrome("A man, a plan, a canal: Panama"));
+    CHECK(is_palindrome("racecar"));
+    CHECK(is_palindrome(""));
+    CHECK(is_palindrome(".,!"));
+    CHECK(!is_palindrome("hello"));
+    CHECK(!is_palindrome("ab"));
+}
+
+PYSTRINGPP_TEST(is_palindrome_utf8_known_examples) {
+    // "А роза упала на лапу Азора"
+    CHECK(is_palindrome_utf8("\xd0\x90 \xd1\x80\xd0\xbe\xd0\xb7\xd0\xb0 \xd1\x83\xd0\xbf\xd0\xb0\xd0\xbb\xd0\xb0 "
+                             "\xd0\xbd\xd0\xb0 \xd0\xbb\xd0\xb0\xd0\xbf\xd1\x83 \xd0\x90\xd0\xb7\xd0\xbe\xd1\x80\xd0\xb0"));
+    CHECK(is_palindrome_utf8(""));
+    CHECK(is_palindrome_utf8("A man, a plan, a canal: Panama"));
+    // Combining acute accent stays with its base letter
+    CHECK(is_palindrome_utf8("e\xcc\x81xe\xcc\x81"));
+    CHECK(!is_palindrome_utf8("e\xcc\x81xe"));
+    // Emoji and punctuation are skipped; Greek folds case
+    CHECK(is_palindrome_utf8("\xf0\x9f\x8e\xaf a\xce\x91\xce\xb1" "A!"));
+    // Case pairs outside Latin-1: "Ơxơ" and "Ἀβἀ"
+    CHECK(is_palindrome_utf8("\xc6\xa0x\xc6\xa1"));
+    CHECK(is_palindrome_utf8("\xe1\xbc\x88\xce\xb2\xe1\xbc\x80"));
+    CHECK(!is_palindrome_utf8("\xc6\xa0xo"));
+    // Bengali vowel sign stays on its consonant: "কি ত কি", not "কি ত ক"
+    CHECK(is_palindrome_utf8("\xe0\xa6\x95\xe0\xa6\xbf \xe0\xa6\xa4 \xe0\xa6\x95\xe0\xa6\xbf"));
+    CHECK(!is_palindrome_utf8("\xe0\xa6\x95\xe0\xa6\xbf \xe0\xa6\xa4 \xe0\xa6\x95"));
+    CHECK_THROWS(is_palindrome_utf8("a\xff"), std::invalid_argument);
+}
+
+PYSTRINGPP_TEST(is_palindrome_utf8_random_against_reference) {
+    // (encoding, folded identity) per character; empty identity means skipped
+    const std::vector<std::pair<std::string, std::string>> characters = {
+        {"a", "a"}, {"A", "a"}, {"\xce\x91", "alpha"}, {"\xce\xb1", "alpha"}, {"e\xcc\x81", "e+acute"},
+        {"\xc3\xa9", "e-acute"}, {"\xc3\x89", "e-acute"}, {"\xe6\x97\xa5", "sun"}, {" ", ""}, {"!", ""},
+        {"\xf0\x9f\x8e\xaf", ""}, {"\xe2\x80\x94", ""}};
+    for (int iteration = 0; iteration < 2000; ++iteration) {
+        std::vector<std::size_t> picks(uniform(0, 16));
+        for (std::size_t& pick : picks) {
+            pick = uniform(0, characters.size() - 1);
+        }
+        if (iteration % 2) {
+            std::copy(picks.begin(), picks.begin() + picks.size() / 2, picks.rbegin());
+        }
+        std::string text;
+        std::vector<std::string> identities;
+        for (std::size_t pick : picks) {
+            text += characters[pick].first;
+            if (!characters[pick].second.empty()) {
+                identities.push_back(characters[pick].second);
+            }
+        }
+        const bool expected = std::equal(identities.begin(), identities.end(), identities.rbegin());
+        CHECK_EQ(is_palindrome_utf8(text), expected);
+    }
+}
+
+PYSTRINGPP_TEST(is_palindrome_utf8_matches_ascii_version) {
+    for (int iteration = 0; iteration < 1000; ++iteration) {
+        std::string s = random_string(uniform(0, 40), "aAbB ,.1");
+        if (iteration % 2) {
+            std::copy(s.begin(), s.begin() + s.size() / 2, s.rbegin());
+        }
+        CHECK_EQ(is_palindrome_utf8(s), is_palindrome(s));
+    }
+}
+
+PYSTRINGPP_TEST(is_palindrome_batch_matches_single_calls) {
+    std::vector<std::string> storage;
+    for (int i = 0; i < 100; ++i) {
+        std::string s = random_string(uniform(0, 12), "ab ");
+        if (i % 2) {
+            std::copy(s.begin(), s.begin() + s.size() / 2, s.rbegin());
+        }
+        storage.push_back(s);
+    }
+    const std::vector<std::string_view> inputs(storage.begin(), storage.end());
+    const std::vector<std::uint8_t> results = is_palindrome_batch(inputs);
+    CHECK_EQ(results.size(), inputs.size());
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        CHECK_EQ(results[i] != 0, is_palindrome(inputs[i]));
+    }
+}
+
+PYSTRINGPP_TEST(is_palindrome_random_against_reference) {
+    for (int iteration = 0; iteration < 1000; ++iteration) {
+        std::string s = random_string(uniform(0, 40), "aAbB ,.1\x80");
+        if (iteration % 2) {
+            // Mirror the first half so a good share of inputs are palindromes
+            std::copy(s.begin(), s.begin() + s.size() / 2, s.rbegin());
+        }
+        CHECK_EQ(is_palindrome(s), reference::is_palindrome(s));
+    }
+}
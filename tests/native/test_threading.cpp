@@ -0,0 +1,75 @@
+#include "test_harness.h"
+#include "reference.h"
+#include "pystringpp.h"
+#include "thread_pool.h"
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace pystringpp;
+using namespace pystringpp_test;
+
+// These are mainly for the ThreadSanitizer build (PYSTRINGPP_SANITIZE=thread)
+
+PYSTRINGPP_TEST(thread_pool_runs_every_task_once) {
+    detail::ThreadPool pool(3);
+    for (std::size_t tasks : {0u, 1u, 7u, 100u}) {
+        std::vector<std::atomic<int>> runs(tasks);
+        pool.parallel_for(tasks, 4, [&](std::size_t i) { runs[i].fetch_add(1); });
+        for (std::size_t i = 0; i < tasks; ++i) {
+            CHECK_EQ(runs[i].load(), 1);
+        }
+    }
+}
+
+PYSTRINGPP_TEST(thread_pool_rethrows_task_exceptions) {
+    detail::ThreadPool pool(2);
+    std::atomic<int> completed{0};
+    CHECK_THROWS(pool.parallel_for(16, 3,
+                                   [&](std::size_t i) {
+                                       if (i == 5) {
+                                           throw std::runtime_error("task failed");
+                                       }
+                                       completed.fetch_add(1);
+                                   }),
+                 std::runtime_error);
+    CHECK_EQ(completed.load(), 15);
+}
+
+PYSTRINGPP_TEST(thread_pool_nested_calls_do_not_deadlock) {
+    detail::ThreadPool pool(2);
+    std::atomic<int> inner{0};
+    pool.parallel_for(4, 3, [&](std::size_t) {
+        pool.parallel_for(4, 3, [&](std::size_t) { inner.fetch_add(1); });
+    });
+    CHECK_EQ(inner.load(), 16);
+}
+
+PYSTRINGPP_TEST(concurrent_callers_share_pool_and_kernels) {
+    // Several threads hit the shared pool, the lazily resolved SIMD table and
+    // a shared compiled Pattern at the same time
+    const std::string text = random_string(1 << 18, "ab");
+    const Pattern pattern("abba");
+    const std::vector<std::size_t> expected = reference::find_all(text, "abba");
+    const std::size_t expected_a = reference::count_char(text, 'a');
+
+    std::vector<std::thread> threads;
+    std::vector<int> ok(6, 0);
+    for (std::size_t t = 0; t < ok.size(); ++t) {
+        threads.emplace_back([&, t] {
+            bool good = true;
+            for (int round = 0; round < 3; ++round) {
+                good = good && find_pattern_parallel(text, "abba", 4, 1 << 12) == expected;
+                good = good && pattern.find_all(text) == expected;
+                good = good && count_char(text, 'a') == expected_a;
+            }
+            ok[t] = good ? 1 : 0;
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    CHECK_EQ(ok, std::vector<int>(ok.size(), 1));
+}
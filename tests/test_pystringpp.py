@@ -273,6 +273,242 @@ class TestCountChar:
     def test_parameterized_counting(self, text, char, expected):
         """Parameterized tests for character counting."""
         assert su.count_char(text, char) == expected
+        
+    def test_vector_block_boundaries(self):
+        """Test lengths around the 16/32/64-byte SIMD block sizes and tails."""
+        for length in list(range(0, 200)) + [255 * 16, 255 * 32 + 1, 255 * 64 + 63]:
+            text = ('ab' * length)[:length]
+            assert su.count_char(text, 'a') == text.count('a'), f"Mismatch at length {length}"
+            assert su.count_char(text, 'b') == text.count('b'), f"Mismatch at length {length}"
+            
+    def test_null_character_counting(self):
+        """Test counting NUL bytes, which match zero-filled SIMD lanes."""
+        assert su.count_char('a\0b\0' * 100, '\0') == 200
+        assert su.count_char('x' * 1000, '\0') == 0
+
+
+@pytest.mark.skipif(not HAS_CPP_EXTENSION, reason="C++ extension specific tests")
+class TestRemoveDuplicates:
+    """Tests for remove_duplicates and remove_duplicates_utf8."""
+    
+    @staticmethod
+    def reference(items):
+        return list(dict.fromkeys(items))
+    
+    def test_bytes_in_first_occurrence_order(self):
+        """Test byte-level deduplication returns bytes."""
+        assert su_cpp.remove_duplicates('programming') == b'progamin'
+        assert su_cpp.remove_duplicates('') == b''
+        assert su_cpp.remove_duplicates(b'\xff\x00\xff\x00a') == b'\xff\x00a'
+        
+    def test_all_byte_values(self):
+        """Test inputs containing every byte value (the early exit)."""
+        data = bytes(range(255, -1, -1)) * 4 + b'tail'
+        assert su_cpp.remove_duplicates(data) == bytes(range(255, -1, -1))
+        
+    def test_random_bytes_against_reference(self):
+        """Test random inputs against dict.fromkeys."""
+        import random
+        rng = random.Random(19)
+        for _ in range(200):
+            data = bytes(rng.randrange(256) for _ in range(rng.randrange(600)))
+            assert su_cpp.remove_duplicates(data) == bytes(self.reference(data))
+            
+    def test_utf8_code_points(self):
+        """Test the UTF-8 variant keeps whole characters."""
+        assert su_cpp.remove_duplicates_utf8('αβγαβγ') == 'αβγ'
+        assert su_cpp.remove_duplicates_utf8('café cafe') == 'café'
+        assert su_cpp.remove_duplicates_utf8('🎯🚀🎯a') == '🎯🚀a'
+        text = 'naïve résumé 日本語日本 🎯🎯'
+        assert su_cpp.remove_duplicates_utf8(text) == ''.join(self.reference(text))
+        
+    def test_utf8_rejects_invalid_input(self):
+        """Test malformed UTF-8 raises ValueError."""
+        for bad in (b'\xff', b'a\xc3', b'\xc0\x80', b'\xed\xa0\x80'):
+            with pytest.raises(ValueError):
+                su_cpp.remove_duplicates_utf8(bad)
+
+
+@pytest.mark.skipif(not HAS_CPP_EXTENSION, reason="C++ extension specific tests")
+class TestIsPalindrome:
+    """Tests for is_palindrome, is_palindrome_utf8 and is_palindrome_batch."""
+    
+    @staticmethod
+    def reference(text):
+        cleaned = [c.lower() for c in text if c.isascii() and c.isalnum()]
+        return cleaned == cleaned[::-1]
+    
+    def test_known_examples(self):
+        """Test classic palindromes and non-palindromes."""
+        assert su_cpp.is_palindrome('A man, a plan, a canal: Panama')
+        assert su_cpp.is_palindrome('racecar')
+        assert su_cpp.is_palindrome('')
+        assert su_cpp.is_palindrome('.,!')
+        assert not su_cpp.is_palindrome('hello')
+        assert not su_cpp.is_palindrome('ab')
+        
+    def test_random_against_reference(self):
+        """Test random ASCII inputs against a Python reference."""
+        import random
+        rng = random.Random(20)
+        for _ in range(500):
+            half = ''.join(rng.choice('aAbB ,.1') for _ in range(rng.randrange(20)))
+            text = half + half[::-1] if rng.random() < 0.5 else half + 'x' + half
+            assert su_cpp.is_palindrome(text) == self.reference(text)
+            
+    def test_utf8_case_folding_and_marks(self):
+        """Test Unicode letters, case folding and combining marks."""
+        assert su_cpp.is_palindrome_utf8('А роза упала на лапу Азора')
+        # Accents are part of the character; they are not stripped
+        assert not su_cpp.is_palindrome_utf8('Νίψον ανομήματα μη μόναν όψιν')
+        assert su_cpp.is_palindrome_utf8('ΑβΒα')
+        assert su_cpp.is_palindrome_utf8('e\u0301xe\u0301')
+        assert not su_cpp.is_palindrome_utf8('e\u0301xe')
+        assert su_cpp.is_palindrome_utf8('🎯 a🚀A 🎯')
+        assert su_cpp.is_palindrome_utf8('日本日')
+        assert not su_cpp.is_palindrome_utf8('日本')
+        # Case pairs outside Latin-1, and an Indic vowel sign on its consonant
+        assert su_cpp.is_palindrome_utf8('Ơxơ')
+        assert su_cpp.is_palindrome_utf8('Ἀβἀ')
+        assert su_cpp.is_palindrome_utf8('\u0995\u09bf \u09a4 \u0995\u09bf')
+        assert not su_cpp.is_palindrome_utf8('\u0995\u09bf \u09a4 \u0995')
+        
+    def test_utf8_rejects_invalid_input(self):
+        """Test malformed UTF-8 raises ValueError."""
+        with pytest.raises(ValueError):
+            su_cpp.is_palindrome_utf8(b'a\xffa')
+            
+    def test_batch(self):
+        """Test the batch variant from a list and from (data, offsets)."""
+        import numpy as np
+        texts = ['racecar', 'hello', '', 'Abba!']
+        result = su_cpp.is_palindrome_batch(texts)
+        assert result.dtype == np.bool_
+        assert result.tolist() == [True, False, True, True]
+        data = ''.join(texts).encode()
+        offsets = np.cumsum([0] + [len(t) for t in texts])
+        assert su_cpp.is_palindrome_batch(data, offsets).tolist() == [True, False, True, True]
+
+
+@pytest.mark.skipif(not HAS_CPP_EXTENSION, reason="C++ extension specific tests")
+class TestReverseUtf8:
+    """Tests for reverse_utf8 and reverse_graphemes."""
+    
+    def test_code_points(self):
+        """Test code point reversal matches slicing a str."""
+        for text in ('', 'hello', 'añb', 'αβγδε', '🎯🚀💻', 'x' * 100 + '日本' + 'y' * 37):
+            assert su_cpp.reverse_utf8(text) == text[::-1]
+            
+    def test_bytes_input(self):
+        """Test reverse_utf8 decodes bytes, while reverse_string reverses them bytewise."""
+        assert su_cpp.reverse_utf8('añb'.encode()) == 'bña'
+        assert su_cpp.reverse_string(b'abc') == b'cba'
+        assert su_cpp.reverse_string('ñ'.encode()) == b'\xb1\xc3'
+        assert su_cpp.reverse_string(bytearray(b'\x00\xff\x80')) == b'\x80\xff\x00'
+        
+    def test_grapheme_clusters(self):
+        """Test combining marks, emoji sequences and flags stay whole."""
+        assert su_cpp.reverse_graphemes('e\u0301a') == 'ae\u0301'
+        assert su_cpp.reverse_graphemes('👍🏽x') == 'x👍🏽'
+        assert su_cpp.reverse_graphemes('a👨\u200d👩\u200d👧b') == 'b👨\u200d👩\u200d👧a'
+        assert su_cpp.reverse_graphemes('🇫🇷🇩🇪') == '🇩🇪🇫🇷'
+        assert su_cpp.reverse_graphemes('a\r\nb') == 'b\r\na'
+
+    def test_indic_vowel_sign_clusters(self):
+        """Test Indic vowel signs and viramas stay attached to their consonant."""
+        assert su_cpp.reverse_graphemes('\u0ba4\u0bae\u0bbf\u0bb4\u0bcd') == '\u0bb4\u0bcd\u0bae\u0bbf\u0ba4'
+        assert su_cpp.reverse_graphemes('\u0995\u09bf\u09a4\u09be') == '\u09a4\u09be\u0995\u09bf'
+        assert su_cpp.reverse_graphemes('\u0939\u093f\u0902\u0926\u0940') == '\u0926\u0940\u0939\u093f\u0902'
+        
+    def test_rejects_invalid_input(self):
+        """Test malformed UTF-8 raises ValueError."""
+        for bad in (b'\xff', b'a\xc3', b'\xc0\x80', b'\xed\xa0\x80'):
+            with pytest.raises(ValueError):
+                su_cpp.reverse_utf8(bad)
+            with pytest.raises(ValueError):
+                su_cpp.reverse_graphemes(bad)
+
+
+@pytest.mark.skipif(not HAS_CPP_EXTENSION, reason="C++ extension specific tests")
+class TestReverseInplace:
+    """Tests for reverse_inplace."""
+    
+    def test_bytearray(self):
+        """Test a bytearray is reversed in place and nothing is returned."""
+        data = bytearray(b'hello world')
+        assert su_cpp.reverse_inplace(data) is None
+        assert data == bytearray(b'dlrow olleh')
+        
+    def test_lengths_around_vector_widths(self):
+        """Test lengths where the two ends meet inside and between blocks."""
+        for length in list(range(0, 70)) + [127, 128, 129, 4096 + 7]:
+            original = bytes((i * 31) % 256 for i in range(length))
+            data = bytearray(original)
+            su_cpp.reverse_inplace(data)
+            assert bytes(data) == original[::-1]
+            
+    def test_memoryview_slice(self):
+        """Test a writable memoryview reverses only its own bytes."""
+        data = bytearray(b'[abcdef]')
+        su_cpp.reverse_inplace(memoryview(data)[1:-1])
+        assert data == bytearray(b'[fedcba]')
+        
+    def test_numpy_uint8(self):
+        """Test numpy byte arrays are accepted and wider dtypes rejected."""
+        np = pytest.importorskip('numpy')
+        array = np.arange(10, dtype=np.uint8)
+        su_cpp.reverse_inplace(array)
+        assert array.tolist() == list(range(9, -1, -1))
+        with pytest.raises(TypeError):
+            su_cpp.reverse_inplace(np.arange(10, dtype=np.int32))
+            
+    def test_immutable_inputs_rejected(self):
+        """Test str, bytes and read-only views are refused."""
+        with pytest.raises(TypeError):
+            su_cpp.reverse_inplace('hello')
+        with pytest.raises((TypeError, BufferError)):
+            su_cpp.reverse_inplace(b'hello')
+        with pytest.raises((TypeError, BufferError)):
+            su_cpp.reverse_inplace(memoryview(b'hello'))
+
+
+@pytest.mark.skipif(not HAS_CPP_EXTENSION, reason="C++ extension specific tests")
+class TestByteHistogram:
+    """Tests for byte_histogram."""
+    
+    def test_numpy_array(self):
+        """Test the default numpy result against collections.Counter."""
+        import collections
+        data = bytes(range(256)) * 3 + b'hello world' * 100
+        counts = su_cpp.byte_histogram(data)
+        assert counts.shape == (256,)
+        assert counts.dtype.name == 'uint64'
+        expected = collections.Counter(data)
+        assert all(int(counts[b]) == expected.get(b, 0) for b in range(256))
+        
+    def test_dict_result(self):
+        """Test as_dict returns only the non-zero byte counts."""
+        assert su_cpp.byte_histogram('hello', as_dict=True) == {
+            ord('h'): 1, ord('e'): 1, ord('l'): 2, ord('o'): 1}
+        assert su_cpp.byte_histogram('', as_dict=True) == {}
+        
+    def test_utf8_bytes(self):
+        """Test str input is counted as its UTF-8 bytes."""
+        assert su_cpp.byte_histogram('é', as_dict=True) == {0xc3: 1, 0xa9: 1}
+        
+    def test_lengths_around_table_threshold(self):
+        """Test short inputs and the 8-byte word loop tails."""
+        for length in list(range(0, 40)) + [255, 256, 257, 263, 4096 + 7]:
+            data = bytes((i * 7) % 256 for i in range(length))
+            counts = su_cpp.byte_histogram(data)
+            assert int(counts.sum()) == length
+            assert all(int(counts[b]) == data.count(bytes([b])) for b in set(data))
+    
+    def test_long_run_of_one_byte(self):
+        """Test a run of one byte value lands in a single bucket."""
+        counts = su_cpp.byte_histogram(b'A' * 1000003)
+        assert int(counts[ord('A')]) == 1000003
+        assert int(counts.sum()) == 1000003
 
 
 class TestFindPattern:
@@ -358,6 +594,607 @@ class TestFindPattern:
         assert su.find_pattern(text, pattern) == expected
 
 
+def python_levenshtein_distance(a, b):
+    """Two-row dynamic programming reference for edit distance."""
+    prev = list(range(len(b) + 1))
+    for i, ca in enumerate(a, 1):
+        curr = [i]
+        for j, cb in enumerate(b, 1):
+            curr.append(prev[j - 1] if ca == cb else 1 + min(prev[j], curr[j - 1], prev[j - 1]))
+        prev = curr
+    return prev[-1]
+
+
+@pytest.mark.skipif(not HAS_CPP_EXTENSION, reason="C++ extension specific tests")
+class TestFindPatternParallel:
+    """Tests for the chunked multi-threaded find_pattern_parallel."""
+    
+    def test_identical_to_sequential(self):
+        """Test output matches find_pattern, including matches across chunk seams."""
+        text = ('abcab' * 100000) + 'aaaa' * 50000
+        for pattern in ['ab', 'abcab', 'bca', 'aa', 'aaaa', 'cabcabcab']:
+            expected = su_cpp.find_pattern(text, pattern)
+            for threads in [2, 3, 8]:
+                result = su_cpp.find_pattern_parallel(text, pattern, threads=threads, min_parallel_size=0)
+                assert result == expected, f"Mismatch for {pattern!r} with {threads} threads"
+                
+    def test_edge_cases(self):
+        """Test the find_pattern edge cases carry over."""
+        assert su_cpp.find_pattern_parallel('', 'a', min_parallel_size=0) == []
+        assert su_cpp.find_pattern_parallel('abc', '', min_parallel_size=0) == []
+        assert su_cpp.find_pattern_parallel('ab', 'abc', min_parallel_size=0) == []
+        
+    def test_below_threshold_stays_sequential(self):
+        """Test small texts still give correct results on the sequential path."""
+        assert su_cpp.find_pattern_parallel('aaaa', 'aa') == [0, 1, 2]
+
+
+@pytest.mark.skipif(not HAS_CPP_EXTENSION, reason="C++ extension specific tests")
+class TestLevenshteinDistance:
+    """Tests for the bit-parallel levenshtein_distance."""
+    
+    @pytest.mark.parametrize("a,b,expected", [
+        ('', '', 0),
+        ('', 'abc', 3),
+        ('abc', '', 3),
+        ('kitten', 'sitting', 3),
+        ('flaw', 'lawn', 2),
+        ('same', 'same', 0),
+        ('abc', 'cba', 2),
+    ])
+    def test_known_distances(self, a, b, expected):
+        """Test textbook distances, which are symmetric."""
+        assert su_cpp.levenshtein_distance(a, b) == expected
+        assert su_cpp.levenshtein_distance(b, a) == expected
+        
+    def test_word_boundaries_against_reference(self):
+        """Test single-word and blocked paths around 64-byte pattern lengths."""
+        import random
+        rng = random.Random(42)
+        for length in [1, 2, 63, 64, 65, 127, 128, 129, 200]:
+            for _ in range(5):
+                a = ''.join(rng.choice('ACGT') for _ in range(length))
+                b = ''.join(rng.choice('ACGT') for _ in range(rng.randint(0, 2 * length)))
+                assert su_cpp.levenshtein_distance(a, b) == python_levenshtein_distance(a, b)
+                
+    def test_long_strings(self):
+        """Test long inputs that would need a huge matrix in the naive DP."""
+        a = 'ab' * 5000
+        b = 'ba' * 5000
+        assert su_cpp.levenshtein_distance(a, b) == 2
+        assert su_cpp.levenshtein_distance(a, a + 'x' * 10) == 10
+
+
+@pytest.mark.skipif(not HAS_CPP_EXTENSION, reason="C++ extension specific tests")
+class TestLevenshteinWithin:
+    """Tests for the thresholded levenshtein_within."""
+    
+    def test_threshold_edges(self):
+        """Test the result flips exactly at the true distance."""
+        assert su_cpp.levenshtein_within('kitten', 'sitting', 3)
+        assert not su_cpp.levenshtein_within('kitten', 'sitting', 2)
+        assert su_cpp.levenshtein_within('', '', 0)
+        assert su_cpp.levenshtein_within('abc', 'abc', 0)
+        
+    def test_length_prefilter(self):
+        """Test a length difference above k is rejected."""
+        assert not su_cpp.levenshtein_within('a', 'a' * 10, 8)
+        assert su_cpp.levenshtein_within('a', 'a' * 10, 9)
+        
+    def test_agrees_with_distance(self):
+        """Test against the full distance for random inputs and thresholds."""
+        import random
+        rng = random.Random(7)
+        for _ in range(300):
+            a = ''.join(rng.choice('ab') for _ in range(rng.randint(0, 150)))
+            b = ''.join(rng.choice('ab') for _ in range(rng.randint(0, 150)))
+            k = rng.randint(0, 40)
+            expected = su_cpp.levenshtein_distance(a, b) <= k
+            assert su_cpp.levenshtein_within(a, b, k) == expected
+
+
+def python_lcs_length(a, b):
+    """Two-row dynamic programming reference for LCS length."""
+    prev = [0] * (len(b) + 1)
+    for ca in a:
+        curr = [0]
+        for j, cb in enumerate(b, 1):
+            curr.append(prev[j - 1] + 1 if ca == cb else max(prev[j], curr[j - 1]))
+        prev = curr
+    return prev[-1]
+
+
+def is_subsequence(sub, text):
+    """True if sub can be obtained from text by deleting characters."""
+    it = iter(text)
+    return all(ch in it for ch in sub)
+
+
+@pytest.mark.skipif(not HAS_CPP_EXTENSION, reason="C++ extension specific tests")
+class TestLongestCommonSubsequence:
+    """Tests for Hirschberg LCS and the bit-parallel lcs_length."""
+    
+    def check(self, a, b):
+        expected = python_lcs_length(a, b)
+        lcs = su_cpp.longest_common_subsequence(a, b)
+        assert len(lcs) == expected
+        assert is_subsequence(lcs, a) and is_subsequence(lcs, b)
+        assert su_cpp.lcs_length(a, b) == expected
+        
+    def test_known_examples(self):
+        """Test classic examples and empty inputs."""
+        self.check('ABCBDAB', 'BDCABA')
+        self.check('AGGTAB', 'GXTXAYB')
+        self.check('', 'abc')
+        self.check('abc', '')
+        self.check('abc', 'abc')
+        self.check('abc', 'def')
+        
+    def test_random_against_reference(self):
+        """Test random inputs across the 64-bit word boundary."""
+        import random
+        rng = random.Random(3)
+        for length in [5, 63, 64, 65, 130]:
+            for _ in range(5):
+                a = ''.join(rng.choice('ACGT') for _ in range(length))
+                b = ''.join(rng.choice('ACGT') for _ in range(rng.randint(0, 2 * length)))
+                self.check(a, b)
+                
+    def test_long_similar_inputs(self):
+        """Test inputs whose full DP matrix would be very large."""
+        a = 'line\n' * 20000
+        b = a[:50000] + 'changed\n' + a[50000:]
+        assert su_cpp.longest_common_subsequence(a, b) == a
+        assert su_cpp.lcs_length(a, b) == len(a)
+
+
+@pytest.mark.skipif(not HAS_CPP_EXTENSION, reason="C++ extension specific tests")
+class TestBufferInputs:
+    """Tests for zero-copy text arguments (bytes and buffer-protocol objects)."""
+    
+    TEXT = 'abcabcabc\nabc'
+    
+    def inputs(self):
+        raw = self.TEXT.encode('utf-8')
+        return [self.TEXT, raw, bytearray(raw), memoryview(raw)]
+    
+    def test_count_char_accepts_buffers(self):
+        """Test count_char gives the same answer for every input type."""
+        for data in self.inputs():
+            assert su_cpp.count_char(data, 'a') == 4
+            assert su_cpp.count_char(data, '\n') == 1
+            
+    def test_find_pattern_accepts_buffers(self):
+        """Test find_pattern and Pattern accept buffers for text and pattern."""
+        for data in self.inputs():
+            assert su_cpp.find_pattern(data, 'abc') == [0, 3, 6, 10]
+            assert su_cpp.find_pattern(data, b'abc') == [0, 3, 6, 10]
+            assert su_cpp.Pattern(b'bc').count(data) == 4
+            
+    def test_mmap_input(self, tmp_path):
+        """Test a memory-mapped file is searched in place."""
+        import mmap
+        path = tmp_path / 'data.txt'
+        path.write_bytes(b'xyz' * 1000)
+        with open(path, 'rb') as handle:
+            mapped = mmap.mmap(handle.fileno(), 0, access=mmap.ACCESS_READ)
+            assert su_cpp.count_char(mapped, 'y') == 1000
+            assert su_cpp.find_pattern(mapped, 'zx')[:3] == [2, 5, 8]
+            mapped.close()
+            
+    def test_numpy_uint8_input(self):
+        """Test numpy byte arrays are accepted and wider dtypes rejected."""
+        np = pytest.importorskip('numpy')
+        data = np.frombuffer(b'hello world', dtype=np.uint8)
+        assert su_cpp.count_char(data, 'l') == 3
+        with pytest.raises(TypeError):
+            su_cpp.count_char(np.arange(4, dtype=np.int32), 'a')
+            
+    def test_non_contiguous_buffer_rejected(self):
+        """Test strided views are rejected rather than silently copied."""
+        with pytest.raises(TypeError):
+            su_cpp.count_char(memoryview(b'abcdef')[::2], 'a')
+            
+    def test_utf8_byte_offsets(self):
+        """Test offsets into str arguments are UTF-8 byte offsets."""
+        assert su_cpp.find_pattern('café café', 'caf') == [0, 6]
+
+
+@pytest.mark.skipif(not HAS_CPP_EXTENSION, reason="C++ extension specific tests")
+class TestBatchAPI:
+    """Tests for the batch variants over sequences and Arrow-style buffers."""
+    
+    RECORDS = ['ATGC', '', 'GGGCCC', 'atgcnnn', 'ATATAT']
+    
+    def arrow(self, records):
+        np = pytest.importorskip('numpy')
+        data = ''.join(records).encode()
+        offsets = np.cumsum([0] + [len(r) for r in records]).astype(np.int64)
+        return data, offsets
+    
+    def test_count_char_batch(self):
+        """Test batch counts match per-record count_char for both input forms."""
+        pytest.importorskip('numpy')
+        expected = [su.count_char(r, 'A') for r in self.RECORDS]
+        assert su_cpp.count_char_batch(self.RECORDS, 'A').tolist() == expected
+        data, offsets = self.arrow(self.RECORDS)
+        assert su_cpp.count_char_batch(data, offsets, 'A').tolist() == expected
+        
+    def test_find_pattern_batch(self):
+        """Test flattened matches split back into per-record find_pattern results."""
+        pytest.importorskip('numpy')
+        texts = ['abcabc', 'xyz', 'aabcabcc', '']
+        offsets, positions = su_cpp.find_pattern_batch(texts, 'abc')
+        split = [positions[offsets[i]:offsets[i + 1]].tolist() for i in range(len(texts))]
+        assert split == [su.find_pattern(t, 'abc') for t in texts]
+        
+        data, arrow_offsets = self.arrow(texts)
+        offsets, positions = su_cpp.find_pattern_batch(data, arrow_offsets, 'abc')
+        assert positions.tolist() == [0, 3, 1, 4]
+        assert offsets.tolist() == [0, 2, 2, 4, 4]
+        
+    def test_gc_content_batch(self):
+        """Test batch GC content matches calculate_gc_content."""
+        pytest.importorskip('numpy')
+        expected = [su.calculate_gc_content(r) for r in self.RECORDS]
+        result = su_cpp.gc_content_batch(self.RECORDS)
+        assert all(abs(a - b) < 1e-9 for a, b in zip(result.tolist(), expected))
+        data, offsets = self.arrow(self.RECORDS)
+        assert su_cpp.gc_content_batch(data, offsets).tolist() == result.tolist()
+        
+    def test_mixed_element_types(self):
+        """Test sequences may mix str, bytes and buffers."""
+        pytest.importorskip('numpy')
+        texts = ['aa', b'aaa', bytearray(b'a'), memoryview(b'aaaa')]
+        assert su_cpp.count_char_batch(texts, 'a').tolist() == [2, 3, 1, 4]
+        
+    def test_invalid_inputs(self):
+        """Test bad elements and out-of-range offsets raise."""
+        np = pytest.importorskip('numpy')
+        with pytest.raises(TypeError):
+            su_cpp.count_char_batch(['ok', 42], 'a')
+        with pytest.raises(TypeError):
+            su_cpp.count_char_batch('not a list', 'a')
+        with pytest.raises(ValueError):
+            su_cpp.count_char_batch(b'abc', np.array([0, 5]), 'a')
+        with pytest.raises(ValueError):
+            su_cpp.count_char_batch(b'abc', np.array([2, 1]), 'a')
+
+
+@pytest.mark.skipif(not HAS_CPP_EXTENSION, reason="C++ extension specific tests")
+class TestThreading:
+    """Tests for calls made concurrently with the GIL released."""
+    
+    def test_concurrent_calls_are_independent(self):
+        """Test many threads sharing compiled matchers get correct results."""
+        from concurrent.futures import ThreadPoolExecutor
+        
+        pattern = su_cpp.Pattern('needle')
+        automaton = su_cpp.AhoCorasick(['needle', 'hay'])
+        
+        def work(seed):
+            text = ('hay' * seed + 'needle') * 200
+            return (su_cpp.count_char(text, 'n'),
+                    len(su_cpp.find_pattern(text, 'needle')),
+                    pattern.count(text),
+                    automaton.count(text))
+        
+        with ThreadPoolExecutor(max_workers=8) as pool:
+            results = list(pool.map(work, range(1, 33)))
+        
+        for seed, result in zip(range(1, 33), results):
+            assert result == (200, 200, 200, 200 * (seed + 1))
+
+
+@pytest.mark.skipif(not HAS_CPP_EXTENSION, reason="C++ extension specific tests")
+class TestPattern:
+    """Tests for the precompiled Pattern matcher."""
+    
+    def test_matches_find_pattern(self, pattern_test_data):
+        """Test Pattern agrees with find_pattern on the shared fixtures."""
+        for text, pattern, expected in pattern_test_data:
+            compiled = su_cpp.Pattern(pattern)
+            assert compiled.find_all(text) == expected
+            assert compiled.count(text) == len(expected)
+            assert compiled.contains(text) == bool(expected)
+            assert compiled.find_first(text) == (expected[0] if expected else -1)
+            
+    def test_reuse_across_texts(self):
+        """Test one compiled pattern can search many texts."""
+        compiled = su_cpp.Pattern('ERROR')
+        records = ['ok', 'ERROR: disk', 'warn ERROR ERROR', '']
+        assert [compiled.count(r) for r in records] == [0, 1, 2, 0]
+        assert compiled.pattern == 'ERROR'
+        
+    def test_prefilter_skips(self):
+        """Test the rare-byte prefilter around candidates that fail verification."""
+        compiled = su_cpp.Pattern('aaQ')
+        assert compiled.find_all('aQaaQaaaQ' + 'a' * 50 + 'aaQ') == [2, 6, 59]
+        assert compiled.find_first('Q' * 10) == -1
+    
+    def test_algorithm_selection(self):
+        """Test the search algorithm chosen for each needle length."""
+        Algorithm = su_cpp.Pattern.Algorithm
+        assert su_cpp.Pattern('').algorithm == Algorithm.Empty
+        assert su_cpp.Pattern('x').algorithm == Algorithm.Memchr
+        assert su_cpp.Pattern('needle').algorithm == Algorithm.Prefilter
+        assert su_cpp.Pattern('n' * 32).algorithm == Algorithm.TwoWay
+    
+    def test_algorithms_agree_with_naive_search(self):
+        """Test every algorithm reports all overlapping matches, periodic needles included."""
+        import random
+        rng = random.Random(14)
+        for _ in range(300):
+            unit = ''.join(rng.choice('ab') for _ in range(rng.randint(1, 4)))
+            needle = (unit * 40)[:rng.randint(1, 70)]
+            if rng.random() < 0.3:
+                pos = rng.randrange(len(needle))
+                needle = needle[:pos] + rng.choice('abc') + needle[pos + 1:]
+            parts = [rng.choice(['a', 'b', needle, needle[:len(needle) // 2]]) for _ in range(40)]
+            text = ''.join(parts)
+            expected = [i for i in range(len(text) - len(needle) + 1)
+                        if text.startswith(needle, i)]
+            assert su_cpp.Pattern(needle).find_all(text) == expected
+            assert su_cpp.find_pattern(text, needle) == expected
+    
+    def test_prefilter_falls_back_on_adversarial_text(self):
+        """Test a non-selective prefilter still gives exact results via KMP."""
+        text = 'a' * 100000
+        assert su_cpp.Pattern('a' * 20).count(text) == 100000 - 19
+        assert su_cpp.Pattern('a' * 10 + 'b' + 'a' * 9).find_all(text + 'b' + 'a' * 9) == [100000 - 10]
+
+
+@pytest.mark.skipif(not HAS_CPP_EXTENSION, reason="C++ extension specific tests")
+class TestCaseInsensitiveSearch:
+    """Tests for the AsciiFold and UnicodeFold case modes."""
+    
+    def test_ascii_fold(self):
+        """Test letters match either case and other bytes stay exact."""
+        CaseMode = su_cpp.CaseMode
+        text = 'Error: x; ERROR: y; error: z'
+        assert su_cpp.find_pattern(text, 'error', case_mode=CaseMode.AsciiFold) == [0, 10, 20]
+        assert su_cpp.find_pattern(text, 'error') == [20]
+        assert su_cpp.find_pattern('@`', '`', CaseMode.AsciiFold) == [1]
+        assert su_cpp.find_pattern('É', 'é', CaseMode.AsciiFold) == []
+        
+    def test_ascii_fold_agrees_with_lowered_copy(self):
+        """Test every algorithm against searching lowered copies."""
+        import random
+        rng = random.Random(23)
+        for _ in range(300):
+            needle = ''.join(rng.choice('abAB') for _ in range(rng.randint(1, 50)))
+            text = ''.join(rng.choice(['a', 'B', '@', needle.swapcase()]) for _ in range(40))
+            expected = su_cpp.find_pattern(text.lower(), needle.lower())
+            compiled = su_cpp.Pattern(needle, su_cpp.CaseMode.AsciiFold)
+            assert compiled.find_all(text) == expected
+            assert compiled.count(text) == len(expected)
+            
+    def test_unicode_fold(self):
+        """Test simple case folding of UTF-8; offsets are byte offsets."""
+        CaseMode = su_cpp.CaseMode
+        assert su_cpp.find_pattern('ΣΑΣ σας', 'σας', CaseMode.UnicodeFold) == [0, 7]
+        assert su_cpp.find_pattern('Miſsissippi', 'SS', CaseMode.UnicodeFold) == [2, 6]
+        assert su_cpp.find_pattern('ÉTÉ été', 'été', CaseMode.UnicodeFold) == [0, 6]
+        assert su_cpp.find_pattern(b'\xffab', 'AB', CaseMode.UnicodeFold) == [1]
+        with pytest.raises(ValueError):
+            su_cpp.Pattern(b'a\xff', su_cpp.CaseMode.UnicodeFold)
+            
+    def test_unicode_fold_beyond_latin1(self):
+        """Test folds from Latin Extended-B, Greek Extended and Georgian."""
+        CaseMode = su_cpp.CaseMode
+        assert su_cpp.find_pattern('ơ Ơ', 'Ơ', CaseMode.UnicodeFold) == [0, 3]
+        assert su_cpp.find_pattern('TRƯỜNG', 'trường', CaseMode.UnicodeFold) == [0]
+        assert su_cpp.find_pattern('ἀἈ', 'Ἀ', CaseMode.UnicodeFold) == [0, 3]
+        assert su_cpp.find_pattern('Ⴀⴀ', 'ⴀ', CaseMode.UnicodeFold) == [0, 3]
+        # Every one-to-one fold in these blocks agrees with str.casefold()
+        blocks = [range(0x180, 0x250), range(0x1f00, 0x2000), range(0x10a0, 0x10c6)]
+        for codepoint in (c for block in blocks for c in block):
+            folded = chr(codepoint).casefold()
+            if len(folded) == 1 and folded != chr(codepoint):
+                assert su_cpp.find_pattern(folded, chr(codepoint), CaseMode.UnicodeFold) == [0]
+            
+    def test_pattern_properties(self):
+        """Test the stored needle, mode and algorithm of folded patterns."""
+        CaseMode = su_cpp.CaseMode
+        compiled = su_cpp.Pattern('ERROR', CaseMode.AsciiFold)
+        assert compiled.pattern == 'error'
+        assert compiled.case_mode == CaseMode.AsciiFold
+        assert su_cpp.Pattern('ERROR', CaseMode.UnicodeFold).algorithm == su_cpp.Pattern.Algorithm.Prefilter
+        assert su_cpp.Pattern('Straße', CaseMode.UnicodeFold).algorithm == su_cpp.Pattern.Algorithm.CodePoints
+
+
+@pytest.mark.skipif(not HAS_CPP_EXTENSION, reason="C++ extension specific tests")
+class TestFindApproximate:
+    """Tests for find_approximate."""
+    
+    @staticmethod
+    def reference(text, pattern, k, edits):
+        """Hamming distance per window, or Sellers' free-start edit distance DP."""
+        m = len(pattern)
+        if not edits:
+            result = []
+            for end in range(m, len(text) + 1):
+                errors = sum(a != b for a, b in zip(text[end - m:end], pattern))
+                if errors <= k:
+                    result.append((end, errors))
+            return result
+        column = list(range(m + 1))
+        result = []
+        for end in range(1, len(text) + 1):
+            diagonal = column[0]
+            for i in range(1, m + 1):
+                above = column[i]
+                column[i] = min(above + 1, column[i - 1] + 1,
+                                diagonal + (pattern[i - 1] != text[end - 1]))
+                diagonal = above
+            if column[m] <= k:
+                result.append((end, column[m]))
+        return result
+    
+    def test_substitutions(self):
+        """Test end offsets and mismatch counts."""
+        assert su_cpp.find_approximate('ACGTTGCA', 'ACGA', 1) == [(4, 1)]
+        assert su_cpp.find_approximate('ACGTTGCA', 'ACGT', 0) == [(4, 0)]
+        assert su_cpp.find_approximate('ACGT', '', 3) == []
+        
+    def test_edits(self):
+        """Test insertions and deletions are counted with ErrorModel.Edits."""
+        Edits = su_cpp.ErrorModel.Edits
+        assert su_cpp.find_approximate('xxACGxx', 'ACGA', 1, Edits) == [(5, 1), (6, 1)]
+        assert su_cpp.find_approximate('xxACGxx', 'ACGA', 1, model=Edits) == [(5, 1), (6, 1)]
+        
+    def test_random_against_reference(self):
+        """Test both models against the DP, across the 64-byte word boundary."""
+        import random
+        rng = random.Random(24)
+        for _ in range(60):
+            pattern = ''.join(rng.choice('ACGT') for _ in range(rng.choice([3, 30, 64, 65, 130])))
+            text = ''.join(rng.choice(['A', 'CG', pattern, pattern[1:], pattern[::2]]) for _ in range(12))
+            k = rng.randint(0, 4)
+            assert su_cpp.find_approximate(text, pattern, k) == self.reference(text, pattern, k, False)
+            assert (su_cpp.find_approximate(text, pattern, k, su_cpp.ErrorModel.Edits)
+                    == self.reference(text, pattern, k, True))
+
+
+@pytest.mark.skipif(not HAS_CPP_EXTENSION, reason="C++ extension specific tests")
+class TestSuffixIndex:
+    """Tests for SuffixIndex."""
+    
+    def test_locate_and_count(self):
+        """Test queries match find_pattern, overlapping matches included."""
+        index = su_cpp.SuffixIndex('abracadabra')
+        assert len(index) == 11
+        assert index.locate('abra') == [0, 7]
+        assert index.locate('a') == su_cpp.find_pattern('abracadabra', 'a')
+        assert index.count('aa') == 0
+        assert index.contains(b'cad')
+        assert index.locate('') == []
+    
+    def test_arrays(self):
+        """Test the suffix and LCP arrays are read-only views."""
+        index = su_cpp.SuffixIndex(b'banana')
+        assert list(index.suffix_array) == [5, 3, 1, 0, 4, 2]
+        assert list(index.lcp) == [0, 1, 3, 0, 0, 2]
+        with pytest.raises(ValueError):
+            index.suffix_array[0] = 1
+    
+    def test_random_against_find_pattern(self):
+        """Test random DNA queries against a full scan."""
+        import random
+        rng = random.Random(25)
+        text = ''.join(rng.choice('ACGT') for _ in range(20000))
+        index = su_cpp.SuffixIndex(text, threads=2)
+        for _ in range(200):
+            pattern = ''.join(rng.choice('ACGT') for _ in range(rng.randint(1, 8)))
+            assert index.locate(pattern) == su_cpp.find_pattern(text, pattern)
+    
+    def test_save_load(self, tmp_path):
+        """Test an index survives a round trip through a file."""
+        path = tmp_path / 'corpus.sfx'
+        su_cpp.SuffixIndex(b'mississippi').save(path)
+        loaded = su_cpp.SuffixIndex.load(str(path))
+        assert loaded.locate('ssi') == [2, 5]
+        assert list(loaded.suffix_array) == [10, 7, 4, 1, 0, 9, 8, 6, 3, 5, 2]
+        
+        bad = tmp_path / 'bad.sfx'
+        bad.write_bytes(b'not an index')
+        with pytest.raises(RuntimeError):
+            su_cpp.SuffixIndex.load(bad)
+
+
+@pytest.mark.skipif(not HAS_CPP_EXTENSION, reason="C++ extension specific tests")
+class TestStreamingMatcher:
+    """Tests for StreamingMatcher across chunk boundaries."""
+    
+    def test_match_spanning_chunks(self):
+        """Test a match split over several chunks is reported once, absolutely."""
+        matcher = su_cpp.StreamingMatcher('needle')
+        assert matcher.feed(b'hay ne') == []
+        assert matcher.feed(b'e') == []
+        assert matcher.feed(b'dle hay needle') == [4, 15]
+        assert matcher.consumed == 21
+    
+    def test_any_split_matches_whole_text(self):
+        """Test every chunking reports the same offsets as find_pattern."""
+        import random
+        rng = random.Random(13)
+        for _ in range(200):
+            text = ''.join(rng.choice('ab') for _ in range(rng.randint(0, 200)))
+            pattern = ''.join(rng.choice('ab') for _ in range(rng.randint(1, 6)))
+            matcher = su_cpp.StreamingMatcher(pattern)
+            found = []
+            pos = 0
+            while pos < len(text):
+                size = rng.randint(0, 9)
+                found += matcher.feed(text[pos:pos + size])
+                pos += size
+            assert found == su_cpp.find_pattern(text, pattern)
+    
+    def test_reset(self):
+        """Test reset drops partial matches and restarts offsets."""
+        matcher = su_cpp.StreamingMatcher('abc')
+        matcher.feed('xab')
+        matcher.reset()
+        assert matcher.consumed == 0
+        assert matcher.feed('cabc') == [1]
+    
+    def test_empty_pattern(self):
+        """Test an empty pattern never matches but still counts bytes."""
+        matcher = su_cpp.StreamingMatcher('')
+        assert matcher.feed('abc') == []
+        assert matcher.consumed == 3
+
+
+@pytest.mark.skipif(not HAS_CPP_EXTENSION, reason="C++ extension specific tests")
+class TestAhoCorasick:
+    """Tests for the multi-pattern AhoCorasick automaton."""
+    
+    MODES = ['Auto', 'Dense', 'Compact']
+    
+    def build(self, patterns, mode):
+        return su_cpp.AhoCorasick(patterns, getattr(su_cpp.AhoCorasick.Mode, mode))
+    
+    @pytest.mark.parametrize("mode", MODES)
+    def test_classic_example(self, mode):
+        """Test the textbook he/she/hers example, including suffix patterns."""
+        ac = self.build(['he', 'she', 'hers'], mode)
+        assert ac.find_all('ushers') == [(1, 1), (0, 2), (2, 2)]
+        assert ac.count('ushers') == 3
+        assert ac.contains('ushers')
+        assert not ac.contains('xyz')
+        
+    @pytest.mark.parametrize("mode", MODES)
+    def test_matches_find_pattern_per_pattern(self, mode):
+        """Test every pattern's offsets agree with find_pattern."""
+        patterns = ['aa', 'a', 'aba', 'b', 'abab', 'x']
+        text = 'aababaaabbabab'
+        ac = self.build(patterns, mode)
+        matches = ac.find_all(text)
+        for pattern_id, pattern in enumerate(patterns):
+            offsets = [offset for pid, offset in matches if pid == pattern_id]
+            assert offsets == su.find_pattern(text, pattern)
+        
+    @pytest.mark.parametrize("mode", MODES)
+    def test_empty_inputs(self, mode):
+        """Test empty patterns never match, and empty text has no matches."""
+        ac = self.build(['', 'a', ''], mode)
+        assert ac.find_all('aa') == [(1, 0), (1, 1)]
+        assert ac.find_all('') == []
+        assert len(ac) == 3
+        assert self.build([], mode).find_all('abc') == []
+        
+    @pytest.mark.parametrize("mode", MODES)
+    def test_duplicate_patterns(self, mode):
+        """Test duplicate patterns are each reported under their own id."""
+        ac = self.build(['ab', 'ab'], mode)
+        assert ac.find_all('abab') == [(0, 0), (1, 0), (0, 2), (1, 2)]
+        
+    def test_auto_mode_resolution(self):
+        """Test Auto resolves to a concrete representation."""
+        ac = su_cpp.AhoCorasick(['ATG', 'TAA', 'TAG', 'TGA'])
+        assert ac.mode in (su_cpp.AhoCorasick.Mode.Dense, su_cpp.AhoCorasick.Mode.Compact)
+
+
 class TestValidateDNA:
     """Comprehensive tests for validate_dna function."""
     
@@ -532,6 +1369,145 @@ class TestCalculateGCContent:
         assert abs(result - expected) < 0.001
 
 
+@pytest.mark.skipif(not HAS_CPP_EXTENSION, reason="C++ extension specific tests")
+class TestDnaStats:
+    """Tests for the fused dna_stats pass and the vectorized DNA kernels."""
+    
+    def test_counts_and_validity(self):
+        """Test per-base counts, case folding and the first invalid offset."""
+        stats = su_cpp.dna_stats('AACGTtgcaN')
+        assert (stats.a, stats.c, stats.g, stats.t, stats.n) == (3, 2, 2, 2, 1)
+        assert stats.length == 10
+        assert stats.valid == False
+        assert stats.first_invalid == 9
+        
+        stats = su_cpp.dna_stats('ACGT')
+        assert stats.valid == True
+        assert stats.first_invalid == -1
+        assert abs(stats.gc_content - 50.0) < 0.001
+        
+    def test_empty_sequence(self):
+        """Test the empty sequence is valid with no counts."""
+        stats = su_cpp.dna_stats('')
+        assert stats.valid == True
+        assert stats.length == 0
+        assert stats.gc_content == 0.0
+    
+    def test_matches_single_functions(self):
+        """Test agreement with validate_dna/calculate_gc_content across vector widths."""
+        import random
+        rng = random.Random(11)
+        for length in [0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 1000, 9000]:
+            for alphabet in ['ACGT', 'ACGTacgt', 'ACGTNX', 'ACGT\x00\xc3']:
+                seq = ''.join(rng.choice(alphabet) for _ in range(length))
+                stats = su_cpp.dna_stats(seq)
+                data = seq.encode('utf-8')
+                assert stats.valid == su_cpp.validate_dna(seq)
+                assert abs(stats.gc_content - su_cpp.calculate_gc_content(seq)) < 1e-9
+                upper = data.upper()
+                assert stats.a == upper.count(b'A')
+                assert stats.g + stats.c == upper.count(b'G') + upper.count(b'C')
+                if not stats.valid:
+                    invalid = [i for i, b in enumerate(upper) if b not in b'ACGT']
+                    assert stats.first_invalid == invalid[0]
+    
+    def test_invalid_byte_late_in_long_sequence(self):
+        """Test the first invalid offset is exact past many vector blocks."""
+        seq = 'ACGT' * 5000 + 'x' + 'ACGT' * 10
+        stats = su_cpp.dna_stats(seq)
+        assert not su_cpp.validate_dna(seq)
+        assert stats.first_invalid == 20000
+    
+    def test_bytes_with_high_bit_are_invalid(self):
+        """Test bytes >= 0x80 never alias a nucleotide in the nibble lookup."""
+        for value in range(0x80, 0x100):
+            data = b'ACGT' * 8 + bytes([value]) + b'ACGT' * 8
+            assert su_cpp.validate_dna(data) == False
+            assert su_cpp.dna_stats(data).first_invalid == 32
+
+
+@pytest.mark.skipif(not HAS_CPP_EXTENSION, reason="C++ extension specific tests")
+class TestSequenceReader:
+    """Tests for the streaming FASTA/FASTQ reader."""
+    
+    def test_fasta_multiline_records(self, tmp_path):
+        """Test wrapped FASTA sequences are joined and per-record stats computed."""
+        path = tmp_path / 'seqs.fa'
+        path.write_text('>seq1 first\nACGT\nGG\n\n>seq2\nNNAT\r\nAT\r\n>empty\n')
+        records = list(su_cpp.SequenceReader(path))
+        assert [r.name for r in records] == ['seq1 first', 'seq2', 'empty']
+        assert [r.sequence for r in records] == ['ACGTGG', 'NNATAT', '']
+        assert all(r.quality == '' for r in records)
+        assert records[0].stats.valid and abs(records[0].stats.gc_content - 4 / 6 * 100) < 1e-9
+        assert records[1].stats.first_invalid == 0 and records[1].stats.n == 2
+    
+    def test_fastq_records_and_totals(self, tmp_path):
+        """Test four-line FASTQ parsing and the running file totals."""
+        path = tmp_path / 'reads.fq'
+        path.write_text('@r1\nACGT\n+\nIIII\n@r2\nGGCC\n+r2\n#%%&\n')
+        reader = su_cpp.SequenceReader(str(path))
+        records = list(reader)
+        assert reader.format == su_cpp.SequenceReader.Format.Fastq
+        assert [(r.name, r.sequence, r.quality) for r in records] == [
+            ('r1', 'ACGT', 'IIII'), ('r2', 'GGCC', '#%%&')]
+        assert reader.records == 2
+        totals = reader.totals
+        assert totals.valid and totals.length == 8
+        assert abs(totals.gc_content - su_cpp.calculate_gc_content('ACGTGGCC')) < 1e-9
+    
+    def test_records_larger_than_buffer(self, tmp_path):
+        """Test records spanning many buffer refills, and scan() totals."""
+        sequences = ['ACGT' * 5000, 'G' * 12345 + 'x', 'AT' * 3000]
+        path = tmp_path / 'big.fa'
+        with open(path, 'w') as f:
+            for i, seq in enumerate(sequences):
+                f.write('>%d\n' % i)
+                for start in range(0, len(seq), 70):
+                    f.write(seq[start:start + 70] + '\n')
+        records = list(su_cpp.SequenceReader(path, buffer_size=4096))
+        assert [r.sequence for r in records] == sequences
+        
+        totals = su_cpp.SequenceReader(path, buffer_size=4096).scan()
+        assert not totals.valid
+        assert totals.first_invalid == 20000 + 12345
+        assert totals.length == sum(len(s) for s in sequences)
+    
+    def test_gzip_input(self, tmp_path):
+        """Test gzip input is detected by magic bytes (when built with zlib)."""
+        import gzip
+        path = tmp_path / 'seqs.fa.gz'
+        with gzip.open(path, 'wt') as f:
+            f.write('>a\nACGT\n>b\nGGGG\n')
+        try:
+            records = list(su_cpp.SequenceReader(path))
+        except RuntimeError as error:
+            if 'zlib' in str(error):
+                pytest.skip('built without zlib')
+            raise
+        assert [r.sequence for r in records] == ['ACGT', 'GGGG']
+    
+    def test_non_utf8_header(self, tmp_path):
+        """Test non-UTF-8 header bytes round-trip instead of raising."""
+        path = tmp_path / 'latin1.fa'
+        path.write_bytes(b'>sample_K\xf6ln\nACGT\n')
+        records = list(su_cpp.SequenceReader(path))
+        assert records[0].name == 'sample_K\udcf6ln'
+        assert records[0].name.encode('utf-8', 'surrogateescape') == b'sample_K\xf6ln'
+        assert records[0].sequence == 'ACGT'
+    
+    def test_malformed_input(self, tmp_path):
+        """Test errors for unknown formats, bad FASTQ and missing files."""
+        bad = tmp_path / 'bad.txt'
+        bad.write_text('ACGT\n')
+        with pytest.raises(RuntimeError):
+            list(su_cpp.SequenceReader(bad))
+        bad.write_text('@r1\nACGT\n+\nII\n')
+        with pytest.raises(RuntimeError):
+            list(su_cpp.SequenceReader(bad))
+        with pytest.raises(RuntimeError):
+            su_cpp.SequenceReader(tmp_path / 'missing.fa')
+
+
 class TestErrorHandling:
     """Tests for error handling and edge cases."""
     
@@ -776,12 +1752,21 @@ class TestCppExtensionSpecific:
         # Should have all expected functions
         expected_functions = [
             'reverse_string', 'count_char', 'find_pattern',
-            'validate_dna', 'calculate_gc_content'
+            'validate_dna', 'calculate_gc_content',
+            'count_char_batch', 'find_pattern_batch', 'gc_content_batch',
+            'dna_stats', 'byte_histogram', 'remove_duplicates', 'remove_duplicates_utf8',
+            'reverse_inplace', 'reverse_utf8', 'reverse_graphemes'
         ]
         for func_name in expected_functions:
             assert hasattr(su_cpp, func_name)
             assert callable(getattr(su_cpp, func_name))
     
+    def test_simd_level(self):
+        """Test the SIMD dispatch level reported by the C++ extension."""
+        import pystringpp as su_cpp
+        
+        assert su_cpp.simd_level() in ('scalar', 'sse2', 'ssse3', 'avx2', 'avx512bw')
+    
     def test_cpp_vs_python_consistency(self):
         """Test that C++ and Python implementations give consistent results."""
         test_cases = [